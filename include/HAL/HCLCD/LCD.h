@@ -15,6 +15,12 @@
 #define HLCD_MODE_4_BIT     1
 #define HLCD_MODE_8_BIT     2
 
+/************************************************************************************************************************************************/
+/* Timing of the transfers                                                                                                                      */
+/************************************************************************************************************************************************/
+#define HLCD_TIMING_FIXED_TICKS     0
+#define HLCD_TIMING_BUSY_FLAG       1
+
 
 /************************************************************************************************************************************************/
 /* LCD Options states                                                                                                                           */
@@ -55,6 +61,18 @@
 #define HLCD_SHIFT_SCREEN_LEFT          0x18
 #define HLCD_SHIFT_SCREEN_RIGHT         0x1C
 
+/******************************************************************************/
+/* Shadow frame size (lines x columns) */
+/*****************************************************************************/
+#define HLCD_FRAME_LINES                2
+#define HLCD_FRAME_COLUMNS              16
+
+/*****************************************************************************/
+/****************************Formatted number padding*************************/
+/*****************************************************************************/
+#define HLCD_PAD_SPACE                  0
+#define HLCD_PAD_ZERO                   1
+
 
 #define HCLCD_SMILY_FACE     {0b00000,0b01010,0b01010,0b00000,0b10001,0b01110,0b00000,0b00000}
 #define HCLCD_HEART          {0b00000,0b00000,0b01010,0b10101,0b10001,0b01110,0b00100,0b00000}
@@ -70,6 +88,16 @@
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
+typedef struct  // Throughput counters of one display, counted when HLCD_STATS is HLCD_ENABLE
+{
+    u32 Ticks; // CLCD_TASK calls since the last reset
+    u32 ActiveTicks; // Calls where the display had something to send
+    u32 GPIOWrites; // Stores to the GPIO registers (data bus, RS, RW and E)
+    u32 DataBytes; // Characters and CGRAM bytes sent
+    u32 CommandBytes; // Commands sent, including the DDRAM address moves of the frame
+    u32 FrameCells; // Characters pushed by the shadow frame flush
+    u32 BusyPolls; // Busy flag reads that found the controller busy (HLCD_TIMING_BUSY_FLAG)
+}CLCD_Stats_tstr;
 
 
 /********************************************************************************************************/
@@ -78,8 +106,8 @@
 /**
  * @brief This function initializes the asynchronous initialization of the LCD.
  *
- * This function initializes the GPIO pins used for the LCD. It sets their modes and speeds
- * according to the configurations provided. It sets the CLCD state to initialization state.
+ * This function initializes the GPIO pins of every display configured in HLCD. It sets their modes and speeds
+ * according to the configurations provided. It sets the CLCD state of each display to initialization state.
  *
  * @return None
  */
@@ -90,88 +118,204 @@ void CLCD_InitAsynch(void);
  * This function clears the entire content displayed on the LCD screen.
  * It buffers the clear screen request for asynchronous processing.
  *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ *
  * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
  */
-tenu_ErrorStatus CLCD_ClearScreenAsynch(void);
+tenu_ErrorStatus CLCD_ClearScreenAsynch(u8 Copy_Display);
 /**
  * @brief Sets the cursor position on the LCD.
  *
  * This function sets the cursor position on the LCD display to the specified row and column.
  * It buffers the set position request for asynchronous processing.
  *
+ * @param Copy_Display: The display, one of LCD_Displays_tenu.
  * @param Copy_X: Row number (1 or 2).
  * @param Copy_Y: Column number (0 to 15).
  *
- * @return tenu_ErrorStatus: Status of the set position operation (LBTY_OK if successful, LBTY_ErrorInvalidInput if the input parameters are invalid, LBTY_NOK if unable to buffer the request).
+ * @return tenu_ErrorStatus: Status of the set position operation (LBTY_OK if successful, LBTY_ErrorInvalidInput if the input parameters are invalid, LBTY_Busy if the request queue is full).
  */
-tenu_ErrorStatus CLCD_GoToXYAsynch(u8 Copy_x , u8 Copy_y); 
+tenu_ErrorStatus CLCD_GoToXYAsynch(u8 Copy_Display , u8 Copy_x , u8 Copy_y); 
 /**
  * @brief Writes a string to the LCD.
  *
  * This function writes a string of characters to the LCD display. It takes the string and its length as input
  * parameters and buffers the write request for asynchronous processing.
  *
+ * @param Copy_Display: The display, one of LCD_Displays_tenu.
  * @param Add_pStr: Pointer to the string to be written.
  * @param Copy_len: Length of the string to be written.
  *
- * @return tenu_ErrorStatus: Status of the write operation (LBTY_OK if successful, LBTY_ErrorNullPointer if the string pointer is NULL, LBTY_NOK if unable to buffer the request).
+ * @return tenu_ErrorStatus: Status of the write operation (LBTY_OK if successful, LBTY_ErrorNullPointer if the string pointer is NULL, LBTY_Busy if the request queue is full).
+ *
+ * @note If the previous queued request is a write that hasn't started yet, the string is appended to it
+ *       (up to LCD_BURST_SIZE characters) and sent as one burst. Merged strings are copied, the others are
+ *       read from Add_pStr when they are sent.
  */
-tenu_ErrorStatus CLCD_WriteStringAsynch(char * Add_pStr , u8 Copy_len);
+tenu_ErrorStatus CLCD_WriteStringAsynch(u8 Copy_Display , char * Add_pStr , u8 Copy_len);
 /**
  * @brief Writes a command to the LCD.
  *
  * This function writes a command to the LCD. It buffers the command write request for asynchronous processing.
  *
+ * @param Copy_Display: The display, one of LCD_Displays_tenu.
  * @param Copy_Command: The command to be written to the LCD.
  *
  * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
  */
-tenu_ErrorStatus CLCD_WriteCommandAsynch(u8 Copy_Command);
+tenu_ErrorStatus CLCD_WriteCommandAsynch(u8 Copy_Display , u8 Copy_Command);
 /**
  * @brief Writes a number to the LCD asynchronously.
  * 
- * This function converts the given number to a string and stores it in the LCD buffer
- * for asynchronous writing to the LCD. It checks the buffer state to find an available
- * buffer slot and stores the number along with the necessary request information.
+ * This function queues a request to write the given number at the current position of the LCD.
+ * Requests are served in FIFO order by CLCD_TASK.
  * 
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
  * @param Copy_Number The number to be written to the LCD.
  * @return tenu_ErrorStatus Returns the error status of the operation.
  *         - LBTY_OK: Operation successful.
- *         - LBTY_NOK: Operation failed due to buffer full.
- * 
- * @details
- * The function first initializes a local variable `Local_ErrorStatus` to `LBTY_OK` indicating
- * no error. It then converts the given number to a string and stores
- * it in the local character array `array`. The function then iterates through the LCD buffers
- * to find an available slot (`NotBuffered`). When an available slot is found, it copies the
- * number to the buffer, sets the buffer state to `Buffered`, and sets the request type to
- * `WriteNumReq`. Finally, it sets the request state to `CLCD_ReqStart` and exits the loop.
- * 
- * If all buffer slots are already in use (`idx_Buffer == LCD_BUFFERSIZE`), the function sets
- * the error status to `LBTY_NOK` indicating a buffer full condition.
+ *         - LBTY_Busy: The request queue is full, the caller has to retry later.
  */
-tenu_ErrorStatus CLCD_WriteNumberAsynch(s32 Copy_Number);
+tenu_ErrorStatus CLCD_WriteNumberAsynch(u8 Copy_Display , s32 Copy_Number);
+/**
+ * @brief Writes a fixed-point number asynchronously to the LCD.
+ *
+ * The number is rendered into text at call time without any division and queued as a single
+ * write request, so it is appended to a pending string write when possible.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @param Copy_Number The number to write, e.g. 1234 with 2 decimals is shown as 12.34.
+ * @param Copy_Width Minimum number of characters (0 to LCD_BURST_SIZE), 0 for no padding.
+ * @param Copy_Decimals Digits after the decimal point (0 to 9), 0 for an integer.
+ * @param Copy_Pad HLCD_PAD_SPACE or HLCD_PAD_ZERO, zeros are placed after the sign.
+ * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
+ *         - LBTY_OK: The request was queued successfully.
+ *         - LBTY_ErrorInvalidInput: Invalid width, decimals or padding.
+ *         - LBTY_Busy: The request queue is full, the caller has to retry later.
+ */
+tenu_ErrorStatus CLCD_WriteFormattedAsynch(u8 Copy_Display , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad);
 /**
  * @brief Writes a special character asynchronously to the LCD.
  * 
  * This function sets up a request to write a special character asynchronously
  * to the LCD.
  * 
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
  * @param Add_Pattern Pointer to the special character pattern.
  * @param Copy_CGRAMBlockNumber The CGRAM block number to write the special character to.
  * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
  */
 
-tenu_ErrorStatus CLCD_WriteSpecialCharAsynch(char * Add_Pattern, u8 Copy_CGRAMBlockNumber);
+tenu_ErrorStatus CLCD_WriteSpecialCharAsynch(u8 Copy_Display , char * Add_Pattern, u8 Copy_CGRAMBlockNumber);
 /**
  * @brief Displays a special character asynchronously on the LCD.
  * 
  * This function sets up a request to display a special character asynchronously
  * on the LCD.
  * 
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
  * @param Copy_CGRAMBlockNumber The CGRAM block number of the special character to be displayed.
  * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
  */
-tenu_ErrorStatus CLCD_DisplaySpecialCharAsynch( u8 Copy_CGRAMBlockNumber);
+tenu_ErrorStatus CLCD_DisplaySpecialCharAsynch(u8 Copy_Display , u8 Copy_CGRAMBlockNumber);
+/**
+ * @brief Gets the character code of a custom glyph, uploading it to CGRAM only if it isn't resident.
+ *
+ * The cache keeps the glyphs of the CGRAM blocks from HLCD_GLYPH_FIRST_BLOCK to 7, keyed by a hash of
+ * the 8 pattern bytes. A resident glyph costs no LCD transfer, otherwise the least recently used block
+ * is rewritten through the request queue, so any number of glyphs can be used over time.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @param Add_Pattern Pointer to the 8 pattern bytes, copied by the cache (the caller's buffer can go away).
+ * @param Add_pCode Returns the character code (CGRAM block) to write or display for this glyph.
+ * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
+ *         - LBTY_OK: The glyph is resident or its upload was queued.
+ *         - LBTY_ErrorNullPointer: Null pattern or code pointer.
+ *         - LBTY_Busy: The upload couldn't be queued, the cache is unchanged.
+ *
+ * @note Characters already on the screen showing an evicted block change to the new glyph, keep the
+ *       number of glyphs shown at the same time within the managed blocks.
+ */
+tenu_ErrorStatus CLCD_GetGlyphAsynch(u8 Copy_Display , const char * Add_Pattern , u8 * Add_pCode);
+/**
+ * @brief Displays a custom glyph at the cursor, uploading it first if it isn't resident.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @param Add_Pattern Pointer to the 8 pattern bytes.
+ * @return tenu_ErrorStatus LBTY_OK, LBTY_ErrorNullPointer or LBTY_Busy when the queue can't take both requests.
+ */
+tenu_ErrorStatus CLCD_DisplayGlyphAsynch(u8 Copy_Display , const char * Add_Pattern);
+/**
+ * @brief Gets the number of free slots in the request queue.
+ *
+ * Lets a producer check that a group of requests fits before queuing it, instead of having part of it refused.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ *
+ * @return u8 Number of requests that can still be queued.
+ */
+u8 CLCD_GetFreeSlots(u8 Copy_Display);
+/**
+ * @brief Writes a string into the shadow frame of the LCD.
+ *
+ * Only the characters that differ from the frame are marked dirty. CLCD_TASK pushes the dirty cells
+ * whenever the request queue is idle, moving the DDRAM address only when the next dirty cell isn't
+ * the one the address counter already points to, so a screen where one digit changed costs one
+ * character (plus at most one address command) instead of a full redraw.
+ *
+ * @param Copy_Display: The display, one of LCD_Displays_tenu.
+ * @param Copy_X: Line number (0 or 1).
+ * @param Copy_Y: Column number (0 to 15).
+ * @param Add_pStr: Pointer to the characters to write.
+ * @param Copy_len: Number of characters, the string is cut at the end of the line.
+ *
+ * @return tenu_ErrorStatus: LBTY_OK, LBTY_ErrorNullPointer or LBTY_ErrorInvalidInput for a position outside the frame.
+ *
+ * @note The frame doesn't see the characters written through the request queue. CLCD_ClearScreenAsynch
+ *       blanks both, so call it once before taking over a screen drawn with the queued APIs.
+ */
+tenu_ErrorStatus CLCD_FrameWriteString(u8 Copy_Display , u8 Copy_X , u8 Copy_Y , const char * Add_pStr , u8 Copy_len);
+/**
+ * @brief Fills the shadow frame with spaces, only the non blank cells are pushed to the LCD.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ *
+ * @return None
+ */
+void CLCD_FrameClear(u8 Copy_Display);
+/**
+ * @brief Writes a fixed-point number into the shadow frame at the given position.
+ *
+ * Same rendering as CLCD_WriteFormattedAsynch, only the characters that changed are sent to the LCD.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @param Copy_X Line number (0 or 1).
+ * @param Copy_Y Column number (0 to 15).
+ * @param Copy_Number The number to write.
+ * @param Copy_Width Minimum number of characters (0 to HLCD_FRAME_COLUMNS).
+ * @param Copy_Decimals Digits after the decimal point (0 to 9).
+ * @param Copy_Pad HLCD_PAD_SPACE or HLCD_PAD_ZERO.
+ * @return tenu_ErrorStatus Error status indicating the success or failure of the operation.
+ */
+tenu_ErrorStatus CLCD_FrameWriteFormatted(u8 Copy_Display , u8 Copy_X , u8 Copy_Y , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad);
+/**
+ * @brief Reads the throughput counters of a display.
+ *
+ * GPIOWrites/DataBytes gives the bus cost of a character, ActiveTicks over the frames drawn gives the
+ * ticks per frame of a screen.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @param Add_pStats Returns a copy of the counters.
+ * @return tenu_ErrorStatus LBTY_OK, LBTY_ErrorNullPointer, LBTY_ErrorInvalidInput for an unknown display,
+ *         or LBTY_NOK when HLCD_STATS is HLCD_DISABLE.
+ */
+tenu_ErrorStatus CLCD_GetStats(u8 Copy_Display , CLCD_Stats_tstr * Add_pStats);
+/**
+ * @brief Clears the throughput counters of a display.
+ *
+ * @param Copy_Display The display, one of LCD_Displays_tenu.
+ * @return None
+ */
+void CLCD_ResetStats(u8 Copy_Display);
 
 #endif// HCLCD_LCD_H_
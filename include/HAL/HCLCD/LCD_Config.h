@@ -16,6 +16,28 @@
 /************************************************************************************************************************************************/
 #define HLCD_MODE       HLCD_MODE_8_BIT
 
+/************************************************************************************************************************************************/
+/* Set how CLCD_TASK paces the transfers                                                                                                        */
+/* Options:                                                                                                                                     */
+/*      1-  HLCD_TIMING_FIXED_TICKS ------->  one Enable phase per CLCD_TASK call                                                               */
+/*      2-  HLCD_TIMING_BUSY_FLAG   ------->  after init, read the busy flag through R_W_pin and send the next byte as soon as the             */
+/*                                            controller is ready, up to HLCD_BF_STEPS_PER_TICK Enable phases per CLCD_TASK call               */
+/************************************************************************************************************************************************/
+#define HLCD_TIMING     HLCD_TIMING_FIXED_TICKS
+
+/* Max Enable phases (two per byte, four per byte in 4-bit mode) done in one CLCD_TASK call in busy flag mode                                   */
+#define HLCD_BF_STEPS_PER_TICK      32
+
+/* Enable high time in ns, covers the Enable pulse width (450 ns) and the data delay time (360 ns), used in busy flag mode and between the   */
+/* two nibbles of a byte in 4-bit mode. The busy loop length is derived from HCLK and follows every clock change                              */
+#define HLCD_E_PULSE_NS             500
+
+/* Enable cycle time in ns (1000 ns min), E stays low for HLCD_E_CYCLE_NS-HLCD_E_PULSE_NS before it is raised again in the same CLCD_TASK call */
+#define HLCD_E_CYCLE_NS             1000
+
+/* Core cycles of one busy loop iteration, keep it at or below the real cost so the delay never gets shorter than asked                       */
+#define HLCD_DELAY_LOOP_CYCLES      4
+
 
 /************************************************************************************************************************************************/
 /*                                              Initialization Options for the LCD                                                              */
@@ -72,8 +94,31 @@
 #define HLCD_BLINKING               HLCD_ENABLE
 
 
+/* Number of requests the LCD queue holds, the Asynch APIs return LBTY_Busy when it is full               */
 #define LCD_BUFFERSIZE               30
 
+/* Max length of a burst of coalesced write requests (consecutive CLCD_WriteStringAsynch calls)            */
+#define LCD_BURST_SIZE               16
+
+/* Throughput counters of each display read with CLCD_GetStats (CLCD_TASK ticks, GPIO writes, bytes sent)  */
+/* Options: HLCD_DISABLE, HLCD_ENABLE                                                                      */
+#define HLCD_STATS                   HLCD_DISABLE
+
+/* First CGRAM block managed by the glyph cache (CLCD_GetGlyphAsynch), blocks 0 to HLCD_GLYPH_FIRST_BLOCK-1  */
+/* are left to CLCD_WriteSpecialCharAsynch. Range 0 to 7, 0 gives all the 8 blocks to the cache            */
+#define HLCD_GLYPH_FIRST_BLOCK       0
+
+
+/* Displays driven by CLCD_TASK, one LCD_cfg_t per display in HLCD (LCD_Config.c).                      */
+/* Every display needs its own data and E pins, the Enable phases of all the displays overlap             */
+typedef enum
+{
+    LCD_MAIN=0,
+
+
+    _LCD_NUM
+}LCD_Displays_tenu;
+
 
 typedef struct {
       void * Port;
@@ -9,6 +9,9 @@
 #define HAL_KYD_KYD_H_
 #include"KYD_Config.h"
 
+#define KPD_MODE_POLLING                0
+#define KPD_MODE_EXTI                   1
+
 /* @brief	 : Initializes the KPD module based on the provided configuration.
  * @param[in]: void.
  * @return	 : tenu_ErrorStatus indicating the success or failure of the initialization.
@@ -25,6 +28,30 @@ tenu_ErrorStatus KPD_INIT(void);
  * @note	 : The function returns an error if a NULL pointer is provided as input.
  */
 tenu_ErrorStatus KPD_GetPressedKey(u8 *Copy_pu8Key);
+/****************************************************************************************/
+/* @brief	 : get all the keys held down.
+ * @param[in]: pointer to the bitmap of the debounced keys.
+ * @return	 : tenu_ErrorStatus indicating the success or failure of the function.
+ * @details	 : bit (Col*KPD_NUMBER_OF_ROWS)+Row is set while that key is pressed, every key of the
+ *  matrix is scanned and debounced on its own (4 scans at the new level), so several keys can be held together.
+ * @note	 : The function returns an error if a NULL pointer is provided as input.
+ */
+tenu_ErrorStatus KPD_GetPressedKeys(u16 *Copy_pu16Keys);
+/****************************************************************************************/
+/* @brief	 : get the keys that were pressed and released since the last call.
+ * @param[in]: pointers to the bitmaps of the pressed and of the released keys, same bits as KPD_GetPressedKeys.
+ * @return	 : tenu_ErrorStatus indicating the success or failure of the function.
+ * @details	 : every debounced transition is latched until it is read, reading clears it.
+ * @note	 : The function returns an error if a NULL pointer is provided as input.
+ */
+tenu_ErrorStatus KPD_GetTransitions(u16 *Copy_pu16Pressed, u16 *Copy_pu16Released);
+/****************************************************************************************/
+/* @brief	 : get the name of a key of the bitmaps from KPD_ARRAY.
+ * @param[in]: bit of the key, pointer to its name.
+ * @return	 : tenu_ErrorStatus indicating the success or failure of the function.
+ * @note	 : The function returns an error if a NULL pointer or a bit outside the matrix is provided as input.
+ */
+tenu_ErrorStatus KPD_GetKeyName(u8 Copy_u8KeyBit, u8 *Copy_pu8Key);
 
 
 #endif /* HAL_KYD_KYD_H_ */
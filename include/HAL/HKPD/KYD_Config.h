@@ -22,6 +22,22 @@
 //#define KPD_ARRAY                       {{'M','S','C','E'},{'X','U','K','+'},{'L','D','R','-'},{'X','X','X','X'}}
 /*The sign that indicates there are no buttons pressed*/
 #define KPD_NO_PRESSED_SWITCH           0xff
+/*Time in ns between driving a column low and reading the rows, a row released by the previous column has to
+ * rise back through its pull-up (about 3 RC, e.g. 40 kOhm and 15 pF). The busy loop follows every HCLK change*/
+#define KPD_SETTLE_NS                   2000
+/*Core cycles of one busy loop iteration, keep it at or below the real cost so the delay never gets shorter*/
+#define KPD_DELAY_LOOP_CYCLES           4
+/*How the matrix is scanned
+ * Options:
+ *      1- KPD_MODE_POLLING ------->  KPD_Runnable scans the whole matrix each period
+ *      2- KPD_MODE_EXTI    ------->  all columns are held low while idle and a falling edge on a row
+ *                                    wakes the scan, which stops again once every key is released
+ * note: EXTI line n serves pin n of one port only. KPD_MODE_EXTI needs row pin numbers that no other module
+ *       routes to EXTI (HSWITCH in SWITCH_MODE_EXTI uses lines 1..4 for PA1..PA4), else KPD_INIT returns
+ *       LBTY_Busy. KPD_MODE_POLLING takes no EXTI line.*/
+#define KPD_INPUT_MODE                  KPD_MODE_POLLING
+/* note: every key is reported on its own, but without a diode per key three keys at the corners of a
+ *       rectangle also close the fourth one (ghosting), KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS must not exceed 16 */
 
 
 typedef struct
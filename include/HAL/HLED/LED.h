@@ -19,6 +19,10 @@
 #define LED_ON                  1
 #define LED_OFF                 0
 
+/* Bit of an LED of LEDS_tenu in a frame */
+#define LED_BIT(LED)            (1UL<<(LED))
+#define LED_ALL_MASK            ((u32)((1ULL<<_LED_NUM)-1))
+
 typedef struct {
       void * Port;
       u32 Pin;
@@ -26,6 +30,28 @@ typedef struct {
       u8 DefaultState;
 }LEDSCfg_tstr;
 
+/* Returned by HLED_SeqUpdate when no pattern is playing */
+#define LED_SEQ_IDLE            0xFFFFFFFFUL
+
+/* Called by HLED_SeqPlay, e.g. to wake the task that calls HLED_SeqUpdate */
+typedef void (*LED_SeqWakeCBF_t)(void);
+
+/* A step of a pattern, the frame of the pattern LEDs and how long it is shown (not 0) */
+typedef struct {
+      u32 Frame;
+      u32 DurationMs;
+}LEDSeqStep_tstr;
+
+/* A pattern of the sequencer, kept in flash.
+ * Its steps are played Loops times (0 forever), then the Next pattern is played, NULL stops the track. */
+typedef struct LEDPattern_tstr {
+      u32 Mask;                                  // LEDs driven by the pattern, with LED_BIT
+      const LEDSeqStep_tstr * Steps;
+      u8 StepsNum;
+      u8 Loops;
+      const struct LEDPattern_tstr * Next;
+}LEDPattern_tstr;
+
 /**
  * @brief	 :Initializes the LED based on the provided configuration.
  * @param[in]:void.
@@ -35,6 +61,71 @@ tenu_ErrorStatus HLED_Init(void);
 tenu_ErrorStatus HLED_SetStatus(u32 Copy_Led, u8 Copy_status);
 tenu_ErrorStatus HLED_GetStatus(u32 Copy_Led, u8 *ADD_status);
 tenu_ErrorStatus HLED_Toggle(u32 Copy_Led);
+/**
+ * @brief	 :Sets all the LEDs at once.
+ * @param[in]:Copy_Frame bit LED_BIT(n) is the state of the LED n, 1 for LED_ON.
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ * @details	 :The levels of the pins, with the polarity of each LED, are written with one BSRR store per port,
+ *            so the LEDs of a port never show a mix of the old and the new frame.
+ */
+tenu_ErrorStatus HLED_SetFrame(u32 Copy_Frame);
+/**
+ * @brief	 :Sets the LEDs of Copy_Mask at once, the others are left as they are.
+ * @param[in]:Copy_Mask LEDs to update, Copy_Frame their states, both with LED_BIT(n) for the LED n.
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ */
+tenu_ErrorStatus HLED_SetFrameMasked(u32 Copy_Mask, u32 Copy_Frame);
+/**
+ * @brief	 :Sets the brightness of an LED and drives it from the software PWM.
+ * @param[in]:Copy_Led LED of LEDS_tenu, Copy_Duty on time in steps, 0 (off) to LED_PWM_STEPS (fully on).
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ * @details	 :The LEDs are grouped by duty in a table of edges sorted by step, the LEDs of an edge are
+ *            turned off together with one BSRR store per port. The new table is taken at the start of
+ *            the next period, so a breathing effect can call it from a runnable at any rate.
+ */
+tenu_ErrorStatus HLED_SetBrightness(u32 Copy_Led, u16 Copy_Duty);
+/**
+ * @brief	 :Stops driving an LED from the software PWM, its pin keeps the level it had.
+ * @param[in]:Copy_Led LED of LEDS_tenu.
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ */
+tenu_ErrorStatus HLED_StopBrightness(u32 Copy_Led);
+/**
+ * @brief	 :Applies the current PWM edge and returns the number of steps until the next one.
+ * @return	 :u16 steps to wait before the next call.
+ * @details	 :To be called from a one-shot timer interrupt reloaded with the returned delay, a period then
+ *            costs one interrupt per distinct duty plus one at its start.
+ */
+u16 HLED_PwmEdge(void);
+/**
+ * @brief	 :Advances the software PWM by one step.
+ * @details	 :To be called from a periodic timer interrupt at LED_PWM_STEPS times the PWM frequency,
+ *            it only calls HLED_PwmEdge on the steps that have an edge.
+ */
+void HLED_PwmTick(void);
+/**
+ * @brief	 :Starts a pattern on a track of the sequencer, replacing the one it played.
+ * @param[in]:Copy_Track track from 0 to LED_SEQ_TRACKS-1, ADD_Pattern pattern to play, NULL stops the track.
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ * @details	 :The first step is shown by the next HLED_SeqUpdate, the wake callback is called to run it early.
+ */
+tenu_ErrorStatus HLED_SeqPlay(u8 Copy_Track, const LEDPattern_tstr * ADD_Pattern);
+/**
+ * @brief	 :Sets the function HLED_SeqPlay calls once a track changed.
+ * @param[in]:Copy_CallBack function called in the context of HLED_SeqPlay, NULL for none.
+ * @return	 :tenu_ErrorStatus status indicating the success or failure of the function.
+ * @details	 :Lets the caller of HLED_SeqUpdate sleep while every track is stopped, or until its next step,
+ *            and still show a new pattern at once, e.g. with a task notification.
+ */
+tenu_ErrorStatus HLED_SeqSetWakeCallBack(LED_SeqWakeCBF_t Copy_CallBack);
+/**
+ * @brief	 :Shows the steps of the tracks that are due.
+ * @param[in]:Copy_NowMs current time in ms.
+ * @return	 :u32 ms until the next step of any track, LED_SEQ_IDLE if all the tracks are stopped.
+ * @details	 :The steps are timed from their own deadlines, not from the call, so calling it late does not
+ *            shift the patterns. A single timer or runnable reloaded with the returned delay plays all the tracks.
+ */
+u32 HLED_SeqUpdate(u32 Copy_NowMs);
 
 
 #endif /* HAL_HLED_LED_H_ */
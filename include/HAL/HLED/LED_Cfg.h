@@ -26,6 +26,12 @@ typedef enum
 	_LED_NUM
 }LEDS_tenu;
 
+/* Brightness levels of the software PWM, a PWM period is LED_PWM_STEPS calls of HLED_PwmTick.
+ * e.g. 64 steps from a 10 kHz timer interrupt give a 156 Hz period, keep it above ~100 Hz to avoid flicker (max 65535) */
+#define LED_PWM_STEPS           64
+/* Patterns the sequencer can play at the same time, each one on its own LEDs */
+#define LED_SEQ_TRACKS          3
+
 
 
 
@@ -20,6 +20,9 @@
 
 #define SWITCH_OFFSET_4                   4
 
+#define SWITCH_MODE_POLLING               0
+#define SWITCH_MODE_EXTI                  1
+
 typedef struct{
 	void *PORT;
 	u32  PIN;
@@ -29,6 +32,8 @@ typedef struct{
 
 tenu_ErrorStatus HSWITCH_Init(void);
 tenu_ErrorStatus HSWITCH_GetSwitchStatus(u8 Copy_SwitchName, u8 *ADD_SwitchStatus);
+/* Press and release edges since the last call, bit n is the switch n of SWITCHES_tenu. Reading clears them. */
+tenu_ErrorStatus HSWITCH_GetEdges(u32 *ADD_PressMask, u32 *ADD_ReleaseMask);
 
 
 
@@ -25,6 +25,14 @@ typedef enum
 
 }SWITCHES_tenu;
 
+/* How the switches are sampled                                                                   */
+/* Options:                                                                                       */
+/*      1- SWITCH_MODE_POLLING ------->  HSWITCH_Runnable reads every switch each period          */
+/*      2- SWITCH_MODE_EXTI    ------->  HSWITCH_Runnable only debounces switches that had an edge */
+/* note: in SWITCH_MODE_EXTI each switch takes the EXTI line of its pin number, HSWITCH_Init returns  */
+/*       LBTY_Busy if another module (e.g. HKPD in KPD_MODE_EXTI) already owns one of them            */
+#define SWITCH_INPUT_MODE           SWITCH_MODE_POLLING
+
 
 
 #endif /* HAL_HSWITCH_SWITCH_CFG_H_ */
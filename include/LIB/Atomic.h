@@ -0,0 +1,36 @@
+#ifndef ATOMIC_H_
+#define ATOMIC_H_
+
+/*
+ * Lock-free access to the variables shared between a task and an ISR.
+ * On the Cortex-M4 the read-modify-write macros compile to an LDREX/STREX loop, the exclusive store
+ * fails and the loop retries when an ISR ran in between, so no critical section is needed around them.
+ * Host builds get the same compiler atomics, which keeps the drivers testable off target.
+ * Word, halfword and byte variables are all valid, unlike the bit-band alias of Bit_Band.h
+ * they also work on variables above the first 1 MB of SRAM and on several bits at once.
+ *
+ * VAR is the variable itself (an lvalue) like in Bit_Math.h, e.g.
+ *      ATOMIC_SET_BITS(KPDPressEdges,Local_u16Toggle&KPDPressed);
+ */
+
+// Set the bits of MASK in VAR atomically
+#define ATOMIC_SET_BITS(VAR,MASK)       ((void)__atomic_fetch_or(&(VAR),(MASK),__ATOMIC_SEQ_CST))
+// Clear the bits of MASK in VAR atomically
+#define ATOMIC_CLR_BITS(VAR,MASK)       ((void)__atomic_fetch_and(&(VAR),~(MASK),__ATOMIC_SEQ_CST))
+// Write VALUE to VAR atomically and give back the value it replaced
+#define ATOMIC_EXCHANGE(VAR,VALUE)      __atomic_exchange_n(&(VAR),(VALUE),__ATOMIC_SEQ_CST)
+
+/*
+ * Publish/consume ordering for single producer queues. On the Cortex-M4 the acquire and release forms
+ * are a plain load or store next to a DMB, the relaxed load is a plain load.
+ */
+// Read VAR, later accesses can't move before it
+#define ATOMIC_LOAD_ACQUIRE(VAR)        __atomic_load_n(&(VAR),__ATOMIC_ACQUIRE)
+// Read VAR without ordering
+#define ATOMIC_LOAD_RELAXED(VAR)        __atomic_load_n(&(VAR),__ATOMIC_RELAXED)
+// Write VALUE to VAR once all the earlier accesses are done
+#define ATOMIC_STORE_RELEASE(VAR,VALUE) __atomic_store_n(&(VAR),(VALUE),__ATOMIC_RELEASE)
+// Keep the loads before the fence ahead of every access after it
+#define ATOMIC_ACQUIRE_FENCE()          __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef BIT_BAND_H_
+#define BIT_BAND_H_
+
+/*
+ * Cortex-M4 bit-band access.
+ * Every bit of the first 1 MB of SRAM (0x20000000) and of the peripherals (0x40000000) has its own
+ * word in the alias region, 32 MB above the region base. A store to the alias word sets or clears
+ * that one bit in a single bus transaction, so it can't be undone by an ISR doing its own
+ * read-modify-write on the same register, and no critical section is needed around it.
+ * The System Control Space (NVIC, SCB, SysTick at 0xE000E000) is not bit-bandable,
+ * keep using the Bit_Math macros there.
+ *
+ * REG is the variable or register itself (an lvalue) like in Bit_Math.h, e.g.
+ *      BITBAND_SET_BIT(((USART_t*)USART1)->CR1,TRANSMIT_COMPLETE_BIT);
+ * BIT is counted from the address of REG, so for a u8 flag only bits 0..7 are valid.
+ */
+
+#define BITBAND_REGION_MASK             0xF0000000UL
+#define BITBAND_OFFSET_MASK             0x000FFFFFUL
+#define BITBAND_ALIAS_OFFSET            0x02000000UL
+
+#if defined(__arm__) || defined(__thumb__)
+
+// Address of the alias word of bit BIT of the byte at ADD
+#define BITBAND_ALIAS(ADD,BIT)          ((volatile u32 *)((((u32)(ADD))&BITBAND_REGION_MASK)+BITBAND_ALIAS_OFFSET+\
+                                        ((((u32)(ADD))&BITBAND_OFFSET_MASK)<<5)+(((u32)(BIT))<<2)))
+
+// Set bit BIT in REG atomically
+#define BITBAND_SET_BIT(REG,BIT)        (*BITBAND_ALIAS(&(REG),BIT)=1)
+// Clear bit BIT in REG atomically
+#define BITBAND_CLR_BIT(REG,BIT)        (*BITBAND_ALIAS(&(REG),BIT)=0)
+// Write VALUE (0 or 1) to bit BIT in REG atomically
+#define BITBAND_ASSIGN_BIT(REG,BIT,VALUE) (*BITBAND_ALIAS(&(REG),BIT)=((VALUE)!=0))
+// Get bit BIT in REG with a single load
+#define BITBAND_GET_BIT(REG,BIT)        (*BITBAND_ALIAS(&(REG),BIT))
+
+#else
+
+/* Host builds have no alias region, fall back on the compiler atomics on the variable itself */
+#define BITBAND_SET_BIT(REG,BIT)        ((void)__atomic_fetch_or(&(REG),(1UL<<(BIT)),__ATOMIC_SEQ_CST))
+#define BITBAND_CLR_BIT(REG,BIT)        ((void)__atomic_fetch_and(&(REG),~(1UL<<(BIT)),__ATOMIC_SEQ_CST))
+#define BITBAND_ASSIGN_BIT(REG,BIT,VALUE) ((VALUE)?BITBAND_SET_BIT(REG,BIT):BITBAND_CLR_BIT(REG,BIT))
+#define BITBAND_GET_BIT(REG,BIT)        ((__atomic_load_n(&(REG),__ATOMIC_SEQ_CST)>>(BIT))&0X01)
+
+#endif
+
+#endif
@@ -9,6 +9,8 @@
 #define TGL_BIT(REG,BIT)                (REG^=(1<<BIT))
 // Get bit BIT in REG           
 #define GET_BIT(REG,BIT)                ((REG>>BIT)&0X01) 
+// Get the number of the lowest set bit in REG, REG must not be 0 (RBIT and CLZ on the Cortex-M4)
+#define GET_LOWEST_SET_BIT(REG)         ((u8)__builtin_ctzl(REG))
           
 // Set high nibble in REG
 #define SET_HIGH_NIB(REG)               ((REG)|=0xf0)
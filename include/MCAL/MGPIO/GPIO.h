@@ -87,6 +87,11 @@
 #define GPIO_AF_SDIO            0x0000000C
 #define GPIO_AF_EVENTOUT        0x0000000F
 
+/*******Macros for The EXTI Trigger Edges*******/
+#define GPIO_EXTI_RISING        0x00000001
+#define GPIO_EXTI_FALLING       0x00000002
+#define GPIO_EXTI_BOTH          0x00000003
+
 
 
 typedef struct
@@ -98,6 +103,9 @@ typedef struct
     u32   AF;
 }GPIO_Pin_tstr;
 
+/* Called from the EXTI interrupt with the number of the line (pin) that fired */
+typedef void (*GPIO_EXTICallBack_t)(u8 Copy_Line);
+
 /*--------------------------------------------- APIs Interfaces ------------------------------------------*/
 
 /************************************Function Initializes the Pin************************************/
@@ -109,6 +117,7 @@ typedef struct
  * @param ADD_PinCfg Pointer to struct of Pin configurations
  * @return tenu_ErrorStatus
  * * @note	 : The function returns an error if a NULL pointer is provided as the configuration .
+ *             The first init of a pin acquires the clock of its port, there is no need to enable it before.
  */
 
 
@@ -116,6 +125,18 @@ tenu_ErrorStatus MGPIO_InitPin(GPIO_Pin_tstr* ADD_PinCfg);
 
 tenu_ErrorStatus MGPIO_InitPinAF(GPIO_Pin_tstr* ADD_PinCfg);
 
+/************************************Function Deinitializes the Pin************************************/
+/**
+ * @brief Puts the pin back to analog without pull and releases its reference on the port clock,
+ * the clock stops when no pin of the port is in use anymore
+ *
+ * @param Copy_Port Port containing the Pin
+ * @param Copy_Pin Pin number in the port
+ * @return tenu_ErrorStatus
+ * * @note	 : The function returns LBTY_NOK for a pin that was not set up by MGPIO_InitPin or MGPIO_InitPinAF.
+ */
+tenu_ErrorStatus MGPIO_DeinitPin(void* Copy_Port, u8 Copy_Pin);
+
 /************************************Function Set the Pin*****************************************/
 
 /**
@@ -145,6 +166,133 @@ tenu_ErrorStatus MGPIO_TogglePin(void* Copy_Port, u8 Copy_Pin);
  */
 tenu_ErrorStatus MGPIO_GetPinState(void* Copy_Port, u8 Copy_Pin, u8 * ADD_State);
 
+/************************************Function Set the Pins Mode****************************************/
+/**
+ * @brief Changes the mode (input, output, AF, analog) of several pins of a port with one MODER update
+ *
+ * Meant for buses that switch direction at run time (e.g. reading the LCD busy flag), the output
+ * type, pull and speed set by MGPIO_InitPin are kept.
+ *
+ * @param Copy_Port Port containing the Pins
+ * @param Copy_PinMask Mask of the pins, bit n for pin n
+ * @param Copy_Mode Any GPIO_MODE_xx, only its mode field (input/output/AF/analog) is used
+ * @return tenu_ErrorStatus
+ * * @note	 : The function returns an error if a NULL port is provided.
+ */
+tenu_ErrorStatus MGPIO_SetPinsMode(void* Copy_Port, u16 Copy_PinMask, u32 Copy_Mode);
+
+/************************************Function Configure the Pin EXTI************************************/
+/**
+ * @brief Routes the pin to its EXTI line, selects the trigger edge, registers the callback
+ * and unmasks the line in EXTI and NVIC
+ *
+ * @param Copy_Port Port containing the Pin
+ * @param Copy_Pin Pin number in the port, also the EXTI line number
+ * @param Copy_Edge Trigger edge (GPIO_EXTI_RISING, GPIO_EXTI_FALLING, GPIO_EXTI_BOTH)
+ * @param Copy_CallBack Function called from the interrupt when the edge is detected
+ * @return tenu_ErrorStatus
+ * * @note	 : Each EXTI line serves one port only. If the line is already owned by another port or
+ *             callback the function returns LBTY_Busy and leaves the line to its owner, the caller must
+ *             then sample that pin by polling. A port other than GPIOA..GPIOH is LBTY_ErrorInvalidInput.
+ *             The SYSCFG clock is acquired here.
+ */
+tenu_ErrorStatus MGPIO_ConfigEXTI(void* Copy_Port, u8 Copy_Pin, u8 Copy_Edge, GPIO_EXTICallBack_t Copy_CallBack);
+
+/************************************Function Enable the Pin EXTI*************************************/
+/**
+ * @brief Clears any stale pending edge and unmasks the EXTI line of the pin
+ *
+ * @param Copy_Pin EXTI line number (GPIO_PIN_0 .. GPIO_PIN_15)
+ * @return tenu_ErrorStatus
+ */
+tenu_ErrorStatus MGPIO_EnableEXTI(u8 Copy_Pin);
+
+/************************************Function Disable the Pin EXTI************************************/
+/**
+ * @brief Masks the EXTI line of the pin, the routing and the callback are kept
+ *
+ * @param Copy_Pin EXTI line number (GPIO_PIN_0 .. GPIO_PIN_15)
+ * @return tenu_ErrorStatus
+ */
+tenu_ErrorStatus MGPIO_DisableEXTI(u8 Copy_Pin);
+
+/*------------------------------------------ Inline Fast Path APIs ---------------------------------------*/
+/*
+ * The functions below are intended for pins whose port and pin are known at compile time or were
+ * validated once at init (LEDS[], SWITCH[], HLCD ...). They do no NULL or range checking, so each
+ * call compiles to a single load or store on the port registers. Use the checked APIs above when
+ * the port or pin come from a runtime source.
+ */
+
+/************************************Function Fast Write the Pin*************************************/
+/**
+ * @brief Writes the pin state through BSRR without any checks
+ *
+ * @param Copy_Port Port containing the Pin
+ * @param Copy_Pin Pin number in the port (GPIO_PIN_0 .. GPIO_PIN_15)
+ * @param Copy_State State to set the Pin to (GPIO_High, GPIO_Low)
+ */
+static inline void MGPIO_FastWritePin(void* Copy_Port, u8 Copy_Pin, u8 Copy_State)
+{
+	((GPIO_Reg*)Copy_Port)->BSRR=(1UL<<(Copy_Pin+((Copy_State==GPIO_Low)*GPIO_BSRR_RESET_OFFSET)));
+}
+
+/************************************Function Fast Read the Pin**************************************/
+/**
+ * @brief Reads the pin state from IDR without any checks
+ *
+ * @param Copy_Port Port containing the Pin
+ * @param Copy_Pin Pin number in the port (GPIO_PIN_0 .. GPIO_PIN_15)
+ * @return u8 GPIO_High or GPIO_Low
+ */
+static inline u8 MGPIO_FastReadPin(void* Copy_Port, u8 Copy_Pin)
+{
+	return (u8)((((GPIO_Reg*)Copy_Port)->IDR>>Copy_Pin)&0x01);
+}
+
+/************************************Function Fast Toggle the Pin************************************/
+/**
+ * @brief Toggles the pin with a single BSRR store computed from ODR
+ *
+ * Unlike ODR^=, other pins of the port are never written back, so an ISR driving
+ * another pin of the same port between the read and the store is not overridden.
+ *
+ * @param Copy_Port Port containing the Pin
+ * @param Copy_Pin Pin number in the port (GPIO_PIN_0 .. GPIO_PIN_15)
+ */
+static inline void MGPIO_FastTogglePin(void* Copy_Port, u8 Copy_Pin)
+{
+	u32 Local_PinMask=(1UL<<Copy_Pin);
+	u32 Local_Odr=((GPIO_Reg*)Copy_Port)->ODR;
+	((GPIO_Reg*)Copy_Port)->BSRR=((Local_Odr&Local_PinMask)<<GPIO_BSRR_RESET_OFFSET)|((~Local_Odr)&Local_PinMask);
+}
+
+/************************************Function Fast Write the Port************************************/
+/**
+ * @brief Sets and resets several pins of the same port in one BSRR store
+ *
+ * @param Copy_Port Port containing the Pins
+ * @param Copy_SetMask Mask of the pins to be set high
+ * @param Copy_ResetMask Mask of the pins to be set low
+ * @note	 : If a pin is in both masks it is set, as BSRR gives priority to the set half.
+ */
+static inline void MGPIO_FastWritePort(void* Copy_Port, u16 Copy_SetMask, u16 Copy_ResetMask)
+{
+	((GPIO_Reg*)Copy_Port)->BSRR=(((u32)Copy_ResetMask)<<GPIO_BSRR_RESET_OFFSET)|Copy_SetMask;
+}
+
+/************************************Function Fast Read the Port*************************************/
+/**
+ * @brief Reads all the input pins of the port in one IDR load
+ *
+ * @param Copy_Port Port to read
+ * @return u16 IDR value, bit n holds the state of pin n
+ */
+static inline u16 MGPIO_FastReadPort(void* Copy_Port)
+{
+	return (u16)(((GPIO_Reg*)Copy_Port)->IDR&GPIO_PIN_MASK);
+}
+
 
 
 #endif /* MCAL_MGPIO_GPIO_H_ */
@@ -17,6 +17,17 @@
 #define GPIO_CLEAR_MASK     0x00000003
 #define GPIO_PIN_OFFSET_2   0x00000002
 #define GPIO_PIN_OFFSET_3   0x00000003
+#define GPIO_BSRR_RESET_OFFSET      0x00000010
+#define GPIO_PIN_MASK       0x0000FFFF
+/* Ports A..H, the index of a port is also its bit in RCC_AHB1ENR */
+#define GPIO_PORTS_NUM      8
+
+/* EXTI lines 0..15 map to the pins of the same number, four lines per SYSCFG_EXTICR register */
+#define GPIO_EXTI_LINES_NUM         16
+#define GPIO_EXTICR_LINES_PER_REG   0x00000004
+#define GPIO_EXTICR_FIELD_MASK      0x0000000F
+#define GPIO_EXTI_9_5_MASK          0x000003E0
+#define GPIO_EXTI_15_10_MASK        0x0000FC00
 
 
 
@@ -27,9 +27,27 @@ typedef struct{
 
 }GPIO_Reg;
 
+typedef struct{
+	volatile u32 MEMRMP;
+	volatile u32 PMC;
+	volatile u32 EXTICR[4];
+	volatile u32 Reserved[2];
+	volatile u32 CMPCR;
+}SYSCFG_Reg;
+
+typedef struct{
+	volatile u32 IMR;
+	volatile u32 EMR;
+	volatile u32 RTSR;
+	volatile u32 FTSR;
+	volatile u32 SWIER;
+	volatile u32 PR;
+}EXTI_Reg;
+
 /***************** Variables Definition **************/
 
 
+#if defined(__arm__) || defined(__thumb__)
 /**               GPIOA BASE ADD               **/
 #define GPIOA_BASE_ADD                 0x40020000
 /**               GPIOB BASE ADD               **/
@@ -42,5 +60,29 @@ typedef struct{
 #define GPIOE_BASE_ADD                 0x40021000
 /**               GPIOH BASE ADD               **/
 #define GPIOH_BASE_ADD                 0x40021C00
+/**               SYSCFG BASE ADD              **/
+#define SYSCFG_BASE_ADD                0x40013800
+/**               EXTI BASE ADD                **/
+#define EXTI_BASE_ADD                  0x40013C00
+
+#else
+
+/* Host builds have no peripherals, the test harness defines GPIO_HostRegs and the ports, SYSCFG and EXTI    */
+/* are laid out in it with the spacing of the real ones, so the port index arithmetic of GPIO.c still holds */
+#define GPIO_HOST_REGS_SIZE            0x00002800
+extern u32 GPIO_HostRegs[GPIO_HOST_REGS_SIZE/4];
+#define GPIOA_BASE_ADD                 ((u32)GPIO_HostRegs+0x00000000)
+#define GPIOB_BASE_ADD                 ((u32)GPIO_HostRegs+0x00000400)
+#define GPIOC_BASE_ADD                 ((u32)GPIO_HostRegs+0x00000800)
+#define GPIOD_BASE_ADD                 ((u32)GPIO_HostRegs+0x00000C00)
+#define GPIOE_BASE_ADD                 ((u32)GPIO_HostRegs+0x00001000)
+#define GPIOH_BASE_ADD                 ((u32)GPIO_HostRegs+0x00001C00)
+#define SYSCFG_BASE_ADD                ((u32)GPIO_HostRegs+0x00002000)
+#define EXTI_BASE_ADD                  ((u32)GPIO_HostRegs+0x00002400)
+
+#endif
+
+#define SYSCFG                 ((SYSCFG_Reg *)(SYSCFG_BASE_ADD))
+#define EXTI                   ((EXTI_Reg *)(EXTI_BASE_ADD))
 
 #endif /* MCAL_MGPIO_GPIO_REG_H_ */
@@ -1,6 +1,9 @@
+#ifndef MCAL_MNVIC_H_
+#define MCAL_MNVIC_H_
 /********************************************************************************************************/
 /************************************************Includes************************************************/
 /********************************************************************************************************/
+#include <stdint.h>
 #include "STD_TYPES.h"
 #include "MNVIC_Config.h"
 #include "STM32F401CC.h"
@@ -21,17 +24,64 @@
 #define GROUP_1_BIT_SUB_3_BIT  0x05FA0600
 #define GROUP_0_BIT_SUB_4_BIT  0x05FA0700
 
+#define NVIC_NO_RTOS_CALLS     0
+#define NVIC_RTOS_CALLS        1
+#define NVIC_PRIO_LEVELS       16
+
+#define NVIC_VECTORS_FLASH     0
+#define NVIC_VECTORS_RAM       1
+
+#define NVIC_STATS_DISABLE     0
+#define NVIC_STATS_ENABLE      1
+
+/* Measures the handler of IRQ, first and last statement of a handler that is not reached through the RAM vector wrapper */
+#if (NVIC_ISR_STATS==NVIC_STATS_ENABLE)&&(NVIC_VECTOR_TABLE==NVIC_VECTORS_FLASH)
+#define NVIC_ISR_ENTER(IRQ)    MNVIC_StatsEnter(IRQ)
+#define NVIC_ISR_EXIT(IRQ)     MNVIC_StatsExit(IRQ)
+#else
+#define NVIC_ISR_ENTER(IRQ)
+#define NVIC_ISR_EXIT(IRQ)
+#endif
+
+#if !defined(__arm__) && !defined(__thumb__)
+/* Host builds have no DWT, the statistics read this counter that the tests advance, 32 bits wide like CYCCNT */
+extern volatile uint32_t NVIC_HostCycles;
+#endif
+
 
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
+/* Interrupt handler installed with MNVIC_SetHandler */
+typedef void (*NVIC_Handler_t)(void);
 
+/* Cycles spent in the handler of one interrupt, the cycles of the handlers preempting it are not counted */
+typedef struct
+{
+    u32 Count;          // Runs of the handler
+    u32 MaxCycles;      // Longest run
+    u64 TotalCycles;    // Sum of all the runs
+}NVIC_IrqStats_tstr;
+
+/* One entry of the priority plan */
+typedef struct
+{
+    u8 InterruptID;     // IRQ_ID_tenu
+    u8 Priority;        // 0..15, 0 is the most urgent
+}NVIC_PriorityCfg_tstr;
 
 
 
 /********************************************************************************************************/
 /************************************************APIs****************************************************/
 /********************************************************************************************************/
+/**
+ * @brief Selects the priority grouping and applies the priority plan of MNVIC_Config.c.
+ *
+ * Every interrupt of NVIC_PriorityPlan[] gets its level and SysTick gets NVIC_PRIO_SYSTICK, call it at
+ * boot before any interrupt is enabled. With NVIC_VECTORS_RAM the vector table is first copied to SRAM
+ * and VTOR moved to the copy, the link-time handlers stay installed until replaced.
+ */
 void MNVIC_Init(void);
 /**
  * @brief Enables a specific interrupt in the NVIC by setting the corresponding bit in the ISER register.
@@ -93,7 +143,7 @@ tenu_ErrorStatus MNVIC_GetActiveStatus(u8 Copy_InterruptID,u8 * Add_Status);
  * by manipulating the IPR register. It is part of interrupt control and handling.
  *
  * @param Copy_InterruptID ID of the interrupt to set the priority.
- * @param copy_Priority Priority value to set.
+ * @param copy_Priority Priority value to set, 0..15.
  * @return tenu_ErrorStatus Error status indicating success or failure.
  */
 tenu_ErrorStatus MNVIC_SetPriority(u8 Copy_InterruptID,u8 copy_Priority);
@@ -107,3 +157,70 @@ tenu_ErrorStatus MNVIC_SetPriority(u8 Copy_InterruptID,u8 copy_Priority);
  * @return tenu_ErrorStatus Error status indicating success or failure.
  */
 tenu_ErrorStatus MNVIC_GenerateSWInterrupt(u8 Copy_InterruptID);
+/**
+ * @brief Installs the handler of an interrupt in the RAM vector table.
+ *
+ * The handler is called by the core on the vector directly, without a dispatch function in between,
+ * and takes effect on the next entry of the interrupt, so the application can swap handlers between modes.
+ * The drivers of this tree don't use it: USART and EXTI keep their link-time handlers, which dispatch
+ * through their callback tables whatever NVIC_VECTOR_TABLE is.
+ *
+ * @param Copy_InterruptID ID of the interrupt.
+ * @param Copy_Handler Function run on the interrupt, it must clear the pending flag of its peripheral.
+ * @param ADD_OldHandler Handler replaced, NULL if not needed.
+ * @return tenu_ErrorStatus LBTY_ErrorInvalidInput for a wrong ID, LBTY_ErrorNullPointer for a NULL handler,
+ * LBTY_NOK when the table is not in RAM (NVIC_VECTORS_FLASH or MNVIC_Init not called yet).
+ */
+tenu_ErrorStatus MNVIC_SetHandler(u8 Copy_InterruptID,NVIC_Handler_t Copy_Handler,NVIC_Handler_t * ADD_OldHandler);
+/**
+ * @brief Marks the entry and the exit of a handler for the statistics, through NVIC_ISR_ENTER and NVIC_ISR_EXIT
+ * or the RAM vector wrapper.
+ *
+ * @param Copy_InterruptID ID of the interrupt being served.
+ */
+void MNVIC_StatsEnter(u8 Copy_InterruptID);
+void MNVIC_StatsExit(u8 Copy_InterruptID);
+/**
+ * @brief Gets the cycle statistics of an interrupt.
+ *
+ * @param Copy_InterruptID ID of the interrupt.
+ * @param ADD_Stats Pointer to the statistics, copied with interrupts masked.
+ * @return tenu_ErrorStatus LBTY_ErrorInvalidInput for a wrong ID, LBTY_ErrorNullPointer for a NULL pointer,
+ * LBTY_NOK when NVIC_ISR_STATS is NVIC_STATS_DISABLE.
+ */
+tenu_ErrorStatus MNVIC_GetIrqStats(u8 Copy_InterruptID,NVIC_IrqStats_tstr * ADD_Stats);
+/**
+ * @brief Gets the deepest nesting of measured handlers seen, 1 when no handler was ever preempted.
+ */
+u8 MNVIC_GetMaxPreemptionDepth(void);
+/**
+ * @brief Masks the interrupts (PRIMASK) for a critical section.
+ *
+ * Sections can be nested, each MNVIC_ExitCritical gets back the value returned by its MNVIC_EnterCritical.
+ * With NVIC_ISR_STATS the time from the outermost entry to its exit is measured as blocked time.
+ *
+ * @return u32 PRIMASK before the call, to give to MNVIC_ExitCritical.
+ */
+u32 MNVIC_EnterCritical(void);
+/**
+ * @brief Ends a critical section, interrupts are unmasked again when the outermost one ends.
+ *
+ * @param Copy_Primask Value returned by the matching MNVIC_EnterCritical.
+ */
+void MNVIC_ExitCritical(u32 Copy_Primask);
+/**
+ * @brief Gets the cycle statistics of the outermost critical sections, the time the interrupts were blocked.
+ *
+ * @param ADD_Stats Pointer to the statistics, Count is the number of sections.
+ * @return tenu_ErrorStatus LBTY_ErrorNullPointer for a NULL pointer, LBTY_NOK when NVIC_ISR_STATS is NVIC_STATS_DISABLE.
+ */
+tenu_ErrorStatus MNVIC_GetBlockedStats(NVIC_IrqStats_tstr * ADD_Stats);
+/**
+ * @brief Clears the statistics of all the interrupts, the blocked time and the preemption depth.
+ */
+void MNVIC_ResetStats(void);
+
+extern const NVIC_PriorityCfg_tstr NVIC_PriorityPlan[];
+extern const u8 NVIC_PriorityPlanNum;
+
+#endif // MCAL_MNVIC_H_
@@ -12,8 +12,43 @@
  * GROUP_2_BIT_SUB_2_BIT
  * GROUP_1_BIT_SUB_3_BIT
  * GROUP_0_BIT_SUB_4_BIT 
+ * FreeRTOS asserts that all the bits are preemption bits, and without sub priorities the order
+ * between two levels never depends on which one is pending first
  */
-#define NVIC_GROUP_SUP_DIST  GROUP_3_BIT_SUB_1_BIT
+#define NVIC_GROUP_SUP_DIST  GROUP_4_BIT_SUB_0_BIT
+
+/* Vector table used after MNVIC_Init
+ * Options:
+ *      1- NVIC_VECTORS_FLASH   the link-time table, MNVIC_SetHandler is not available
+ *      2- NVIC_VECTORS_RAM     copied to SRAM and pointed to by VTOR, handlers can be changed with MNVIC_SetHandler,
+ *                              only worth its 404 bytes of SRAM (512-byte aligned) when the application installs handlers at
+ *                              run time, no driver of this tree does */
+#define NVIC_VECTOR_TABLE    NVIC_VECTORS_FLASH
+
+/* Cycle statistics of the interrupts, measured with the DWT cycle counter
+ * Options:
+ *      1- NVIC_STATS_DISABLE
+ *      2- NVIC_STATS_ENABLE    with NVIC_VECTORS_RAM every interrupt goes through a measuring wrapper,
+ *                              with NVIC_VECTORS_FLASH only the handlers with NVIC_ISR_ENTER/NVIC_ISR_EXIT are measured */
+#define NVIC_ISR_STATS       NVIC_STATS_DISABLE
+
+/* Priority plan applied by MNVIC_Init, 0 is the most urgent level and 15 the least.
+ * A handler waits at most for the longest handler of the levels above it, plus the FreeRTOS
+ * critical sections when it is at or below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+ * Latency-critical classes (DMA transfer complete, USART reception) must be above the bulk ones
+ * (EXTI of the switches and keypad), the SysTick tick is the least urgent. */
+#define NVIC_PRIO_DMA        5
+#define NVIC_PRIO_USART      6
+#define NVIC_PRIO_EXTI       10
+#define NVIC_PRIO_SYSTICK    15
+
+/* Classes whose handlers call the FreeRTOS FromISR functions, they must not be above the syscall ceiling
+ * Options:
+ *      1- NVIC_RTOS_CALLS
+ *      2- NVIC_NO_RTOS_CALLS */
+#define NVIC_DMA_RTOS        NVIC_RTOS_CALLS
+#define NVIC_USART_RTOS      NVIC_RTOS_CALLS
+#define NVIC_EXTI_RTOS       NVIC_RTOS_CALLS
 
 
 /********************************************************************************************************/
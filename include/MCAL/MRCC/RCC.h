@@ -9,6 +9,7 @@
  ************************************************************************************************************/
 #include "RCC_Private.h"
 #include "RCC_Reg.h"
+#include "RCC_Cfg.h"
 
 #ifndef MCAL_RCC_H_
 #define MCAL_RCC_H_
@@ -96,6 +97,29 @@
 
 
 
+/* These macros should used with the PLLSource field of RCC_ClockPlan_tstr */
+#define RCC_PLL_SOURCE_HSI                     0
+#define RCC_PLL_SOURCE_HSE                     1
+#define RCC_PLL_SOURCE_HSE_BYPASS              2
+
+/* A full clock tree setting, applied by MRCC_ConfigureSystemClock */
+typedef struct
+{
+	u8  SystemClock;   // RCC_SYSTEM_CLOCK_HSI, RCC_SYSTEM_CLOCK_HSE or RCC_SYSTEM_CLOCK_PLL
+	u8  PLLSource;     // RCC_PLL_SOURCE_xxx, also selects the HSE mode when SystemClock is RCC_SYSTEM_CLOCK_HSE
+	u8  PLLM;          // 2..63, the VCO input (source/M) must be 1..2 MHz
+	u16 PLLN;          // 50..432, the VCO output must be 192..432 MHz
+	u8  PLLP;          // 2, 4, 6 or 8
+	u8  PLLQ;          // 2..15, the 48 MHz clock must not exceed 48 MHz
+	u16 AHBDiv;        // 1, 2, 4, 8, 16, 64, 128, 256 or 512
+	u8  APB1Div;       // 1, 2, 4, 8 or 16, PCLK1 must not exceed 42 MHz
+	u8  APB2Div;       // 1, 2, 4, 8 or 16
+}RCC_ClockPlan_tstr;
+
+/* Called after the clock tree changed, the new frequencies are already given by the MRCC_GetxxxHz getters */
+typedef void (*RCC_ClockCb_t)(void);
+
+
 /*--------------------------------------------- APIs Interfaces ------------------------------------------*/
 
 /************************************Function Enable Peripheral Clock************************************/
@@ -123,6 +147,7 @@ tenu_ErrorStatus MRCC_EnablePeripheralClock(u8 BusId,u8 PerId);
  */
 tenu_ErrorStatus MRCC_DisablePeripheralClock(u8 BusId,u8 PerId);
 /************************************Functions Control Peripheral Clock************************************/
+/* Direct switches, a driver sharing a clock with others should use MRCC_AcquireClock and MRCC_ReleaseClock */
 tenu_ErrorStatus MRCC_ControlClockAHP1Peripheral(u32 AHB1Peripheral,u8 Status);
 tenu_ErrorStatus MRCC_ControlClockAHP2Peripheral(u32 AHB2Peripheral,u8 Status);
 tenu_ErrorStatus MRCC_ControlClockABP1Peripheral(u32 APB1Peripheral,u8 Status);
@@ -148,6 +173,92 @@ tenu_ErrorStatus MRCC_SelectPLLPFactor(u32 PLLPFactor);
 tenu_ErrorStatus MRCC_SelectPLLMFactor(u32 PLLMFactor);
 /******************************Function to Select N factor for PLL****************************************/
 tenu_ErrorStatus MRCC_SelectPLLNFactor(u32 PLLNFactor);
+/******************************Function to Configure the whole clock tree****************************************/
+/*
+ *@brief      : Function to switch the system to a clock plan.
+ *@param[in1] : ADD_Plan, plan to apply, usually &RCC_ClockPlans[RCC_PLAN_xxx].
+ *@return     : tenu_ErrorStatus indicating the success or failure of the Function.
+ *@details	  : The plan is checked against the limits of the STM32F401 first, nothing is touched if it is not valid.
+ *              The flash wait states are raised before the clock goes up and lowered after it goes down, the PLL
+ *              is reprogrammed while the core runs from HSI, unless it already runs with the settings of the plan,
+ *              then only the prescalers and SW change. Prefetch and the instruction and data caches are enabled at
+ *              the end. Interrupts are only masked around the SW and prescaler stores, the oscillators and the PLL
+ *              lock are waited for with the interrupts enabled, and the subscribers are told of each switch.
+ * @note	  : Returns LBTY_ErrorInvalidInput for a wrong plan, LBTY_NOK if an oscillator, the PLL or the switch
+ *              is not ready in time, the system is then left on HSI.
+ */
+tenu_ErrorStatus MRCC_ConfigureSystemClock(const RCC_ClockPlan_tstr * ADD_Plan);
+
+/******************************Function to Get the HCLK of a clock plan****************************************/
+/*
+ *@brief      : Function to check a plan and get the HCLK it would give, without applying it.
+ *@param[in1] : ADD_Plan, plan to check.
+ *@param[out] : ADD_HCLKHz, HCLK of the plan in Hz.
+ *@return     : tenu_ErrorStatus, LBTY_ErrorInvalidInput for a plan MRCC_ConfigureSystemClock would refuse.
+ */
+tenu_ErrorStatus MRCC_GetPlanHCLKHz(const RCC_ClockPlan_tstr * ADD_Plan, u32 *ADD_HCLKHz);
+/******************************Functions to Get the clock frequencies****************************************/
+/*
+ *@brief      : Functions to get the SYSCLK, HCLK, PCLK1 (APB1) and PCLK2 (APB2) frequencies in Hz.
+ *@details	  : The values are computed from the RCC registers when the clock changes and cached, a getter only
+ *              reads a variable. They start at the 16 MHz HSI of the reset.
+ */
+u32 MRCC_GetSYSCLKHz(void);
+u32 MRCC_GetHCLKHz(void);
+u32 MRCC_GetPCLK1Hz(void);
+u32 MRCC_GetPCLK2Hz(void);
+/******************************Function to Update the clock frequencies****************************************/
+/*
+ *@brief      : Function to recompute the cached frequencies from the RCC registers and notify the subscribers.
+ *@details	  : Called by MRCC_ConfigureSystemClock, call it after changing the clock with the other MRCC functions.
+ *              SystemCoreClock is set to HCLK.
+ */
+void MRCC_UpdateClockFrequencies(void);
+/******************************Function to Subscribe to clock changes****************************************/
+/*
+ *@brief      : Function to register a callback run after each clock change, with interrupts masked.
+ *@param[in1] : Copy_Callback, function that re-derives the settings of a driver from the new frequencies.
+ *@return     : tenu_ErrorStatus indicating the success or failure of the Function.
+ * @note	  : Returns LBTY_ErrorNullPointer for a NULL callback, LBTY_NOK when RCC_CLOCK_SUBSCRIBERS are registered.
+ *              A callback already registered is not added twice.
+ */
+tenu_ErrorStatus MRCC_SubscribeClockChange(RCC_ClockCb_t Copy_Callback);
+
+/******************************Functions to Acquire and Release a peripheral clock****************************************/
+/*
+ *@brief      : Functions to take and give back a reference on a peripheral clock.
+ *@param[in1] : Copy_u8BusId, RCC_AHB1, RCC_AHB2, RCC_APB1 or RCC_APB2.
+ *@param[in2] : Copy_u32Peripheral, one RCC_xxx_yyy macro of that bus, e.g. RCC_AHB1_GPIOB.
+ *@return     : tenu_ErrorStatus indicating the success or failure of the Function.
+ *@details	  : The clock is enabled by the first acquire and disabled by the last release, so drivers sharing a
+ *              peripheral (e.g. two HAL drivers on GPIOB) can't turn it off under each other. Interrupts are masked
+ *              while the count and the enable register are updated.
+ * @note	  : Returns LBTY_ErrorInvalidInput for a wrong bus or a mask that is not a single peripheral of the bus,
+ *              LBTY_NOK for a release without acquire or when RCC_REFS_MAX references are held.
+ *              Turning the same clock off with MRCC_ControlClockxxxPeripheral bypasses the counts.
+ */
+tenu_ErrorStatus MRCC_AcquireClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral);
+tenu_ErrorStatus MRCC_ReleaseClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral);
+/******************************Function to Get the live clocks of a bus****************************************/
+/*
+ *@brief      : Function to get the peripherals of a bus whose clock is running.
+ *@param[in1] : Copy_u8BusId, RCC_AHB1, RCC_AHB2, RCC_APB1 or RCC_APB2.
+ *@param[out] : ADD_Clocks, mask of RCC_xxx_yyy macros, read from the enable register so clocks enabled
+ *              without MRCC_AcquireClock are reported too.
+ *@return     : tenu_ErrorStatus indicating the success or failure of the Function.
+ */
+tenu_ErrorStatus MRCC_GetLiveClocks(u8 Copy_u8BusId,u32 *ADD_Clocks);
+/******************************Function to Get the references on a clock****************************************/
+/*
+ *@brief      : Function to get how many users hold a peripheral clock through MRCC_AcquireClock.
+ *@param[in1] : Copy_u8BusId, RCC_AHB1, RCC_AHB2, RCC_APB1 or RCC_APB2.
+ *@param[in2] : Copy_u32Peripheral, one RCC_xxx_yyy macro of that bus.
+ *@param[out] : ADD_Refs, number of references.
+ *@return     : tenu_ErrorStatus indicating the success or failure of the Function.
+ */
+tenu_ErrorStatus MRCC_GetClockRefs(u8 Copy_u8BusId,u32 Copy_u32Peripheral,u8 *ADD_Refs);
+
+extern const RCC_ClockPlan_tstr RCC_ClockPlans[_RCC_PLAN_NUM];
 
 
 #endif /* MCAL_RCC_H_ */
@@ -10,6 +10,28 @@
 #ifndef MCAL_RCC_CFG_H_
 #define MCAL_RCC_CFG_H_
 
+/* Clock plans of RCC_ClockPlans[], passed to MRCC_ConfigureSystemClock */
+typedef enum
+{
+	RCC_PLAN_HSI_16MHZ=0,
+	RCC_PLAN_HSI_PLL_42MHZ,
+	RCC_PLAN_HSI_PLL_84MHZ,
+	RCC_PLAN_HSE_PLL_84MHZ,
+
+
+	_RCC_PLAN_NUM
+}RCC_Plans_tenu;
+
+/* Frequency of the HSE crystal or of the external clock on OSC_IN */
+#define RCC_HSE_HZ                   25000000UL
+/* HCLK covered by each flash wait state, 30 MHz for a 2.7 V to 3.6 V supply (RM0368 table 6),
+ * 24 MHz for 2.4 V to 2.7 V, 18 MHz for 2.1 V to 2.4 V, 16 MHz for 1.7 V to 2.1 V */
+#define RCC_FLASH_WS_HZ              30000000UL
+/* Loops to wait for an oscillator, the PLL or the clock switch before giving up */
+#define RCC_READY_TIMEOUT            100000UL
+/* Drivers that can be told of a clock change (USART, STK, HCLCD, HKPD, ...) */
+#define RCC_CLOCK_SUBSCRIBERS        6
+
 
 
 
@@ -11,8 +11,19 @@
 #ifndef MCAL_RCC_PRIVATE_H_
 #define MCAL_RCC_PRIVATE_H_
 
+#if defined(__arm__) || defined(__thumb__)
 /**                RCC BASE ADD              **/
 #define RCC_BASE_ADD                 0x40023800
+/**                FLASH BASE ADD            **/
+#define FLASH_BASE_ADD               0x40023C00
+#else
+/* Host builds have no peripherals, the test harness defines RCC_HostRegs and RCC and the flash interface */
+/* are laid out in it with the spacing of the real ones                                                 */
+#define RCC_HOST_REGS_SIZE           0x00001000
+extern u32 RCC_HostRegs[RCC_HOST_REGS_SIZE/4];
+#define RCC_BASE_ADD                 ((u32)RCC_HostRegs+0x00000000)
+#define FLASH_BASE_ADD               ((u32)RCC_HostRegs+0x00000400)
+#endif
 
 
 /**                PLL SOURCE                 **/
@@ -54,6 +65,54 @@
 #define RCC_PLLM_MASK                          0XFFFFFFC0
 #define RCC_PLLP_MASK                          0XFFFCFFFF
 
+/**                CLOCK PLAN               **/
+#define RCC_HSI_HZ                             16000000UL
+#define RCC_CR_HSEBYP                          18
+#define RCC_CFGR_SW_MASK                       0X00000003
+#define RCC_CFGR_SWS_MASK                      0X0000000C
+#define RCC_CFGR_SWS_OFFSET                    2
+#define RCC_CFGR_HPRE_OFFSET                   4
+#define RCC_CFGR_PPRE1_OFFSET                  10
+#define RCC_CFGR_PPRE2_OFFSET                  13
+#define RCC_CFGR_PRESCALERS_MASK               0X0000FCF0
+#define RCC_PLLCFGR_N_OFFSET                   6
+#define RCC_PLLCFGR_P_OFFSET                   16
+#define RCC_PLLCFGR_Q_OFFSET                   24
+#define RCC_PLLCFGR_FIELDS_MASK                0X0F437FFF
+/* Limits of the STM32F401 */
+#define RCC_SYSCLK_MAX_HZ                      84000000UL
+#define RCC_APB1_MAX_HZ                        42000000UL
+#define RCC_APB2_MAX_HZ                        84000000UL
+#define RCC_HSE_MIN_HZ                         4000000UL
+#define RCC_HSE_MAX_HZ                         26000000UL
+#define RCC_VCO_IN_MIN_HZ                      1000000UL
+#define RCC_VCO_IN_MAX_HZ                      2000000UL
+#define RCC_VCO_OUT_MIN_HZ                     192000000UL
+#define RCC_VCO_OUT_MAX_HZ                     432000000UL
+#define RCC_PLLN_VALUE_MIN                     50
+#define RCC_PLLN_VALUE_MAX                     432
+#define RCC_PLLQ_VALUE_MIN                     2
+#define RCC_PLLQ_VALUE_MAX                     15
+#define RCC_PLL48_MAX_HZ                       48000000UL
+
+/**                FLASH ACR                **/
+#define FLASH_ACR_LATENCY_MASK                 0X0000000F
+#define FLASH_ACR_PRFTEN                       8
+#define FLASH_ACR_ICEN                         9
+#define FLASH_ACR_DCEN                         10
+#define FLASH_ACR_ICRST                        11
+#define FLASH_ACR_DCRST                        12
+
+/**                CLOCK GATING             **/
+/* Buses RCC_AHB1 to RCC_APB2 whose clocks are reference counted */
+#define RCC_GATED_BUSES_NUM                    4
+#define RCC_REFS_MAX                           255
+/* Enable bits that exist on the STM32F401 */
+#define RCC_AHB1_CLOCKS_MASK                   0X0060109F
+#define RCC_AHB2_CLOCKS_MASK                   0X00000080
+#define RCC_APB1_CLOCKS_MASK                   0X10E2C80F
+#define RCC_APB2_CLOCKS_MASK                   0X00077931
+
 
 
 
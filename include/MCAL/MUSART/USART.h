@@ -133,7 +133,8 @@ typedef enum {
 	USART_StopBitsError,
 	USART_OverSamplingError,
 	USART_UsartSelectError,
-	USART_NullConfPointer
+	USART_NullConfPointer,
+	USART_ClockError
 
 
 }USART_enuErrorStatus;
@@ -150,6 +151,15 @@ typedef enum {
  */
 USART_enuErrorStatus USART_Init(const USART_strCfg_t *ConfigPtr);
 
+/**
+ * @brief Disable a USART channel and give back its reference on the peripheral clock
+ * 
+ * @param Channel USART channel (USART1, USART2, USART6)
+ * @return USART_enuErrorStatus Error status
+ * @note Returns USART_ClockError for a channel that was not set up by USART_Init.
+ */
+USART_enuErrorStatus USART_DeInit(void *Channel);
+
 /**
  * @brief Send a byte synchronously
  * 
@@ -18,8 +18,8 @@
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
 
-#define STK_AHB_DIV_8                  STK_SYSTEM_CLK/8
-#define STK_AHB                        STK_SYSTEM_CLK
+#define STK_AHB_DIV_8                  0
+#define STK_AHB                        1
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
@@ -97,6 +97,18 @@ tenu_ErrorStatus  MSTK_GetElapsedTimeMS (u32 *ADD_ElasedTime);
  * @return tenu_ErrorStatus Error status indicating success or failure.
  */
 tenu_ErrorStatus  MSTK_GetRemainingTimeMS (u32 *ADD_RemainingTime);
+/**
+ * @brief Get the current value of the SysTick down counter.
+ *
+ * @return u32 VAL, counts down from the reload value to 0 at the SysTick clock.
+ */
+u32 MSTK_GetCounterValue(void);
+/**
+ * @brief Get the reload value of the SysTick, a period is the reload value plus one counts.
+ *
+ * @return u32 LOAD.
+ */
+u32 MSTK_GetReloadValue(void);
 
 
 
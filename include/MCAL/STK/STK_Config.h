@@ -3,12 +3,12 @@
 #define MCAL_SYSTICK_STK_CONFIG_H_
 
 /*
- * OPTIONS:
- * STK_AHB_DIV_8      max timeMS    8000
- * STK_AHB            max timeMS    1000
+ * OPTIONS:                          max timeMS at 16 MHz / 84 MHz
+ * STK_AHB_DIV_8                     8388 / 1597
+ * STK_AHB                           1048 / 199
+ * The clock itself is HCLK, taken from MRCC and followed on each change.
  */
 #define STK_CLOCK_SOURCE         STK_AHB_DIV_8
-#define STK_SYSTEM_CLK           16000000
 
 
 
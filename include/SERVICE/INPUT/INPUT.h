@@ -0,0 +1,81 @@
+#ifndef SERVICE_INPUT_INPUT_H_
+#define SERVICE_INPUT_INPUT_H_
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "INPUT_Config.h"
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define INPUT_DISABLE               0
+#define INPUT_ENABLE                1
+
+/* Source of an event */
+#define INPUT_SOURCE_KPD            0
+#define INPUT_SOURCE_SWITCH         1
+
+/* Type of an event */
+#define INPUT_EVENT_PRESS           0
+#define INPUT_EVENT_RELEASE         1
+#define INPUT_EVENT_LONG_PRESS      2
+#define INPUT_EVENT_REPEAT          3
+
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+   u32 TimeMs;      // Scheduler time of the event
+   u8 Source;       // INPUT_SOURCE_KPD or INPUT_SOURCE_SWITCH
+   u8 Type;         // INPUT_EVENT_xxx
+   u8 Index;        // Bit of the key in KPD_GetPressedKeys, or the switch of SWITCHES_tenu
+   u8 Key;          // Name of the key in KPD_ARRAY, the switch index for a switch
+}InputEvent_tstr;
+
+
+/********************************************************************************************************/
+/************************************************APIs****************************************************/
+/********************************************************************************************************/
+/**
+ * @brief Initializes the input service.
+ *
+ * Empties the queue and moves every consumer cursor to its head.
+ */
+void INPUT_Init(void);
+
+/**
+ * @brief Runnable of the input service.
+ *
+ * Takes the debounced edges of the keypad and of the switches and pushes a press or release event
+ * for each of them, then a long press event for the keys held INPUT_LONG_PRESS_MS and a repeat event
+ * every INPUT_REPEAT_MS after it. It must be the only writer of the queue.
+ */
+void INPUT_Runnable(void);
+
+/**
+ * @brief Gets the next event of a consumer.
+ *
+ * Each consumer reads the queue through its own cursor, so every consumer gets every event once.
+ * The queue is never locked, an event overwritten while it was copied is dropped and the next one is read.
+ *
+ * @param Copy_Consumer Consumer from InputConsumer_tenu.
+ * @param ADD_Event Pointer to the event read.
+ * @return tenu_ErrorStatus: LBTY_OK if an event is returned, LBTY_NOK if there is no new event,
+ *         LBTY_ErrorInvalidInput or LBTY_ErrorNullPointer for wrong parameters.
+ */
+tenu_ErrorStatus INPUT_GetEvent(u8 Copy_Consumer, InputEvent_tstr *ADD_Event);
+
+/**
+ * @brief Gets the number of events a consumer lost because it fell behind, and clears it.
+ *
+ * @param Copy_Consumer Consumer from InputConsumer_tenu.
+ * @param ADD_Lost Pointer to the number of lost events.
+ * @return tenu_ErrorStatus: LBTY_OK, or LBTY_ErrorInvalidInput or LBTY_ErrorNullPointer for wrong parameters.
+ */
+tenu_ErrorStatus INPUT_GetLostEvents(u8 Copy_Consumer, u32 *ADD_Lost);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SERVICE_INPUT_INPUT_CONFIG_H_
+#define SERVICE_INPUT_INPUT_CONFIG_H_
+
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+/* Number of events kept in the queue, must be a power of 2.
+ * A consumer that falls more than INPUT_QUEUE_SIZE-1 events behind loses the oldest ones */
+#define INPUT_QUEUE_SIZE            32
+/* Time a key is held before INPUT_EVENT_LONG_PRESS */
+#define INPUT_LONG_PRESS_MS         800
+/* Period of INPUT_EVENT_REPEAT after the long press, 0 disables the repeat */
+#define INPUT_REPEAT_MS             150
+/* Sources of the events
+ * Options:
+ *      1- INPUT_DISABLE
+ *      2- INPUT_ENABLE
+ * note: the service takes all the edges of an enabled source, KPD_GetTransitions and
+ *       HSWITCH_GetEdges must not be called by anyone else */
+#define INPUT_KPD                   INPUT_ENABLE
+#define INPUT_SWITCH                INPUT_ENABLE
+
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+/* Every consumer has its own read cursor, and sees each event once whatever the others read */
+typedef enum {
+    INPUT_CONSUMER_APP1=0,
+    INPUT_CONSUMER_APP2,
+    INPUT_CONSUMER_SENDER,
+
+
+    _INPUT_CONSUMER_NUM
+}InputConsumer_tenu;
+
+
+#endif
@@ -12,6 +12,9 @@
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
 #define TICK_TIME   1
+#define SCHED_DISABLE   0
+#define SCHED_ENABLE    1
+#define SCHED_NO_DELAY  0xFFFFFFFFUL
 
 
 /********************************************************************************************************/
@@ -28,6 +31,15 @@ typedef struct
 
 }Runnable_tstr;
 
+typedef struct
+{
+   u16 LoadPermille;       // Busy time of the last SCHED_LOAD_WINDOW_MS window, in 1/1000 of the time
+   u16 PeakLoadPermille;   // Highest window load since the start
+   u32 MissedTicks;        // Ticks that were still pending when the next one came
+   u32 ClockSwitches;      // Clock plans applied by the governor
+   u8  PlanIndex;          // Current index in SchedGovernorPlans[]
+}SchedStats_tstr;
+
 
 
 /********************************************************************************************************/
@@ -60,5 +72,32 @@ tenu_ErrorStatus StartSched(void);
  * @return tenu_ErrorStatus: Error status, LBTY_OK if successful, LBTY_NOK if an error occurs.
  */
 tenu_ErrorStatus Sched(void);
+/**
+ * @brief Sets the delay before the next call of a runnable.
+ *
+ * Called from the runnable itself, the delay replaces its periodicity for the next call only,
+ * so a runnable that knows when it has work again is not called in between.
+ *
+ * @param Copy_Runnable Runnable from RunnableName_tenu.
+ * @param Copy_DelayMs Delay in ms, from 1 to SCHED_NO_DELAY-1.
+ * @return tenu_ErrorStatus: LBTY_OK, LBTY_ErrorInvalidInput for a wrong runnable or delay.
+ */
+tenu_ErrorStatus Sched_SetNextDelay(u32 Copy_Runnable, u32 Copy_DelayMs);
+/**
+ * @brief Gets the load statistics of the scheduler.
+ *
+ * The busy time is measured with the SysTick counter around each run of Sched, so it does not depend
+ * on the clock frequency.
+ *
+ * @param ADD_Stats Pointer to the statistics.
+ * @return tenu_ErrorStatus: LBTY_OK, LBTY_ErrorNullPointer for a NULL pointer.
+ */
+tenu_ErrorStatus Sched_GetStats(SchedStats_tstr *ADD_Stats);
+/**
+ * @brief Gets the scheduler time.
+ *
+ * @return u32: milliseconds since StartSched, wraps after about 49 days so compare times by subtraction.
+ */
+u32 Sched_GetTimeMs(void);
 
 #endif
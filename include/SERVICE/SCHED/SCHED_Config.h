@@ -10,6 +10,21 @@
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
+/* Ticks over which the busy time of the scheduler is summed into one load value */
+#define SCHED_LOAD_WINDOW_MS        100
+/* Frequency governor, moves between the clock plans of SchedGovernorPlans[] following the load
+ * Options:
+ *      1- SCHED_DISABLE
+ *      2- SCHED_ENABLE     only when every driver in use follows the MRCC clock changes, SYSCLK then
+ *                          changes under USART, SysTick and the CLCD timing at run time */
+#define SCHED_GOVERNOR              SCHED_DISABLE
+/* Number of plans in SchedGovernorPlans[], from the slowest to the fastest */
+#define SCHED_GOV_PLANS_NUM         3
+/* A window above this load, or with a missed tick, goes to the fastest plan at once */
+#define SCHED_GOV_UP_PERMILLE       750
+/* One plan slower is taken when the load predicted for it stays below this for SCHED_GOV_DOWN_WINDOWS windows */
+#define SCHED_GOV_TARGET_PERMILLE   500
+#define SCHED_GOV_DOWN_WINDOWS      5
 
 
 
@@ -18,6 +33,8 @@
 /********************************************************************************************************/
 typedef enum {
     SW_Runnable=0,
+    KPDScan_Runnable,
+    InputEvents_Runnable,
     APP1_Runnable,
     APP2_Runnable,
 	TrafficLight_Runnable,
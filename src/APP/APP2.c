@@ -1,5 +1,5 @@
 #include "APP/APP2.h"
-#include "HKPD/KYD.h"
+#include "SERVICE/INPUT/INPUT.h"
 #include "MUSART/USART.h"
 
 USART_TXBuffer tx6_buff = 
@@ -11,17 +11,19 @@ USART_TXBuffer tx6_buff =
 
 void APP2_RunnableFunc(void)
 {
-    u8 Local_Key=0;
-   KPD_GetPressedKey(&Local_Key);
-    if(Local_Key!=0)
+    static u8 Local_Key=0;
+    InputEvent_tstr Local_Event;
+    /* one key per run, the zero copy buffer is still being sent from Local_Key */
+    while(INPUT_GetEvent(INPUT_CONSUMER_APP2,&Local_Event)==LBTY_OK)
     {
-         tx6_buff.Data=&Local_Key;
-        USART_SendBufferZeroCopy(&tx6_buff);
+        if((Local_Event.Source==INPUT_SOURCE_KPD)&&(Local_Event.Type==INPUT_EVENT_PRESS))
+        {
+            Local_Key=Local_Event.Key;
+            tx6_buff.Data=&Local_Key;
+            USART_SendBufferZeroCopy(&tx6_buff);
+            break;
+        }
     }
-    else
-    {
-        
-    } 
     
 
 }
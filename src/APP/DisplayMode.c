@@ -189,61 +189,28 @@ if(ReceiveType.Mode==NORMAL_MODE)
         
     }
     /*Diplay Date and Time*/
-    CLCD_ClearScreenAsynch();
-    CLCD_WriteStringAsynch("DATE:",5);
+    CLCD_ClearScreenAsynch(LCD_MAIN);
+    CLCD_WriteStringAsynch(LCD_MAIN,"DATE:",5);
     /*year*/
-    if((Date.Year<1000)&&(Date.Year>=100))
-    {
-        CLCD_WriteNumberAsynch(0);
-    }
-    else if((Date.Year<100)&&Date.Year>=10)
-    {
-        CLCD_WriteStringAsynch("00",2);        
-    }
-    else if(Date.Year<10)
-    {
-        CLCD_WriteStringAsynch("000",3);        
-    }    
-    CLCD_WriteNumberAsynch(Date.Year);
-    CLCD_WriteStringAsynch("/",1);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Date.Year,4,0,HLCD_PAD_ZERO);
+    CLCD_WriteStringAsynch(LCD_MAIN,"/",1);
     /*Month*/
-    if(Date.Month<10)
-    {
-        CLCD_WriteNumberAsynch(0);
-    }
-    CLCD_WriteNumberAsynch(Date.Month);
-    CLCD_WriteStringAsynch("/",1);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Date.Month,2,0,HLCD_PAD_ZERO);
+    CLCD_WriteStringAsynch(LCD_MAIN,"/",1);
     /*Day*/
-    if(Date.Day<10)
-    {
-        CLCD_WriteNumberAsynch(0);
-    }
-    
-    CLCD_WriteNumberAsynch(Date.Day);
-    CLCD_GoToXYAsynch(1,0);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Date.Day,2,0,HLCD_PAD_ZERO);
+    CLCD_GoToXYAsynch(LCD_MAIN,1,0);
     /*Time*/
-    CLCD_WriteStringAsynch("TIME:",5);
+    CLCD_WriteStringAsynch(LCD_MAIN,"TIME:",5);
     /*Hour*/
-    if(Time.Hour<10)
-    {
-       CLCD_WriteNumberAsynch(0); 
-    }
-    CLCD_WriteNumberAsynch(Time.Hour);
-    CLCD_WriteStringAsynch(":",1);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Time.Hour,2,0,HLCD_PAD_ZERO);
+    CLCD_WriteStringAsynch(LCD_MAIN,":",1);
     /*Minutes*/
-    if(Time.Minuts<10)
-    {
-        CLCD_WriteNumberAsynch(0);
-    }
-    CLCD_WriteNumberAsynch(Time.Minuts);
-    CLCD_WriteStringAsynch(":",1);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Time.Minuts,2,0,HLCD_PAD_ZERO);
+    CLCD_WriteStringAsynch(LCD_MAIN,":",1);
     /*Second*/
-    if(Time.Second<10)
-    {
-        CLCD_WriteNumberAsynch(0);
-    }
-    CLCD_WriteNumberAsynch(Time.Second);
-    CLCD_DisplaySpecialCharAsynch(1);
+    CLCD_WriteFormattedAsynch(LCD_MAIN,Time.Second,2,0,HLCD_PAD_ZERO);
+    CLCD_DisplaySpecialCharAsynch(LCD_MAIN,1);
     /******Check Edit Mode************/
     if(ReceiveType.NormalModeEdit==NORMAL_MODE_EDIT)
     {
@@ -269,7 +236,7 @@ void Diplay_EditHlp(void)
 {
     static u8 Local_RowLinePos=0;
     static u8 Local_ColLinePos=6;
-    CLCD_GoToXYAsynch(Local_RowLinePos,Local_ColLinePos);
+    CLCD_GoToXYAsynch(LCD_MAIN,Local_RowLinePos,Local_ColLinePos);
     switch (ReceiveType.NormalModeOperation)
     {
  
@@ -2,6 +2,7 @@
 /************************************************Includes************************************************/
 /********************************************************************************************************/
 #include "APP/Sender.h"
+#include "SERVICE/INPUT/INPUT.h"
 
 
 /* USART_TXBuffer tx1_buff = 
@@ -13,20 +14,16 @@
 
 void Sender_RunnableFunc(void)
 {
-    u8 Local_Key=0;
-   KPD_GetPressedKey(&Local_Key);
-    if(Local_Key!=0)
+    InputEvent_tstr Local_Event;
+    while(INPUT_GetEvent(INPUT_CONSUMER_SENDER,&Local_Event)==LBTY_OK)
     {
-        //tx1_buff.Data=&Local_Key;
-        USART_SendByteSynchByTime(USART1,Local_Key);
-       // USART_SendBufferZeroCopy(&tx1_buff);
-        Local_Key=0;
-        
+        if((Local_Event.Source==INPUT_SOURCE_KPD)&&(Local_Event.Type==INPUT_EVENT_PRESS))
+        {
+            //tx1_buff.Data=&Local_Key;
+            USART_SendByteSynchByTime(USART1,Local_Event.Key);
+           // USART_SendBufferZeroCopy(&tx1_buff);
+        }
     }
-    else
-    {
-        
-    } 
     
 
 }
@@ -21,6 +21,7 @@ void Stopwatch_Runnable(void)
     
     static u8 Stopwatch_On=0;
     static Stopwatch_Time SW_Time={0,0,0,0};
+    static u8 Stopwatch_Shown=0;
 
     if( (ReceiveType.Mode == STOP_WATCH_MODE))
     {
@@ -65,18 +66,28 @@ void Stopwatch_Runnable(void)
 
     if( (ReceiveType.Mode == STOP_WATCH_MODE))
     {
-        CLCD_ClearScreenAsynch();
-        CLCD_WriteStringAsynch("Stopwatch:", 10);
-        CLCD_GoToXYAsynch(1,0);
-        CLCD_WriteNumberAsynch(SW_Time.Hrs);
-        CLCD_WriteStringAsynch(":",1);
-        CLCD_WriteNumberAsynch(SW_Time.Mins);
-        CLCD_WriteStringAsynch(":",1);
-        CLCD_WriteNumberAsynch(SW_Time.Secs);
-        CLCD_WriteStringAsynch(":",1);
-        CLCD_WriteNumberAsynch(SW_Time.Ms);
+        if(Stopwatch_Shown==0)
+        {
+            /* the screen was drawn by another mode through the request queue, blank it and the frame */
+            CLCD_ClearScreenAsynch(LCD_MAIN);
+            Stopwatch_Shown=1;
+        }
+        /* HH:MM:SS:mmm, fixed width so every period rewrites the same cells,
+           only the cells that changed since the last period are sent to the LCD */
+        CLCD_FrameWriteString(LCD_MAIN,0,0,"Stopwatch:",10);
+        CLCD_FrameWriteFormatted(LCD_MAIN,1,0,SW_Time.Hrs,2,0,HLCD_PAD_ZERO);
+        CLCD_FrameWriteString(LCD_MAIN,1,2,":",1);
+        CLCD_FrameWriteFormatted(LCD_MAIN,1,3,SW_Time.Mins,2,0,HLCD_PAD_ZERO);
+        CLCD_FrameWriteString(LCD_MAIN,1,5,":",1);
+        CLCD_FrameWriteFormatted(LCD_MAIN,1,6,SW_Time.Secs,2,0,HLCD_PAD_ZERO);
+        CLCD_FrameWriteString(LCD_MAIN,1,8,":",1);
+        CLCD_FrameWriteFormatted(LCD_MAIN,1,9,SW_Time.Ms,3,0,HLCD_PAD_ZERO);
             
     }
+    else
+    {
+        Stopwatch_Shown=0;
+    }
     
 
-}
\ No newline at end of file
+}
@@ -3,29 +3,40 @@
 /********************************************************************************************************/
 #include "Traffic_Light.h"
 #include "HLED/LED.h"
+#include "SERVICE/SCHED/SCHED.h"
 
 
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
-#define PERIODICITY_SEC   2000
+#define TRAFFIC_LEDS      (LED_BIT(LED_GREEN)|LED_BIT(LED_YELLOW)|LED_BIT(LED_RED))
+#define TRAFFIC_TRACK     0
 
 
 /********************************************************************************************************/
 /************************************************Types***************************************************/
 /********************************************************************************************************/
-typedef enum{
-    GREEN=0,
-    YELLOW,
-    RED,
-}State_tenu; 
+
 
 
 /********************************************************************************************************/
 /************************************************Variables***********************************************/
 /********************************************************************************************************/
-State_tenu State = GREEN;
-static u8 Prev_State ;
+/* green 6 s, yellow 2 s, red 4 s, yellow 2 s, forever */
+static const LEDSeqStep_tstr TrafficSteps[]={
+    {.Frame=LED_BIT(LED_GREEN),.DurationMs=6000},
+    {.Frame=LED_BIT(LED_YELLOW),.DurationMs=2000},
+    {.Frame=LED_BIT(LED_RED),.DurationMs=4000},
+    {.Frame=LED_BIT(LED_YELLOW),.DurationMs=2000},
+};
+static const LEDPattern_tstr TrafficPattern={
+    .Mask=TRAFFIC_LEDS,
+    .Steps=TrafficSteps,
+    .StepsNum=sizeof(TrafficSteps)/sizeof(TrafficSteps[0]),
+    .Loops=0,
+    .Next=NULL,
+};
+static u8 Started=0;
 
 
 /********************************************************************************************************/
@@ -37,57 +48,18 @@ static u8 Prev_State ;
 /********************************************************************************************************/
 /*********************************************APIs Implementation****************************************/
 /********************************************************************************************************/
+/* The runnable is only called when a light changes, the sequencer gives the delay to the next change */
 void TrafficLights(void)
 {
-    static u32 Local_Sec;
-    Local_Sec+=PERIODICITY_SEC;
-    switch (State)
+    u32 Local_DelayMs;
+    if(!Started)
     {
-    case GREEN:
-    	HLED_SetStatus(LED_GREEN,LED_ON);
-    	HLED_SetStatus(LED_YELLOW,LED_OFF);
-    	HLED_SetStatus(LED_RED,LED_OFF);
-        if(Local_Sec==6000)
-        {
-        	Local_Sec=0;
-            State = YELLOW;
-            Prev_State= GREEN;
-
-        }
-        break;
-        
-    case YELLOW:
-    	HLED_SetStatus(LED_GREEN,LED_OFF);
-    	HLED_SetStatus(LED_YELLOW,LED_ON);
-    	HLED_SetStatus(LED_RED,LED_OFF);
-        if(Local_Sec==2000&&Prev_State==GREEN)
-        {
-        	Local_Sec=0;
-            State = RED;
-        }
-        else if(Local_Sec==2000&&Prev_State==RED)
-        {
-        	Local_Sec=0;
-            State = GREEN;
-        }
-        
-        break; 
-    case RED:
-    	HLED_SetStatus(LED_GREEN,LED_OFF);
-    	HLED_SetStatus(LED_YELLOW,LED_OFF);
-    	HLED_SetStatus(LED_RED,LED_ON);
-        if(Local_Sec==4000)
-        {
-        	Local_Sec=0;
-            State = YELLOW;
-            Prev_State= RED;
-        }
-        
-        break;            
-    
-    default:
-        break;
+        HLED_SeqPlay(TRAFFIC_TRACK,&TrafficPattern);
+        Started=1;
+    }
+    Local_DelayMs=HLED_SeqUpdate(Sched_GetTimeMs());
+    if(Local_DelayMs!=LED_SEQ_IDLE)
+    {
+        Sched_SetNextDelay(TrafficLight_Runnable,Local_DelayMs);
     }
-
 }
-
@@ -1,5 +1,6 @@
 #include "STD_TYPES.h"
 #include "MRCC/RCC.h"
+#include "MNVIC/MNVIC.h"
 #include "HLED/LED.h"
 
 #include "FreeRTOS.h"
@@ -8,41 +9,48 @@
 
 #define FREERTOS                1
 
-// Define the periods for each task in milliseconds
-#define TASK1_PERIOD 2000
-#define TASK2_PERIOD 3000
-#define TASK3_PERIOD 5000
+// Blink periods of the LEDs in milliseconds, each LED toggles once per period
+#define LED1_PERIOD 2000
+#define LED2_PERIOD 3000
+#define LED3_PERIOD 5000
 
 
 #if FREERTOS
 // Function prototypes for tasks
-void vTask1(void *pvParameters);
-void vTask2(void *pvParameters);
-void vTask3(void *pvParameters);
+void vLedTask(void *pvParameters);
+static void vLedWake(void);
+
+static TaskHandle_t xLedTaskHandle;
+
+// One pattern per LED, on for a period then off for a period, played on its own sequencer track
+static const LEDSeqStep_tstr Led1Steps[]={{.Frame=LED_BIT(LED_GREEN),.DurationMs=LED1_PERIOD},{.Frame=0,.DurationMs=LED1_PERIOD}};
+static const LEDSeqStep_tstr Led2Steps[]={{.Frame=LED_BIT(LED_YELLOW),.DurationMs=LED2_PERIOD},{.Frame=0,.DurationMs=LED2_PERIOD}};
+static const LEDSeqStep_tstr Led3Steps[]={{.Frame=LED_BIT(LED_RED),.DurationMs=LED3_PERIOD},{.Frame=0,.DurationMs=LED3_PERIOD}};
+static const LEDPattern_tstr LedPatterns[]={
+    {.Mask=LED_BIT(LED_GREEN),.Steps=Led1Steps,.StepsNum=2,.Loops=0,.Next=NULL},
+    {.Mask=LED_BIT(LED_YELLOW),.Steps=Led2Steps,.StepsNum=2,.Loops=0,.Next=NULL},
+    {.Mask=LED_BIT(LED_RED),.Steps=Led3Steps,.StepsNum=2,.Loops=0,.Next=NULL},
+};
 
 
 // Entry point
 int main(void) {
-  /// enable GPIOB periph clock for led and UART TX & RX
-
-	MRCC_ControlClockAHP1Peripheral(RCC_AHB1_GPIOA,RCC_ENABLE);
-	MRCC_ControlClockAHP1Peripheral(RCC_AHB1_GPIOB,RCC_ENABLE);
+    // run at 84 MHz from the HSI PLL, SystemCoreClock follows for the FreeRTOS tick
+    MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ]);
+    // interrupt priorities of MNVIC_Config.c, before any interrupt is enabled
+    MNVIC_Init();
+    // the GPIO port clocks are acquired by MGPIO_InitPin for the pins in use
 
 	 //LED INIT
     HLED_Init();
+    for (u8 idx = 0; idx < sizeof(LedPatterns)/sizeof(LedPatterns[0]); idx++) {
+        HLED_SeqPlay(idx, &LedPatterns[idx]);
+    }
 
 
-    // Create task handles
-    TaskHandle_t xTask1Handle, xTask2Handle, xTask3Handle;
-
-    // Create task 1
-    xTaskCreate(vTask1, "Task 1", configMINIMAL_STACK_SIZE, NULL, 3, &xTask1Handle);
-
-    // Create task 2
-    xTaskCreate(vTask2, "Task 2", configMINIMAL_STACK_SIZE, NULL, 2 , &xTask2Handle);
-
-    // Create task 3
-    xTaskCreate(vTask3, "Task 3", configMINIMAL_STACK_SIZE, NULL, 1 , &xTask3Handle);
+    // Create the task that plays all the LED patterns, a new pattern wakes it up
+    xTaskCreate(vLedTask, "LED Task", configMINIMAL_STACK_SIZE, NULL, 1, &xLedTaskHandle);
+    HLED_SeqSetWakeCallBack(vLedWake);
 
     // Start the scheduler
     vTaskStartScheduler();
@@ -52,38 +60,19 @@ int main(void) {
     return 0;
 }
 
-// Task 1 - Toggle RED LED every 2 seconds
-void vTask1(void *pvParameters) {
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xPeriod = pdMS_TO_TICKS(TASK1_PERIOD);
+// LED task - shows the steps that are due and sleeps until the next one of any LED or a new pattern
+void vLedTask(void *pvParameters) {
+    u32 ulDelayMs;
     for (;;) {
-        // Toggle LED here
-    	HLED_Toggle(LED_GREEN);
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
+        ulDelayMs = HLED_SeqUpdate(xTaskGetTickCount() * portTICK_PERIOD_MS);
+        // a pattern played while the steps were updated left a notification, the take returns at once
+        ulTaskNotifyTake(pdTRUE, (ulDelayMs == LED_SEQ_IDLE) ? portMAX_DELAY : pdMS_TO_TICKS(ulDelayMs));
     }
 }
 
-// Task 2 - Toggle GREEN LED every 4 seconds
-void vTask2(void *pvParameters) {
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xPeriod = pdMS_TO_TICKS(TASK2_PERIOD);
-    for (;;) {
-        // Toggle LED here
-    	HLED_Toggle(LED_YELLOW);
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
-    }
-}
-
-// Task 3 - Toggle YELLOW LED every 6 seconds
-void vTask3(void *pvParameters) {
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xPeriod = pdMS_TO_TICKS(TASK3_PERIOD);
-    for (;;) {
-        // Toggle LED here
-      
-        HLED_Toggle(LED_RED);
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
-    }
+// Called by HLED_SeqPlay from the task that plays a pattern
+static void vLedWake(void) {
+    xTaskNotifyGive(xLedTaskHandle);
 }
 
 
@@ -12,6 +12,7 @@
 #include "STD_TYPES.h"
 #include "HCLCD/LCD.h"
 #include "MGPIO/GPIO.h"
+#include "MRCC/RCC.h"
 #include <string.h> // for strcpy
 #include<stdlib.h>
 
@@ -28,13 +29,50 @@
 #define SECOND_LINE         1 // Define second line number
 #define DISPLAY_CLEAR       0X01 // Define command for clearing display
 #define CLCD_NUMBER_OF_CGRAM_BYTES  8 
+#define CLCD_NUMBER_OF_CGRAM_BLOCKS 8
+#define CLCD_GLYPH_HASH_BASIS       2166136261UL // FNV-1a offset basis
+#define CLCD_GLYPH_HASH_PRIME       16777619UL   // FNV-1a prime
+#define CLCD_GLYPH_SLOTS            (CLCD_NUMBER_OF_CGRAM_BLOCKS-HLCD_GLYPH_FIRST_BLOCK)
+#if (HLCD_GLYPH_FIRST_BLOCK < 0) || (HLCD_GLYPH_FIRST_BLOCK >= CLCD_NUMBER_OF_CGRAM_BLOCKS)
+#error HLCD_GLYPH_FIRST_BLOCK must leave at least one CGRAM block to the glyph cache
+#endif
 #define CLCD_SET_CGR_ADDRESS        64 
 #define CLCD_FIRST_PART             0
-#define CLCD_FIRST_PART_SEND        1
 #define CLCD_SECOND_PART            2
 #define CLCD_FIRST_SECOND_PART      3 
+#define CLCD_SECOND_LINE_ADDRESS    0x40 // DDRAM address of the first cell of the second line
+#define CLCD_FRAME_NO_CURSOR        0xFF // The address counter doesn't point to a frame cell
+#define CLCD_NIBBLE_VALUES          16
+#define CLCD_NIBBLE_BITS            4
+#define CLCD_NIBBLE_MASK            0x0F
+#define CLCD_DIV10_RECIPROCAL       0xCCCCCCCDULL // ceil(2^35/10), exact n/10 for any u32 after the shift
+#define CLCD_DIV10_SHIFT            35
+#define CLCD_MAX_DIGITS             10 // Digits of the biggest u32
+#define CLCD_MAX_DECIMALS           9
+#define CLCD_FORMAT_MAX_LEN         (CLCD_MAX_DIGITS+2) // Digits, sign and decimal point
+#if LCD_BURST_SIZE < CLCD_FORMAT_MAX_LEN
+/* CLCD_WriteFormattedAsynch queues its text with CLCD_QueueCopy, the longest number must fit in one Burst */
+#error LCD_BURST_SIZE must hold the longest number, CLCD_FORMAT_MAX_LEN characters
+#endif
+#define CLCD_NS_PER_SECOND          1000000000ULL
+#if (HLCD_E_CYCLE_NS < HLCD_E_PULSE_NS) || (HLCD_E_CYCLE_NS > 2*HLCD_E_PULSE_NS) || (HLCD_DELAY_LOOP_CYCLES == 0)
+/* In busy flag mode a display that lowers E while another raises it only waits the pulse delay before its next rising edge */
+#error HLCD_E_CYCLE_NS must be between HLCD_E_PULSE_NS and twice HLCD_E_PULSE_NS, HLCD_DELAY_LOOP_CYCLES must not be 0
+#endif
+/* 8-bit with fixed ticks spaces the Enable edges by whole ticks, the busy waits are only needed by the
+   4-bit high nibble and the busy flag rounds */
+#define CLCD_BUSY_WAITS             ((HLCD_MODE == HLCD_MODE_4_BIT) || (HLCD_TIMING == HLCD_TIMING_BUSY_FLAG))
+
 
 
+#if HLCD_STATS == HLCD_ENABLE
+#define CLCD_STAT_ADD(DISPLAY,FIELD,N)   ((DISPLAY)->Stats.FIELD+=(N))
+#else
+#define CLCD_STAT_ADD(DISPLAY,FIELD,N)
+#endif
+// The display has a request, a frame cell or an Enable phase to finish
+#define CLCD_HAS_WORK(DISPLAY)          (((DISPLAY)->QueueCount!=0)||((DISPLAY)->FrameOp!=CLCD_FrameNoOp)||((DISPLAY)->EnablePin==ENABLE)||\
+                                        (((DISPLAY)->FrameDirty[FIRST_LINE]|(DISPLAY)->FrameDirty[SECOND_LINE])!=0))
 
 #define CONCAT_HELPER(B7,B6,B5,B4,B3,B2,B1,B0)          0b##B7##B6##B5##B4##B3##B2##B1##B0
 #define CONCAT(B7,B6,B5,B4,B3,B2,B1,B0)                 CONCAT_HELPER(B7,B6,B5,B4,B3,B2,B1,B0)
@@ -83,7 +121,6 @@ typedef enum  // Define user request types
 {
     NOReq,
     WriteReq,
-	WriteNumReq,
     WriteSpecialChar,
     DisplaySpecialChar,
     ClearReq,
@@ -98,12 +135,6 @@ typedef enum  // Define user request states
     CLCD_Busy
 }CLCD_UserReqState_tenu;
 
-typedef enum  // Define buffer state
-{
-    NotBuffered,
-    Buffered,
-}CLCD_BufferState_tenu;
-
 typedef enum  // Define write state
 {
     CLCD_ReqStart,
@@ -118,13 +149,27 @@ typedef struct  // Define user request structure
     char *Str;
     u8 Len;
     u8 Command;
-    s32 Number;
     u8 CGRAMBlockNumber;
     CLCD_UserReqType_tenu Type;
     CLCD_WriteState_tenu  State;
-    CLCD_BufferState_tenu BufferState;
+    char Burst[LCD_BURST_SIZE]; // Copy of coalesced write requests
 }CLCD_UserReq_tstr;
 
+typedef enum  // Define the transfer in progress for the shadow frame
+{
+    CLCD_FrameNoOp,
+    CLCD_FrameSetAddress,
+    CLCD_FrameWriteChar
+}CLCD_FrameOp_tenu;
+
+typedef struct  // Define a CGRAM block owned by the glyph cache
+{
+    u32  Hash; // FNV-1a of the pattern, checked before comparing the bytes
+    u16  LastUse; // Value of GlyphClock at the last hit, the smallest one is evicted
+    u8   Valid;
+    char Pattern[CLCD_NUMBER_OF_CGRAM_BYTES]; // Copy of the glyph, also the source of its upload
+}CLCD_Glyph_tstr;
+
 typedef struct  // Define write structure
 {
     u8 CurrPos;
@@ -133,21 +178,50 @@ typedef struct  // Define write structure
     u8 CLCD_PositionY; // Initialize Y position
 }CLCD_Write_tstr;
 
-
+typedef struct  // Define the context of one display, everything CLCD_TASK needs to drive it
+{
+    const LCD_cfg_t * Cfg; // Pins of the display
+    CLCD_States_tenu  State; // CLCD state
+    CLCD_InitStates_tenu InitState; // Step of the init sequence
+    u8 InitCounter; // Ticks waited in the init sequence
+    CLCD_UserReq_tstr UserReq[LCD_BUFFERSIZE]; // FIFO ring of user requests, free slots have Type NOReq
+    CLCD_Write_tstr   UserWriteReq[LCD_BUFFERSIZE]; // Define array for write requests
+    u8 EnablePin; // Enable pin status
+    u8 Iter; // Iteration counter
+    u8 CurrentBuffer; // Head of the ring, request being served
+    u8 QueueTail; // Next free slot of the ring
+    u8 QueueCount; // Number of requests in the ring
+    u8 PartCount;
+    char Frame[HLCD_FRAME_LINES][HLCD_FRAME_COLUMNS]; // Shadow of the characters the user wants on the screen
+    u16  FrameDirty[HLCD_FRAME_LINES]; // Bit per column, set when the cell differs from the LCD
+    u8   FrameCursor; // Cell (line*columns+column) the DDRAM address counter points to
+    u8   FrameCell; // Cell being transferred
+    char FrameSentChar; // Character being transferred
+    CLCD_FrameOp_tenu FrameOp; // Transfer in progress for the frame
+    void * BusPort; // Port shared by all the data pins, NULL when they are spread over several ports
+    u16 BusMask; // Data pins of BusPort, plus RS/RW when they are on the same port
+    u16 BusDataMask; // Data pins of BusPort
+    u16 BusRSMask; // RS pin when it is on BusPort, 0 otherwise
+    u16 BusRWMask; // RW pin when it is on BusPort, 0 otherwise
+    u16 BusLowTable[CLCD_NIBBLE_VALUES]; // Pins to set for each value of the low nibble (data pins 0..3)
+#if HLCD_MODE == HLCD_MODE_8_BIT
+    u16 BusHighTable[CLCD_NIBBLE_VALUES]; // Pins to set for each value of the high nibble (data pins 4..7)
+#endif
+    CLCD_Glyph_tstr Glyphs[CLCD_GLYPH_SLOTS]; // Glyph cache, entry i is CGRAM block HLCD_GLYPH_FIRST_BLOCK+i
+    u16 GlyphClock; // Incremented at each cache lookup
+#if HLCD_STATS == HLCD_ENABLE
+    CLCD_Stats_tstr Stats; // Throughput counters
+#endif
+}CLCD_Display_tstr;
 
 
 /********************************************************************************************************/
 /************************************************Variables***********************************************/
 /********************************************************************************************************/
-extern LCD_cfg_t HLCD; // Declare LCD configuration structure
-static CLCD_States_tenu  G_CLCD_State = CLCD_OFF; // Initialize CLCD state
-static CLCD_UserReq_tstr G_UserReq[LCD_BUFFERSIZE]; // Define array for user requests
-static CLCD_Write_tstr   G_UserWriteReq[LCD_BUFFERSIZE]; // Define array for write requests
-static u8 CLCD_EnablePin = DISABLE; // Initialize enable pin status
-static u8 CLCD_ITER     =0; // Initialize iteration counter
-static u8 CLCD_CurrentBuffer   = 0; // Initialize current buffer index
-static u8 CLCD_BufferIndex     = 0; // Initialize buffer index
-static u8 CLCD_PartCount=0;
+extern LCD_cfg_t HLCD[_LCD_NUM]; // Declare LCD configuration structures
+static CLCD_Display_tstr CLCD_Displays[_LCD_NUM]; // One context per display, all served by CLCD_TASK
+static u32 CLCD_PulseLoops; // Busy loop iterations of HLCD_E_PULSE_NS at the current HCLK
+static u32 CLCD_LowLoops;   // Busy loop iterations of HLCD_E_CYCLE_NS-HLCD_E_PULSE_NS at the current HCLK
 
 
 /********************************************************************************************************/
@@ -163,7 +237,7 @@ static u8 CLCD_PartCount=0;
  *
  * @return None
  */
-static void CLCD_InitSM(void);
+static void CLCD_InitSM(CLCD_Display_tstr * Add_pDisplay);
 /**
  * @brief This function sends a command to the LCD.
  *
@@ -174,7 +248,36 @@ static void CLCD_InitSM(void);
  *
  * @return None
  */
-static void CLCD_SendCommandProcess(u8 Copy_Command);
+static void CLCD_SendCommandProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Command);
+/**
+ * @brief Precomputes the single store bus write when all the data pins share a port.
+ *
+ * Builds the set masks of the data pins for every nibble value, so a byte is turned into its BSRR
+ * value with two table reads. RS and RW are folded into the same store when they are on that port.
+ *
+ * @return None
+ */
+static void CLCD_BusInit(CLCD_Display_tstr * Add_pDisplay);
+/**
+ * @brief Drives RS, RW (write) and the data pins with one value.
+ *
+ * One BSRR store when CLCD_BusInit found a common port, one pin write per line otherwise.
+ *
+ * @param Copy_Value: Byte (8-bit mode) or nibble in the low bits (4-bit mode) to put on the data pins.
+ * @param Copy_RS: GPIO_Low for a command, GPIO_High for data.
+ *
+ * @return None
+ */
+static void CLCD_WriteBus(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Value , u8 Copy_RS);
+/**
+ * @brief Puts a byte (8-bit mode) or its next nibble (4-bit mode) on the bus and updates CLCD_PartCount.
+ *
+ * @param Copy_Byte: The byte to be sent.
+ * @param Copy_RS: GPIO_Low for a command, GPIO_High for data.
+ *
+ * @return None
+ */
+static void CLCD_WriteByteProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Byte , u8 Copy_RS);
 /**
  * @brief This function controls the enable pin of the LCD.
  *
@@ -185,7 +288,7 @@ static void CLCD_SendCommandProcess(u8 Copy_Command);
  *
  * @return None
  */
-static void CLCD_ControlEnablePin(u8 Copy_Pinstatus);
+static void CLCD_ControlEnablePin(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Pinstatus);
 /**
  * @brief Processes the request to set cursor position on the LCD.
  *
@@ -194,7 +297,7 @@ static void CLCD_ControlEnablePin(u8 Copy_Pinstatus);
  *
  * @return None
  */
-static void CLCD_GoToXYProcess(void); 
+static void CLCD_GoToXYProcess(CLCD_Display_tstr * Add_pDisplay); 
 /**
  * @brief Writes a character to the LCD.
  *
@@ -205,7 +308,7 @@ static void CLCD_GoToXYProcess(void);
  *
  * @return None
  */
-static void CLCD_WriteCharProcess(u8 Copy_Char);
+static void CLCD_WriteCharProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Char);
 /**
  * @brief Helper function to send a command to the LCD.
  *
@@ -216,7 +319,7 @@ static void CLCD_WriteCharProcess(u8 Copy_Char);
  *
  * @return None
  */
-static void CLCD_SendCommandHlp(u8 Copy_Command);
+static void CLCD_SendCommandHlp(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Command);
 /**
  * @brief This function processes the write request for the LCD.
  *
@@ -225,48 +328,135 @@ static void CLCD_SendCommandHlp(u8 Copy_Command);
  *
  * @return None
  */
-static void CLCD_WriteProcess(void);
+static void CLCD_WriteProcess(CLCD_Display_tstr * Add_pDisplay);
 /**
- * @brief Writes a number to the LCD asynchronously.
- * 
- * This function writes a number to the LCD display asynchronously. It first reverses the number
- * and then writes each digit to the display. It handles cases when the number is 0 and disables
- * the LCD after completion.
- * 
- * @details
- * The function starts by initializing a static variable `Local_Reversed` to 1. It then checks the
- * state of the LCD write request. If the state is `CLCD_ReqStart`, it checks if the number to be
- * written is 0. If it is, the function writes '0' to the LCD, enables the LCD, sets the enable
- * pin high, and updates the request type and state. If the number is not 0, it moves to the
- * in-progress state.
- * 
- * In the in-progress state (`CLCD_ReqInprogress`), the function reverses the number using a while
- * loop and writes each digit to the LCD. It checks if the reversed number is not 1, and if so,
- * it writes each digit to the LCD, enables the LCD, and sets the enable pin high. Once the
- * writing is complete, it updates the request type and state, disables the LCD, and sets the
- * enable pin low.
- * 
- * @note This function assumes that the LCD control pins and the LCD write character process
- * functions (`CLCD_ControlEnablePin` and `CLCD_WriteCharProcess`) are defined elsewhere.
+ * @brief Renders a fixed-point number into a buffer without any division.
+ *
+ * Digits are extracted with a multiply by the reciprocal of 10 (n/10 == (n*0xCCCCCCCD)>>35 for any u32),
+ * the value is right aligned on Copy_Width characters and Copy_Decimals digits go after the point.
+ *
+ * @param Add_pBuffer: Buffer of at least CLCD_FORMAT_MAX_LEN characters (or Copy_Width if bigger).
+ * @param Copy_Number: The number, e.g. 1234 with 2 decimals is shown as 12.34.
+ * @param Copy_Width: Minimum number of characters, 0 for no padding.
+ * @param Copy_Decimals: Digits after the decimal point, 0 for an integer.
+ * @param Copy_Pad: HLCD_PAD_SPACE or HLCD_PAD_ZERO (zeros go after the sign).
+ *
+ * @return u8 Number of characters written.
  */
-static void CLCD_WriteNumProcess(void);
+static u8 CLCD_FormatNumber(char * Add_pBuffer , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad);
+/**
+ * @brief Queues a copy of the characters as a write request, appended to the last write when possible.
+ *
+ * @return tenu_ErrorStatus LBTY_OK or LBTY_Busy if the queue is full.
+ */
+static tenu_ErrorStatus CLCD_QueueCopy(CLCD_Display_tstr * Add_pDisplay , const char * Add_pStr , u8 Copy_len);
 /**
  * @brief Processes the write special character request for the LCD.
  * 
  * This function processes the write special character request for the LCD based on the current state.
  */
-static void CLCD_WriteSpecialCharProcess(void);
+static void CLCD_WriteSpecialCharProcess(CLCD_Display_tstr * Add_pDisplay);
+/**
+ * @brief Hashes the 8 bytes of a glyph pattern (FNV-1a).
+ *
+ * @return u32 The hash.
+ */
+static u32 CLCD_GlyphHash(const char * Add_Pattern);
+/**
+ * @brief Forgets the cached glyph of a CGRAM block rewritten outside the cache.
+ */
+static void CLCD_GlyphInvalidate(CLCD_Display_tstr * Add_pDisplay , u8 Copy_CGRAMBlockNumber);
+/**
+ * @brief Reserves the slot at the tail of the request ring.
+ *
+ * The slot is filled by the caller and only becomes visible to CLCD_TASK after CLCD_CommitReq.
+ *
+ * @return u8 The slot index or LCD_BUFFERSIZE if the ring is full.
+ */
+static u8 CLCD_ReserveReq(CLCD_Display_tstr * Add_pDisplay);
+/**
+ * @brief Publishes the slot returned by CLCD_ReserveReq, the request is served after all the older ones.
+ */
+static void CLCD_CommitReq(CLCD_Display_tstr * Add_pDisplay);
+/**
+ * @brief Appends a string to the last queued write request if it hasn't started yet.
+ *
+ * Two write requests queued one after the other are contiguous on the LCD (the address counter just
+ * moves on), so they are merged into one burst in the Burst copy of the request.
+ *
+ * @return u8 1 if the string was merged, 0 if it has to be queued on its own.
+ */
+static u8 CLCD_CoalesceWrite(CLCD_Display_tstr * Add_pDisplay , const char * Add_pStr , u8 Copy_len);
+/**
+ * @brief Pushes one dirty cell of the shadow frame to the LCD.
+ *
+ * Runs only while the request queue is idle. Each call either starts a transfer (DDRAM address command
+ * when the address counter isn't on the next dirty cell, otherwise the character itself) or finishes it.
+ * A cell is cleaned only if it wasn't rewritten during its own transfer.
+ */
+static void CLCD_FrameFlushProcess(CLCD_Display_tstr * Add_pDisplay);
+/**
+ * @brief Finds the next dirty cell, starting at the address counter so that runs are written back to back.
+ *
+ * @return u8 The cell index or CLCD_FRAME_NO_CURSOR if the frame is clean.
+ */
+static u8 CLCD_FrameNextDirtyCell(CLCD_Display_tstr * Add_pDisplay);
 
 /**
- * @brief Main LCD task.
+ * @brief Returns the context of a display.
  *
- * This function serves as the main task for the LCD module. It processes various user requests
- * asynchronously, such as writing to the LCD, clearing the display, sending commands, and setting
- * cursor positions.
+ * @return CLCD_Display_tstr* The context or NULL if Copy_Display isn't a configured display.
+ */
+static CLCD_Display_tstr * CLCD_GetDisplay(u8 Copy_Display);
+/**
+ * @brief Sets up the pins and the context of one display and starts its init sequence.
+ *
+ * @return None
+ */
+static void CLCD_InitDisplay(CLCD_Display_tstr * Add_pDisplay , const LCD_cfg_t * Add_pCfg);
+/**
+ * @brief Runs one step of the request state machine: one Enable phase of the frame flush or of the request at the head of the queue.
+ *
+ * @return None
+ */
+static void CLCD_ProcessStep(CLCD_Display_tstr * Add_pDisplay);
+#if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+/**
+ * @brief Reads the busy flag of the controller.
+ *
+ * Switches the data pins to input, reads D7 with RS low and RW high (two Enable pulses in 4-bit mode),
+ * then puts the bus back in write mode.
+ *
+ * @return u8 ENABLE while the controller is busy, DISABLE when it accepts the next byte.
+ */
+static u8 CLCD_ReadBusyFlag(CLCD_Display_tstr * Add_pDisplay);
+#endif
+#if CLCD_BUSY_WAITS
+/**
+ * @brief Busy wait covering the minimum Enable pulse width and data delay of the controller.
+ *
+ * @return None
+ */
+static void CLCD_PulseDelay(void);
+/**
+ * @brief Busy wait keeping E low long enough to respect the Enable cycle time before the next rising edge.
+ *
+ * @return None
+ */
+static void CLCD_CycleDelay(void);
+#endif
+/**
+ * @brief Clock change subscriber, converts the Enable timings to busy loop iterations at the new HCLK.
  *
  * @return None
  */
-void CLCD_TASK(void);
+static void CLCD_ClockChanged(void);
+/**
+ * @brief Busy loop iterations covering Copy_Ns nanoseconds at Copy_HclkHz, rounded up.
+ *
+ * @return u32 The number of iterations.
+ */
+static u32 CLCD_NsToLoops(u32 Copy_Ns , u32 Copy_HclkHz);
 
 /********************************************************************************************************/
 /*********************************************APIs Implementation****************************************/
@@ -275,42 +465,122 @@ void CLCD_TASK(void);
 
 void CLCD_TASK(void)
 {
-    if (G_CLCD_State==CLCD_Init_state) // Check if LCD is in initialization state
+    u8 idx=0;
+    CLCD_Display_tstr * Local_pDisplay=NULL;
+    #if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+    u8 Local_Steps=0;
+    u8 Local_Active=0;
+    u8 Local_PulseHigh=0;
+    #endif
+    for(idx=0 ; idx<_LCD_NUM ; idx++) // The init sequences run one phase per tick on every display
+    {
+        CLCD_STAT_ADD(&CLCD_Displays[idx],Ticks,1);
+        if((CLCD_Displays[idx].State==CLCD_Operatinal)&&CLCD_HAS_WORK(&CLCD_Displays[idx]))
+        {
+            CLCD_STAT_ADD(&CLCD_Displays[idx],ActiveTicks,1);
+        }
+        if (CLCD_Displays[idx].State==CLCD_Init_state) // Check if LCD is in initialization state
+        {
+            CLCD_InitSM(&CLCD_Displays[idx]); // Initialize LCD
+        }
+    }
+    #if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+    /* Round robin, one Enable phase per ready display per round: the E pulses of all the displays are high
+       together and share a single pulse delay, so N displays move N bytes in the time of one */
+    for(Local_Steps=0 ; Local_Steps<HLCD_BF_STEPS_PER_TICK ; Local_Steps++)
     {
-        CLCD_InitSM(); // Initialize LCD
+        Local_Active=0;
+        Local_PulseHigh=0;
+        for(idx=0 ; idx<_LCD_NUM ; idx++)
+        {
+            Local_pDisplay=&CLCD_Displays[idx];
+            if (Local_pDisplay->State!=CLCD_Operatinal) // Check if LCD is in operational state
+            {
+                continue;
+            }
+            if(Local_pDisplay->EnablePin==DISABLE) // About to start a new byte
+            {
+                if((Local_pDisplay->QueueCount==0)&&(Local_pDisplay->FrameOp==CLCD_FrameNoOp)&&((Local_pDisplay->FrameDirty[FIRST_LINE]|Local_pDisplay->FrameDirty[SECOND_LINE])==0))
+                {
+                    continue; // Nothing to send
+                }
+                if(CLCD_ReadBusyFlag(Local_pDisplay)==ENABLE)
+                {
+                    CLCD_STAT_ADD(Local_pDisplay,BusyPolls,1);
+                    continue; // The controller is still executing the last byte, try again next round
+                }
+            }
+            CLCD_ProcessStep(Local_pDisplay);
+            Local_Active=1;
+            if(Local_pDisplay->EnablePin==ENABLE)
+            {
+                Local_PulseHigh=1;
+            }
+        }
+        if(Local_Active==0)
+        {
+            break; // Every display is idle or busy, try again next tick
+        }
+        if(Local_PulseHigh)
+        {
+            CLCD_PulseDelay(); // The next round lowers E, keep it high for the minimum pulse width
+        }
+        else
+        {
+            CLCD_CycleDelay(); // Only falling edges this round, the next round may raise E again
+        }
     }
-    else if (G_CLCD_State==CLCD_Operatinal) // Check if LCD is in operational state
+    #else
+    for(idx=0 ; idx<_LCD_NUM ; idx++) // One Enable phase per tick on every display, the pulses overlap
     {
-       switch (G_UserReq[CLCD_CurrentBuffer].Type) // Check type of current user request
+        Local_pDisplay=&CLCD_Displays[idx];
+        if (Local_pDisplay->State==CLCD_Operatinal) // Check if LCD is in operational state
+        {
+            CLCD_ProcessStep(Local_pDisplay);
+        }
+    }
+    #endif
+}
+/***********************************************************************************************/
+void CLCD_ProcessStep(CLCD_Display_tstr * Add_pDisplay)
+{
+       if((Add_pDisplay->FrameOp!=CLCD_FrameNoOp)||
+          ((Add_pDisplay->QueueCount==0)&&((Add_pDisplay->FrameDirty[FIRST_LINE]|Add_pDisplay->FrameDirty[SECOND_LINE])!=0)))
+       {
+        CLCD_FrameFlushProcess(Add_pDisplay); // Push the shadow frame when no request is pending or finish the cell in progress
+        return;
+       }
+       if(Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type!=NOReq)
+       {
+        Add_pDisplay->FrameCursor=CLCD_FRAME_NO_CURSOR; // Queued requests move the address counter
+       }
+       switch (Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type) // Check type of current user request
        {
        case WriteReq:
-        CLCD_WriteProcess(); // Process write request
+        CLCD_WriteProcess(Add_pDisplay); // Process write request
         break;
-       case WriteNumReq:
-    	CLCD_WriteNumProcess(); //write number request
-    	break;
        case WriteSpecialChar:
-        CLCD_WriteSpecialCharProcess();
+        CLCD_WriteSpecialCharProcess(Add_pDisplay);
         break; 
        case DisplaySpecialChar:
-        if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
         {
-            CLCD_WriteCharProcess(G_UserReq[CLCD_CurrentBuffer].CGRAMBlockNumber);
-            CLCD_EnablePin=ENABLE; // Enable LCD
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+            CLCD_WriteCharProcess(Add_pDisplay,Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].CGRAMBlockNumber);
+            Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
 
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable LCD
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=ReqDone; // Set request type to done
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }
@@ -320,132 +590,130 @@ void CLCD_TASK(void)
        
        break; 
        case ClearReq:
-        CLCD_SendCommandHlp(DISPLAY_CLEAR); // Send command to clear display
+        CLCD_SendCommandHlp(Add_pDisplay,DISPLAY_CLEAR); // Send command to clear display
         break;
        case CommandReq:
-        CLCD_SendCommandHlp(G_UserReq[CLCD_CurrentBuffer].Command); // Send command request
+        CLCD_SendCommandHlp(Add_pDisplay,Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Command); // Send command request
         break;
        case SetPositionReq:
-        CLCD_GoToXYProcess(); // Set cursor position request
+        CLCD_GoToXYProcess(Add_pDisplay); // Set cursor position request
         break;        
        case ReqDone:
-           G_UserReq[CLCD_CurrentBuffer].BufferState=NotBuffered; // Set buffer state to not buffered
-           for (CLCD_BufferIndex = 0; CLCD_BufferIndex < LCD_BUFFERSIZE;CLCD_BufferIndex++) // Loop through LCD buffers
-           {
-               if(G_UserReq[CLCD_BufferIndex].BufferState==Buffered) // Check if buffer is buffered
-               {
-                   break; // Exit loop
-               }
-           }
-           if(CLCD_BufferIndex==LCD_BUFFERSIZE) // Check if buffer index equals LCD buffer size
-           {
-             G_UserReq[CLCD_CurrentBuffer].Type=NOReq; // Set request type to no request
-             CLCD_CurrentBuffer=0; // Reset current buffer index
-           }
-           else
+           Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=NOReq; // Free the slot
+           Add_pDisplay->CurrentBuffer++; // Move the head to the next request, already in CLCD_ReqStart
+           if(Add_pDisplay->CurrentBuffer==LCD_BUFFERSIZE)
            {
-               CLCD_CurrentBuffer=CLCD_BufferIndex; // Update current buffer index
-               G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqStart; // Set request state to request start
-               if (CLCD_CurrentBuffer==LCD_BUFFERSIZE) // Check if current buffer index equals LCD buffer size
-               {
-                   CLCD_CurrentBuffer=0; // Reset current buffer index
-               }
+               Add_pDisplay->CurrentBuffer=0;
            }
+           Add_pDisplay->QueueCount--;
         break;           
        default:
         break;
        }
-    }
-    else{
-        /* Do Nothing */
-    }   
 }
 /***********************************************************************************************/
 void CLCD_InitAsynch(void){
+    u8 idx=0;
+    CLCD_ClockChanged(); // Enable timings at the current HCLK
+    MRCC_SubscribeClockChange(CLCD_ClockChanged);
+    for(idx=0 ; idx<_LCD_NUM ; idx++)
+    {
+        CLCD_InitDisplay(&CLCD_Displays[idx],&HLCD[idx]);
+    }
+}
+/***********************************************************************************************/
+void CLCD_InitDisplay(CLCD_Display_tstr * Add_pDisplay , const LCD_cfg_t * Add_pCfg){
     u8 idx =0; // Declare index variable
     GPIO_Pin_tstr LCD; // Declare GPIO pin structure for LCD
 
+    memset(Add_pDisplay,0,sizeof(CLCD_Display_tstr)); // Empty ring, CGRAM content unknown after power up
+    Add_pDisplay->Cfg=Add_pCfg;
+    Add_pDisplay->EnablePin=DISABLE;
+    Add_pDisplay->InitState=PowerON;
+    Add_pDisplay->FrameOp=CLCD_FrameNoOp;
+
     LCD.Mode=GPIO_MODE_OP_PP; // Set GPIO mode to output push-pull
     LCD.Speed=GPIO_SPEED_HIGH; // Set GPIO speed to high
   
     // Initialize data pins for the LCD
     for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++)
     {
-        LCD.Pin=HLCD.LCD_data_pins[idx].Pin; // Set pin number
-        LCD.Port=HLCD.LCD_data_pins[idx].Port; // Set port number
+        LCD.Pin=Add_pDisplay->Cfg->LCD_data_pins[idx].Pin; // Set pin number
+        LCD.Port=Add_pDisplay->Cfg->LCD_data_pins[idx].Port; // Set port number
         MGPIO_InitPin(&LCD); // Initialize GPIO pin
     }
 
+    CLCD_BusInit(Add_pDisplay); // Single store bus writes when the data pins share a port
+
+    // The init sequence clears the display, start with a blank clean frame
+    memset(Add_pDisplay->Frame,' ',sizeof(Add_pDisplay->Frame));
+    Add_pDisplay->FrameDirty[FIRST_LINE]=0;
+    Add_pDisplay->FrameDirty[SECOND_LINE]=0;
+    Add_pDisplay->FrameCursor=CLCD_FRAME_NO_CURSOR;
+
     // Initialize control pins for the LCD (RS, RW, E)
-    LCD.Pin=HLCD.R_S_pin.Pin; // Set RS pin number
-    LCD.Port=HLCD.R_S_pin.Port; // Set RS port number
+    LCD.Pin=Add_pDisplay->Cfg->R_S_pin.Pin; // Set RS pin number
+    LCD.Port=Add_pDisplay->Cfg->R_S_pin.Port; // Set RS port number
     MGPIO_InitPin(&LCD); // Initialize RS pin
 
-    LCD.Pin=HLCD.R_W_pin.Pin; // Set RW pin number
-    LCD.Port=HLCD.R_W_pin.Port; // Set RW port number
+    LCD.Pin=Add_pDisplay->Cfg->R_W_pin.Pin; // Set RW pin number
+    LCD.Port=Add_pDisplay->Cfg->R_W_pin.Port; // Set RW port number
     MGPIO_InitPin(&LCD); // Initialize RW pin
 
-    LCD.Pin=HLCD.E_pin.Pin; // Set E pin number
-    LCD.Port=HLCD.E_pin.Port; // Set E port number
+    LCD.Pin=Add_pDisplay->Cfg->E_pin.Pin; // Set E pin number
+    LCD.Port=Add_pDisplay->Cfg->E_pin.Port; // Set E port number
     MGPIO_InitPin(&LCD); // Initialize E pin
       
-    G_CLCD_State = CLCD_Init_state; // Set LCD state to initialization state
+    Add_pDisplay->State = CLCD_Init_state; // Set LCD state to initialization state
 }
 /***********************************************************************************************/
-void CLCD_InitSM(void){
-    static CLCD_InitStates_tenu SLocal_InitState = PowerON; // Declare local initialization state
-    static u8 Counter =0; // Initialize counter for state transition delay
-    switch (SLocal_InitState)
+void CLCD_InitSM(CLCD_Display_tstr * Add_pDisplay){
+    switch (Add_pDisplay->InitState)
     {
     case PowerON:
         #if HLCD_MODE == HLCD_MODE_8_BIT
-        SLocal_InitState = FunctionalSet; // Move to functional set state
+        Add_pDisplay->InitState = FunctionalSet; // Move to functional set state
         #elif HLCD_MODE == HLCD_MODE_4_BIT
-        SLocal_InitState = FunctionSet4bitMode; // Move to functional set state        
+        Add_pDisplay->InitState = FunctionSet4bitMode; // Move to functional set state        
         #endif
-        CLCD_EnablePin=DISABLE; // Disable enable pin
-        CLCD_ControlEnablePin(GPIO_Low); // Set enable pin to low
+        Add_pDisplay->EnablePin=DISABLE; // Disable enable pin
+        CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin to low
         break;
     case FunctionSet4bitMode:
-        if(CLCD_EnablePin==DISABLE) // Check if enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if enable pin is disabled
         {
-            MGPIO_SetPin(HLCD.R_S_pin.Port,HLCD.R_S_pin.Pin,GPIO_Low); // Set RS pin low to indicate command mode
-            MGPIO_SetPin(HLCD.R_W_pin.Port,HLCD.R_W_pin.Pin,GPIO_Low); // Set RW pin low to indicate write mode
-            MGPIO_SetPin(HLCD.LCD_data_pins[0].Port,HLCD.LCD_data_pins[0].Pin,GPIO_Low);
-            MGPIO_SetPin(HLCD.LCD_data_pins[1].Port,HLCD.LCD_data_pins[1].Pin,GPIO_High);
-            MGPIO_SetPin(HLCD.LCD_data_pins[2].Port,HLCD.LCD_data_pins[2].Pin,GPIO_Low);
-            MGPIO_SetPin(HLCD.LCD_data_pins[3].Port,HLCD.LCD_data_pins[3].Pin,GPIO_Low);
-            CLCD_EnablePin=ENABLE; // Enable enable pin
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin to high
+            CLCD_WriteBus(Add_pDisplay,FUNCTION_SET>>CLCD_NIBBLE_BITS,GPIO_Low); // Function set high nibble alone switches the LCD to 4-bit
+            Add_pDisplay->EnablePin=ENABLE; // Enable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin to high
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable enable pin
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin to low   
-            SLocal_InitState = FunctionalSet; // Move to functional set state      
+            Add_pDisplay->EnablePin=DISABLE; // Disable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin to low   
+            Add_pDisplay->InitState = FunctionalSet; // Move to functional set state      
 
         }    
 
         break;    
     case FunctionalSet:
-    if(Counter>=19) // Check if counter reaches delay value
+    if(Add_pDisplay->InitCounter>=19) // Check if counter reaches delay value
     {
-        if(CLCD_EnablePin==DISABLE) // Check if enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if enable pin is disabled
         {
-            CLCD_SendCommandProcess(FUNCTION_SET); // Send function set command to LCD
-            CLCD_EnablePin=ENABLE; // Enable enable pin
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin to high
+            CLCD_SendCommandProcess(Add_pDisplay,FUNCTION_SET); // Send function set command to LCD
+            Add_pDisplay->EnablePin=ENABLE; // Enable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin to high
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable enable pin
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin to low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin to low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                SLocal_InitState = DisplayControl; // Move to display control state
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->InitState = DisplayControl; // Move to display control state
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }
@@ -453,25 +721,25 @@ void CLCD_InitSM(void){
 
         }
     } 
-        Counter++; // Increment counter
+        Add_pDisplay->InitCounter++; // Increment counter
         break;
     case DisplayControl:
-        if(CLCD_EnablePin==DISABLE) // Check if enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if enable pin is disabled
         {
-            CLCD_SendCommandProcess(DISPLAY_ON_OFF); // Send display on/off command to LCD
-            CLCD_EnablePin=ENABLE; // Enable enable pin
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin to high
+            CLCD_SendCommandProcess(Add_pDisplay,DISPLAY_ON_OFF); // Send display on/off command to LCD
+            Add_pDisplay->EnablePin=ENABLE; // Enable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin to high
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable enable pin
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin to low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin to low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                SLocal_InitState = DisplayClear; // Move to display clear state
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->InitState = DisplayClear; // Move to display clear state
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }
@@ -482,22 +750,22 @@ void CLCD_InitSM(void){
         
         break;
     case DisplayClear:
-        if(CLCD_EnablePin==DISABLE) // Check if enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if enable pin is disabled
         {
-            CLCD_SendCommandProcess(DISPLAY_CLEAR); // Send display clear command to LCD
-            CLCD_EnablePin=ENABLE; // Enable enable pin
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin to high
+            CLCD_SendCommandProcess(Add_pDisplay,DISPLAY_CLEAR); // Send display clear command to LCD
+            Add_pDisplay->EnablePin=ENABLE; // Enable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin to high
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable enable pin
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin to low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable enable pin
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin to low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                SLocal_InitState =InitEnd; // Move to initialization end state
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->InitState =InitEnd; // Move to initialization end state
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }         
@@ -506,7 +774,7 @@ void CLCD_InitSM(void){
         
         break;
     case InitEnd:
-        G_CLCD_State = CLCD_Operatinal; // Set CLCD state to operational
+        Add_pDisplay->State = CLCD_Operatinal; // Set CLCD state to operational
         break;
                                           
     default:
@@ -515,71 +783,158 @@ void CLCD_InitSM(void){
 
 }
 /***********************************************************************************************/
-void CLCD_ControlEnablePin(u8 Copy_Pinstatus){
-    MGPIO_SetPin(HLCD.E_pin.Port,HLCD.E_pin.Pin,Copy_Pinstatus); // Set the enable pin status
+void CLCD_ControlEnablePin(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Pinstatus){
+    MGPIO_FastWritePin(Add_pDisplay->Cfg->E_pin.Port,Add_pDisplay->Cfg->E_pin.Pin,Copy_Pinstatus); // Set the enable pin status
+    CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,1);
 }
 /***********************************************************************************************/
-void CLCD_SendCommandProcess(u8 Copy_Command){
-    u8 idx=0; // Declare index variable
-    MGPIO_SetPin(HLCD.R_S_pin.Port,HLCD.R_S_pin.Pin,GPIO_Low); // Set RS pin low to indicate command mode
-    MGPIO_SetPin(HLCD.R_W_pin.Port,HLCD.R_W_pin.Pin,GPIO_Low); // Set RW pin low to indicate write mode
-    #if HLCD_MODE == HLCD_MODE_8_BIT
-    for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Loop through data pins
+void CLCD_SendCommandProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Command){
+    CLCD_WriteByteProcess(Add_pDisplay,Copy_Command,GPIO_Low); // RS low to indicate command mode
+}
+/***********************************************************************************************/
+void CLCD_WriteByteProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Byte , u8 Copy_RS){
+    #if HLCD_MODE == HLCD_MODE_4_BIT
+    u16 Local_LowSet=0;
+    #endif
+    if(Copy_RS==GPIO_High)
+    {
+        CLCD_STAT_ADD(Add_pDisplay,DataBytes,1);
+    }
+    else
     {
-        MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,((Copy_Command>>idx)&0x01)); // Set data pins according to command
+        CLCD_STAT_ADD(Add_pDisplay,CommandBytes,1);
     }
-    CLCD_PartCount=CLCD_FIRST_SECOND_PART;
+    #if HLCD_MODE == HLCD_MODE_8_BIT
+    CLCD_WriteBus(Add_pDisplay,Copy_Byte,Copy_RS);
 
     #elif HLCD_MODE == HLCD_MODE_4_BIT
-    if(CLCD_PartCount==CLCD_FIRST_PART)
+    /* Both nibbles in the same phase: the high nibble is clocked in here by a short E pulse and the low one is
+       left on the bus for the E pulse of the caller, so a byte costs two phases like in 8-bit mode */
+    Local_LowSet=Add_pDisplay->BusLowTable[Copy_Byte&CLCD_NIBBLE_MASK]|((Copy_RS==GPIO_High)?Add_pDisplay->BusRSMask:0);
+    CLCD_WriteBus(Add_pDisplay,Copy_Byte>>CLCD_NIBBLE_BITS,Copy_RS); // High nibble first, also sets RS and RW
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_High);
+    CLCD_PulseDelay(); // Enable pulse width
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // The LCD latches the high nibble
+    if(Add_pDisplay->BusPort!=NULL)
     {
-        for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Loop through data pins
+        MGPIO_FastWritePort(Add_pDisplay->BusPort,Local_LowSet,Add_pDisplay->BusMask&~Local_LowSet); // RS and RW keep their level
+        CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,1);
+    }
+    else
+    {
+        CLCD_WriteBus(Add_pDisplay,Copy_Byte&CLCD_NIBBLE_MASK,Copy_RS);
+    }
+    CLCD_CycleDelay(); // Enable cycle time before the caller raises E for the low nibble
+    #endif
+    Add_pDisplay->PartCount=CLCD_FIRST_SECOND_PART; // The byte is complete once the caller lowers E
+}
+/***********************************************************************************************/
+void CLCD_BusInit(CLCD_Display_tstr * Add_pDisplay){
+    u8 idx=0;
+    u8 Local_Value=0;
+    Add_pDisplay->BusPort=Add_pDisplay->Cfg->LCD_data_pins[0].Port;
+    Add_pDisplay->BusMask=0;
+    for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Check that all the data pins are on the same port
+    {
+        if(Add_pDisplay->Cfg->LCD_data_pins[idx].Port!=Add_pDisplay->BusPort)
+        {
+            Add_pDisplay->BusPort=NULL; // Fall back on one write per pin
+            break;
+        }
+        Add_pDisplay->BusMask|=(1<<Add_pDisplay->Cfg->LCD_data_pins[idx].Pin);
+    }
+    if(Add_pDisplay->BusPort!=NULL)
+    {
+        for(Local_Value=0 ; Local_Value<CLCD_NIBBLE_VALUES ; Local_Value++)
         {
-            MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,((Copy_Command>>(idx+4))&0x01)); // Set data pins according to command
+            Add_pDisplay->BusLowTable[Local_Value]=0;
+            #if HLCD_MODE == HLCD_MODE_8_BIT
+            Add_pDisplay->BusHighTable[Local_Value]=0;
+            #endif
+            for(idx=0 ; idx<CLCD_NIBBLE_BITS ; idx++)
+            {
+                if((Local_Value>>idx)&0x01)
+                {
+                    Add_pDisplay->BusLowTable[Local_Value]|=(1<<Add_pDisplay->Cfg->LCD_data_pins[idx].Pin);
+                    #if HLCD_MODE == HLCD_MODE_8_BIT
+                    Add_pDisplay->BusHighTable[Local_Value]|=(1<<Add_pDisplay->Cfg->LCD_data_pins[idx+CLCD_NIBBLE_BITS].Pin);
+                    #endif
+                }
+            }
         }
-        CLCD_PartCount=CLCD_FIRST_PART_SEND;
+        Add_pDisplay->BusDataMask=Add_pDisplay->BusMask;
+        Add_pDisplay->BusRSMask=(Add_pDisplay->Cfg->R_S_pin.Port==Add_pDisplay->BusPort)?(1<<Add_pDisplay->Cfg->R_S_pin.Pin):0;
+        Add_pDisplay->BusRWMask=(Add_pDisplay->Cfg->R_W_pin.Port==Add_pDisplay->BusPort)?(1<<Add_pDisplay->Cfg->R_W_pin.Pin):0;
+        Add_pDisplay->BusMask|=Add_pDisplay->BusRSMask|Add_pDisplay->BusRWMask;
     }
-
-    else if(CLCD_PartCount==CLCD_FIRST_PART_SEND)
+}
+/***********************************************************************************************/
+void CLCD_WriteBus(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Value , u8 Copy_RS){
+    u8 idx=0; // Declare index variable
+    u16 Local_Set=0;
+    if(Add_pDisplay->BusPort!=NULL)
+    {
+        Local_Set=Add_pDisplay->BusLowTable[Copy_Value&CLCD_NIBBLE_MASK];
+        #if HLCD_MODE == HLCD_MODE_8_BIT
+        Local_Set|=Add_pDisplay->BusHighTable[Copy_Value>>CLCD_NIBBLE_BITS];
+        #endif
+        if(Copy_RS==GPIO_High)
+        {
+            Local_Set|=Add_pDisplay->BusRSMask;
+        }
+        if(Add_pDisplay->BusRSMask==0)
+        {
+            MGPIO_FastWritePin(Add_pDisplay->Cfg->R_S_pin.Port,Add_pDisplay->Cfg->R_S_pin.Pin,Copy_RS);
+            CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,1);
+        }
+        if(Add_pDisplay->BusRWMask==0)
+        {
+            MGPIO_FastWritePin(Add_pDisplay->Cfg->R_W_pin.Port,Add_pDisplay->Cfg->R_W_pin.Pin,GPIO_Low); // RW low to indicate write mode
+            CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,1);
+        }
+        MGPIO_FastWritePort(Add_pDisplay->BusPort,Local_Set,Add_pDisplay->BusMask&~Local_Set); // RW is in the reset half when folded
+        CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,1);
+    }
+    else
     {
+        MGPIO_FastWritePin(Add_pDisplay->Cfg->R_S_pin.Port,Add_pDisplay->Cfg->R_S_pin.Pin,Copy_RS);
+        MGPIO_FastWritePin(Add_pDisplay->Cfg->R_W_pin.Port,Add_pDisplay->Cfg->R_W_pin.Pin,GPIO_Low); // RW low to indicate write mode
         for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Loop through data pins
         {
-            MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,((Copy_Command>>(idx))&0x01)); // Set data pins according to command
+            MGPIO_FastWritePin(Add_pDisplay->Cfg->LCD_data_pins[idx].Port,Add_pDisplay->Cfg->LCD_data_pins[idx].Pin,((Copy_Value>>idx)&0x01));
         }
-        CLCD_PartCount=CLCD_SECOND_PART;
+        CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,HLCD_PINS_NUMBER+2); // RS, RW and one store per data pin
     }
-
-    #endif
 }
 /***********************************************************************************************/
-void CLCD_WriteProcess(void){
+void CLCD_WriteProcess(CLCD_Display_tstr * Add_pDisplay){
 
-    switch (G_UserReq[CLCD_CurrentBuffer].State) // Check current state of the write request
+    switch (Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State) // Check current state of the write request
     {
     case CLCD_ReqStart:
-        G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
+        Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
     break;    
     case CLCD_ReqInprogress:
-        if(G_UserWriteReq[CLCD_CurrentBuffer].CurrPos<G_UserReq[CLCD_CurrentBuffer].Len) // Check if there are more characters to write
+        if(Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos<Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Len) // Check if there are more characters to write
         {
-            if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+            if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
             {
-                CLCD_ITER=G_UserWriteReq[CLCD_CurrentBuffer].CurrPos; // Set current position
-                CLCD_WriteCharProcess(G_UserReq[CLCD_CurrentBuffer].Str[CLCD_ITER]); // Write character to LCD
-                CLCD_EnablePin=ENABLE; // Enable LCD
-                CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+                Add_pDisplay->Iter=Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos; // Set current position
+                CLCD_WriteCharProcess(Add_pDisplay,Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Str[Add_pDisplay->Iter]); // Write character to LCD
+                Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
 
             }
             else
             {
-                CLCD_EnablePin=DISABLE; // Disable LCD
-                CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-                if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+                Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
                 {
-                    G_UserWriteReq[CLCD_CurrentBuffer].CurrPos++; // Move to next character position
-                    if(CLCD_PartCount==CLCD_SECOND_PART)
+                    Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos++; // Move to next character position
+                    if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                     {
-                        CLCD_PartCount=CLCD_FIRST_PART;
+                        Add_pDisplay->PartCount=CLCD_FIRST_PART;
                     }
 
                 }
@@ -589,8 +944,8 @@ void CLCD_WriteProcess(void){
         }
         else
         {
-            G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-            G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
+            Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=ReqDone; // Set request type to done
+            Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
 
         }
         break;
@@ -600,28 +955,28 @@ void CLCD_WriteProcess(void){
     }
 }
 /***********************************************************************************************/
-void CLCD_WriteSpecialCharProcess(void)
+void CLCD_WriteSpecialCharProcess(CLCD_Display_tstr * Add_pDisplay)
 {
-    switch (G_UserReq[CLCD_CurrentBuffer].State) // Check current state of the write request
+    switch (Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State) // Check current state of the write request
     {
     case CLCD_ReqStart:
-        if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
         {
-            CLCD_SendCommandProcess((G_UserReq[CLCD_CurrentBuffer].CGRAMBlockNumber)*(CLCD_NUMBER_OF_CGRAM_BYTES)+CLCD_SET_CGR_ADDRESS);
-            CLCD_EnablePin=ENABLE; // Enable LCD
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+            CLCD_SendCommandProcess(Add_pDisplay,(Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].CGRAMBlockNumber)*(CLCD_NUMBER_OF_CGRAM_BYTES)+CLCD_SET_CGR_ADDRESS);
+            Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
 
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable LCD
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }
@@ -632,26 +987,26 @@ void CLCD_WriteSpecialCharProcess(void)
 
     break;    
     case CLCD_ReqInprogress:
-        if(G_UserWriteReq[CLCD_CurrentBuffer].CurrPos<G_UserReq[CLCD_CurrentBuffer].Len) // Check if there are more characters to write
+        if(Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos<Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Len) // Check if there are more characters to write
         {
-            if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+            if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
             {
-                CLCD_ITER=G_UserWriteReq[CLCD_CurrentBuffer].CurrPos; // Set current position
-                CLCD_WriteCharProcess(G_UserReq[CLCD_CurrentBuffer].Str[CLCD_ITER]); // Write character to LCD
-                CLCD_EnablePin=ENABLE; // Enable LCD
-                CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+                Add_pDisplay->Iter=Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos; // Set current position
+                CLCD_WriteCharProcess(Add_pDisplay,Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Str[Add_pDisplay->Iter]); // Write character to LCD
+                Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
 
             }
             else
             {
-                CLCD_EnablePin=DISABLE; // Disable LCD
-                CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-                if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+                Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
                 {
-                    G_UserWriteReq[CLCD_CurrentBuffer].CurrPos++; // Move to next character position
-                    if(CLCD_PartCount==CLCD_SECOND_PART)
+                    Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CurrPos++; // Move to next character position
+                    if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                     {
-                        CLCD_PartCount=CLCD_FIRST_PART;
+                        Add_pDisplay->PartCount=CLCD_FIRST_PART;
                     }
 
                 }
@@ -662,29 +1017,29 @@ void CLCD_WriteSpecialCharProcess(void)
 
         else
         {
-           G_UserReq[CLCD_CurrentBuffer].State=CLCD_SetDDRAM; // Set request state to done
+           Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_SetDDRAM; // Set request state to done
 
         }
         break;
     case CLCD_SetDDRAM:
-        if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+        if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
         {
-            CLCD_SendCommandProcess(START_ADDREESS);
-            CLCD_EnablePin=ENABLE; // Enable LCD
-            CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+            CLCD_SendCommandProcess(Add_pDisplay,START_ADDREESS);
+            Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
 
         }
         else
         {
-            CLCD_EnablePin=DISABLE; // Disable LCD
-            CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+            CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=ReqDone; // Set request type to done
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                    CLCD_PartCount=CLCD_FIRST_PART;
+                    Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }
@@ -700,64 +1055,36 @@ void CLCD_WriteSpecialCharProcess(void)
 
 
 /***********************************************************************************************/
-void CLCD_WriteCharProcess(u8 Copy_Char){
-    u8 idx=0; // Declare index variable
-   
-    MGPIO_SetPin(HLCD.R_S_pin.Port,HLCD.R_S_pin.Pin,GPIO_High); // Set RS pin high to indicate data mode
-    MGPIO_SetPin(HLCD.R_W_pin.Port,HLCD.R_W_pin.Pin,GPIO_Low); // Set RW pin low to indicate write mode
-    #if HLCD_MODE == HLCD_MODE_8_BIT
-    for (idx=0 ; idx <HLCD_PINS_NUMBER; idx++) // Loop through data pins
-    {
-        MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,(Copy_Char>>idx)&1); // Set data pins according to character
-    }
-    #elif HLCD_MODE == HLCD_MODE_4_BIT
-    if(CLCD_PartCount==CLCD_FIRST_PART)
-    {
-        for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Loop through data pins
-        {
-            MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,((Copy_Char>>(idx+4))&0x01)); // Set data pins according to command
-        }
-        CLCD_PartCount=CLCD_FIRST_PART_SEND;
-    }
-
-    else if(CLCD_PartCount==CLCD_FIRST_PART_SEND)
-    {
-        for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++) // Loop through data pins
-        {
-            MGPIO_SetPin(HLCD.LCD_data_pins[idx].Port,HLCD.LCD_data_pins[idx].Pin,((Copy_Char>>(idx))&0x01)); // Set data pins according to command
-        }
-        CLCD_PartCount=CLCD_SECOND_PART;
-    }
-
-    #endif
+void CLCD_WriteCharProcess(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Char){
+    CLCD_WriteByteProcess(Add_pDisplay,Copy_Char,GPIO_High); // RS high to indicate data mode
 }
 /***********************************************************************************************/
-void CLCD_SendCommandHlp(u8 Copy_Command)
+void CLCD_SendCommandHlp(CLCD_Display_tstr * Add_pDisplay , u8 Copy_Command)
 {
-    switch (G_UserReq[CLCD_CurrentBuffer].State) // Check current state of the request
+    switch (Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State) // Check current state of the request
     {
     case CLCD_ReqStart:
-        G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
+        Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
         break;
     case CLCD_ReqInprogress:
 
-            if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
+            if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
             {
-                CLCD_SendCommandProcess(Copy_Command); // Send command to LCD
-                CLCD_EnablePin=ENABLE; // Enable LCD
-                CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
+                CLCD_SendCommandProcess(Add_pDisplay,Copy_Command); // Send command to LCD
+                Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
             }
             else
             {
-                CLCD_EnablePin=DISABLE; // Disable LCD
-                CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-                if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+                Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+                CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
                 {
-                    G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                    G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                    if(CLCD_PartCount==CLCD_SECOND_PART)
+                    Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=ReqDone; // Set request type to done
+                    Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
+                    if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                     {
-                        CLCD_PartCount=CLCD_FIRST_PART;
+                        Add_pDisplay->PartCount=CLCD_FIRST_PART;
                     }
 
                 }                
@@ -771,43 +1098,43 @@ void CLCD_SendCommandHlp(u8 Copy_Command)
     }
 }
 /***********************************************************************************************/
-void CLCD_GoToXYProcess(void)
+void CLCD_GoToXYProcess(CLCD_Display_tstr * Add_pDisplay)
 {
-    switch (G_UserReq[CLCD_CurrentBuffer].State) // Check the state of the current request
+    switch (Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State) // Check the state of the current request
     {
     case CLCD_ReqStart: // If request has just started
-        	G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqInprogress; // Update request state to in-progress
+        	Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqInprogress; // Update request state to in-progress
         break;
     case CLCD_ReqInprogress: // If request is in progress
-    	if(CLCD_EnablePin==DISABLE) // Check if LCD is not busy
+    	if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD is not busy
     	 {
-    		if (G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionX == FIRST_LINE && G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionY < COLOUM_NUMBER) // Check if cursor position is on the first line and within column bounds
+    		if (Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionX == FIRST_LINE && Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionY < COLOUM_NUMBER) // Check if cursor position is on the first line and within column bounds
     		{
-    			CLCD_SendCommandProcess((G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionY-1)+128); // Send command to set cursor position on the first line
+    			CLCD_SendCommandProcess(Add_pDisplay,(Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionY-1)+128); // Send command to set cursor position on the first line
     		}
-    		else if (G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionX == SECOND_LINE && G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionY < COLOUM_NUMBER) // Check if cursor position is on the second line and within column bounds
+    		else if (Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionX == SECOND_LINE && Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionY < COLOUM_NUMBER) // Check if cursor position is on the second line and within column bounds
     		{
-    			CLCD_SendCommandProcess((G_UserWriteReq[CLCD_CurrentBuffer].CLCD_PositionY-1)+192); // Send command to set cursor position on the second line
+    			CLCD_SendCommandProcess(Add_pDisplay,(Add_pDisplay->UserWriteReq[Add_pDisplay->CurrentBuffer].CLCD_PositionY-1)+192); // Send command to set cursor position on the second line
     		}
             else{
 
             }
 
-    	    CLCD_EnablePin=ENABLE; // Enable LCD control pins
-    	    CLCD_ControlEnablePin(GPIO_High); // Set control pin to high
+    	    Add_pDisplay->EnablePin=ENABLE; // Enable LCD control pins
+    	    CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set control pin to high
     	 }
        else // If LCD is busy
     	{
-    	    CLCD_EnablePin=DISABLE; // Disable LCD control pins
-    	    CLCD_ControlEnablePin(GPIO_Low); // Set control pin to low
+    	    Add_pDisplay->EnablePin=DISABLE; // Disable LCD control pins
+    	    CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set control pin to low
 
-            if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
             {
-                G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                if(CLCD_PartCount==CLCD_SECOND_PART)
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].Type=ReqDone; // Set request type to done
+                Add_pDisplay->UserReq[Add_pDisplay->CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
+                if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
                 {
-                  CLCD_PartCount=CLCD_FIRST_PART;
+                  Add_pDisplay->PartCount=CLCD_FIRST_PART;
                 }
 
             }  
@@ -818,293 +1145,514 @@ void CLCD_GoToXYProcess(void)
     }
 }
 /***********************************************************************************************/
-void CLCD_WriteNumProcess(void) {
-    static s32 Local_Reversed = 1; // Initialize outside the function
-    switch (G_UserReq[CLCD_CurrentBuffer].State) {
-    case CLCD_ReqStart:
-       	if(G_UserReq[CLCD_CurrentBuffer].Number==0)
-
-       	{  if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
-               {
-
-                   CLCD_WriteCharProcess('0'); // Write character to LCD
-                   CLCD_EnablePin=ENABLE; // Enable LCD
-                   CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
-
-               }
-               else
-               {
-                   CLCD_EnablePin=DISABLE; // Disable LCD
-                   CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-                    if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
-                    {
-                        G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                        G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                        if(CLCD_PartCount==CLCD_SECOND_PART)
-                        {
-                            CLCD_PartCount=CLCD_FIRST_PART;
-                        }
-
-                    }  
-
-               }
-       	}
-       	else
-       	{
-            if(G_UserReq[CLCD_CurrentBuffer].Number<0)
-            {
-              if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
-               {
-
-                   CLCD_WriteCharProcess('-');  // Write character to LCD
-                   G_UserReq[CLCD_CurrentBuffer].Number*=-1; 
-                   CLCD_EnablePin=ENABLE; // Enable LCD
-                   CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
-
-               }
-               else
-               {
-                   CLCD_EnablePin=DISABLE; // Disable LCD
-                   CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-                    if(CLCD_PartCount==CLCD_SECOND_PART||CLCD_PartCount==CLCD_FIRST_SECOND_PART)
-                    {
-                        G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                        G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Set request state to done
-                        if(CLCD_PartCount==CLCD_SECOND_PART)
-                        {
-                            CLCD_PartCount=CLCD_FIRST_PART;
-                        }
-
-                    }  
-
-               }
- 
-            }
-            else
-            {
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqInprogress; // Move to in-progress state
-            }
-            
-       	}
-
-       break;
-       case CLCD_ReqInprogress:
-
-       		while(G_UserReq[CLCD_CurrentBuffer].Number!=0)
-       		{
-       			Local_Reversed=(Local_Reversed*10)+(G_UserReq[CLCD_CurrentBuffer].Number%10);
-       			G_UserReq[CLCD_CurrentBuffer].Number/=10;
-       		}
-       		if(Local_Reversed!=1)
-
-           	{  if(CLCD_EnablePin==DISABLE) // Check if LCD enable pin is disabled
-                {
-
-                   CLCD_WriteCharProcess((Local_Reversed%10)+'0'); // Write character to LCD
-                   Local_Reversed/=10;
-                   CLCD_EnablePin=ENABLE; // Enable LCD
-                   CLCD_ControlEnablePin(GPIO_High); // Set enable pin high
-
-                }
-               else
-               {
-                   CLCD_EnablePin=DISABLE; // Disable LCD
-                   CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-
-                    if(CLCD_PartCount==CLCD_SECOND_PART)
-                    {
-                        CLCD_PartCount=CLCD_FIRST_PART;
-                    }
-               }
-           	}
-       		else
-       		{
-                G_UserReq[CLCD_CurrentBuffer].Type=ReqDone; // Set request type to done
-                G_UserReq[CLCD_CurrentBuffer].State=CLCD_ReqDone; // Update request state to done
-                CLCD_EnablePin=DISABLE; // Disable LCD
-                CLCD_ControlEnablePin(GPIO_Low); // Set enable pin low
-       		}
-
-
-           break;
-
-       default:
-           break;
-       }
+CLCD_Display_tstr * CLCD_GetDisplay(u8 Copy_Display)
+{
+    return (Copy_Display<_LCD_NUM)?&CLCD_Displays[Copy_Display]:NULL;
 }
-/******************************************user Functions*****************************************************/
-tenu_ErrorStatus CLCD_WriteStringAsynch(char * Add_pStr , u8 Copy_len){
-    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK; // Initialize local error status
-    u8 idx_Buffer=0; // Declare buffer index variable
-    if(Add_pStr==NULL) // Check if string pointer is NULL
+/***********************************************************************************************/
+u8 CLCD_FormatNumber(char * Add_pBuffer , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad)
+{
+    char Local_Digits[CLCD_MAX_DIGITS]; // Digits from the least significant one
+    u8 Local_Count=0;
+    u8 Local_Len=0;
+    u8 Local_Pos=0;
+    u8 Local_Negative=(Copy_Number<0);
+    u32 Local_Magnitude=Local_Negative?((u32)(-(Copy_Number+1))+1):(u32)Copy_Number; // -(Copy_Number) overflows for the min value
+    u32 Local_Quotient=0;
+    do
     {
-        Local_ErrorStatus = LBTY_ErrorNullPointer; // Set error status to null pointer error
+        Local_Quotient=(u32)(((u64)Local_Magnitude*CLCD_DIV10_RECIPROCAL)>>CLCD_DIV10_SHIFT);
+        Local_Digits[Local_Count++]=(char)('0'+(Local_Magnitude-(Local_Quotient*10)));
+        Local_Magnitude=Local_Quotient;
+    }while((Local_Magnitude!=0)||(Local_Count<=Copy_Decimals)); // Keep the 0 of 0.xx
+    Local_Len=Local_Count+Local_Negative+((Copy_Decimals!=0)?1:0);
+    if((Copy_Pad==HLCD_PAD_SPACE)&&(Copy_Width>Local_Len))
+    {
+        for( ; Local_Pos<(Copy_Width-Local_Len) ; Local_Pos++)
+        {
+            Add_pBuffer[Local_Pos]=' ';
+        }
     }
-    else
+    if(Local_Negative)
     {
-    for(idx_Buffer=0;idx_Buffer<LCD_BUFFERSIZE;idx_Buffer++) // Loop through LCD buffers
+        Add_pBuffer[Local_Pos++]='-';
+    }
+    if((Copy_Pad==HLCD_PAD_ZERO)&&(Copy_Width>Local_Len))
     {
-        if (G_UserReq[idx_Buffer].BufferState==NotBuffered) // Check if buffer is not currently buffered
+        for(Local_Len=Copy_Width-Local_Len ; Local_Len>0 ; Local_Len--)
         {
-            G_UserReq[idx_Buffer].Str=Add_pStr; // Set string pointer
-            G_UserWriteReq[idx_Buffer].CurrPos=0; // Reset current position
-            G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-            G_UserReq[idx_Buffer].Len=Copy_len; // Set string length
-            G_UserReq[idx_Buffer].Type=WriteReq; // Set request type to write
-            G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-
-            break; // Exit loop
-        }        
-    }   
-    if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
-    {
-        Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+            Add_pBuffer[Local_Pos++]='0';
+        }
     }
-
+    while(Local_Count>0)
+    {
+        if((Local_Count==Copy_Decimals)&&(Copy_Decimals!=0))
+        {
+            Add_pBuffer[Local_Pos++]='.';
+        }
+        Add_pBuffer[Local_Pos++]=Local_Digits[--Local_Count];
     }
-    return Local_ErrorStatus; // Return error status
+    return Local_Pos;
 }
-/******************************************user Functions*****************************************************/
-tenu_ErrorStatus CLCD_GoToXYAsynch(u8 Copy_X , u8 Copy_Y)
+/***********************************************************************************************/
+tenu_ErrorStatus CLCD_QueueCopy(CLCD_Display_tstr * Add_pDisplay , const char * Add_pStr , u8 Copy_len)
 {
-    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK; // Initialize local error status
-    u8 idx_Buffer=0; // Declare buffer index variable
-	if (Copy_X <= SECOND_LINE && Copy_Y < COLOUM_NUMBER) // Check if row and column numbers are within valid range
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    u8 idx_Buffer=0;
+    if(CLCD_CoalesceWrite(Add_pDisplay,Add_pStr,Copy_len)==0) // Try to extend the last write first
+    {
+        idx_Buffer=CLCD_ReserveReq(Add_pDisplay);
+        if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
+        {
+            Local_ErrorStatus=LBTY_Busy;
+        }
+        else
+        {
+            memcpy(Add_pDisplay->UserReq[idx_Buffer].Burst,Add_pStr,Copy_len);
+            Add_pDisplay->UserReq[idx_Buffer].Str=Add_pDisplay->UserReq[idx_Buffer].Burst;
+            Add_pDisplay->UserReq[idx_Buffer].Len=Copy_len;
+            Add_pDisplay->UserReq[idx_Buffer].Type=WriteReq;
+            CLCD_CommitReq(Add_pDisplay);
+        }
+    }
+    return Local_ErrorStatus;
+}
+#if CLCD_BUSY_WAITS
+/***********************************************************************************************/
+void CLCD_PulseDelay(void)
+{
+    volatile u32 Local_Count=0;
+    for(Local_Count=0 ; Local_Count<CLCD_PulseLoops ; Local_Count++);
+}
+/***********************************************************************************************/
+void CLCD_CycleDelay(void)
+{
+    volatile u32 Local_Count=0;
+    for(Local_Count=0 ; Local_Count<CLCD_LowLoops ; Local_Count++);
+}
+#endif
+/***********************************************************************************************/
+u32 CLCD_NsToLoops(u32 Copy_Ns , u32 Copy_HclkHz)
+{
+    u64 Local_Cycles=(((u64)Copy_Ns*Copy_HclkHz)+CLCD_NS_PER_SECOND-1)/CLCD_NS_PER_SECOND;
+    return (u32)((Local_Cycles+HLCD_DELAY_LOOP_CYCLES-1)/HLCD_DELAY_LOOP_CYCLES);
+}
+/***********************************************************************************************/
+void CLCD_ClockChanged(void)
+{
+    u32 Local_HclkHz=MRCC_GetHCLKHz();
+    CLCD_PulseLoops=CLCD_NsToLoops(HLCD_E_PULSE_NS,Local_HclkHz);
+    CLCD_LowLoops=CLCD_NsToLoops(HLCD_E_CYCLE_NS-HLCD_E_PULSE_NS,Local_HclkHz);
+}
+#if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+/***********************************************************************************************/
+u8 CLCD_ReadBusyFlag(CLCD_Display_tstr * Add_pDisplay)
+{
+    u8 idx=0;
+    u8 Local_Busy=DISABLE;
+    MGPIO_FastWritePin(Add_pDisplay->Cfg->R_S_pin.Port,Add_pDisplay->Cfg->R_S_pin.Pin,GPIO_Low); // RS low, instruction register
+    if(Add_pDisplay->BusPort!=NULL)
+    {
+        MGPIO_SetPinsMode(Add_pDisplay->BusPort,Add_pDisplay->BusDataMask,GPIO_MODE_IN_FL); // Release the bus before the LCD drives it
+    }
+    else
+    {
+        for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++)
+        {
+            MGPIO_SetPinsMode(Add_pDisplay->Cfg->LCD_data_pins[idx].Port,(1<<Add_pDisplay->Cfg->LCD_data_pins[idx].Pin),GPIO_MODE_IN_FL);
+        }
+    }
+    MGPIO_FastWritePin(Add_pDisplay->Cfg->R_W_pin.Port,Add_pDisplay->Cfg->R_W_pin.Pin,GPIO_High); // RW high, read mode
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_High);
+    CLCD_PulseDelay(); // Data delay time
+    Local_Busy=MGPIO_FastReadPin(Add_pDisplay->Cfg->LCD_data_pins[HLCD_PINS_NUMBER-1].Port,Add_pDisplay->Cfg->LCD_data_pins[HLCD_PINS_NUMBER-1].Pin); // BF is on D7
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low);
+    #if HLCD_MODE == HLCD_MODE_4_BIT
+    CLCD_CycleDelay();
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // The low nibble (address counter) has to be clocked out too
+    CLCD_PulseDelay();
+    CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low);
+    #endif
+    CLCD_CycleDelay(); // The caller may raise E again right after the read
+    MGPIO_FastWritePin(Add_pDisplay->Cfg->R_W_pin.Port,Add_pDisplay->Cfg->R_W_pin.Pin,GPIO_Low); // RW low, write mode
+    CLCD_STAT_ADD(Add_pDisplay,GPIOWrites,3); // RS and the two RW stores, E is counted by CLCD_ControlEnablePin
+    if(Add_pDisplay->BusPort!=NULL)
+    {
+        MGPIO_SetPinsMode(Add_pDisplay->BusPort,Add_pDisplay->BusDataMask,GPIO_MODE_OP_PP);
+    }
+    else
+    {
+        for(idx=0 ; idx<HLCD_PINS_NUMBER ; idx++)
+        {
+            MGPIO_SetPinsMode(Add_pDisplay->Cfg->LCD_data_pins[idx].Port,(1<<Add_pDisplay->Cfg->LCD_data_pins[idx].Pin),GPIO_MODE_OP_PP);
+        }
+    }
+    return (Local_Busy==GPIO_High)?ENABLE:DISABLE;
+}
+#endif
+/***********************************************************************************************/
+void CLCD_FrameFlushProcess(CLCD_Display_tstr * Add_pDisplay)
+{
+    u8 Local_Line=0;
+    u8 Local_Column=0;
+    if(Add_pDisplay->EnablePin==DISABLE) // Check if LCD enable pin is disabled
+    {
+        if(Add_pDisplay->FrameOp==CLCD_FrameNoOp)
+        {
+            Add_pDisplay->FrameCell=CLCD_FrameNextDirtyCell(Add_pDisplay);
+            if(Add_pDisplay->FrameCell==CLCD_FRAME_NO_CURSOR)
+            {
+                return; // Nothing left to push
+            }
+            Local_Line=Add_pDisplay->FrameCell/HLCD_FRAME_COLUMNS;
+            Local_Column=Add_pDisplay->FrameCell%HLCD_FRAME_COLUMNS;
+            if(Add_pDisplay->FrameCell==Add_pDisplay->FrameCursor)
+            {
+                Add_pDisplay->FrameOp=CLCD_FrameWriteChar;
+                Add_pDisplay->FrameSentChar=Add_pDisplay->Frame[Local_Line][Local_Column];
+            }
+            else
+            {
+                Add_pDisplay->FrameOp=CLCD_FrameSetAddress;
+            }
+        }
+        if(Add_pDisplay->FrameOp==CLCD_FrameWriteChar)
+        {
+            CLCD_WriteCharProcess(Add_pDisplay,Add_pDisplay->FrameSentChar); // Write character to LCD
+        }
+        else
+        {
+            Local_Line=Add_pDisplay->FrameCell/HLCD_FRAME_COLUMNS;
+            Local_Column=Add_pDisplay->FrameCell%HLCD_FRAME_COLUMNS;
+            CLCD_SendCommandProcess(Add_pDisplay,HLCD_SET_DDR_ADDRESS+(Local_Line*CLCD_SECOND_LINE_ADDRESS)+Local_Column);
+        }
+        Add_pDisplay->EnablePin=ENABLE; // Enable LCD
+        CLCD_ControlEnablePin(Add_pDisplay,GPIO_High); // Set enable pin high
+    }
+    else
+    {
+        Add_pDisplay->EnablePin=DISABLE; // Disable LCD
+        CLCD_ControlEnablePin(Add_pDisplay,GPIO_Low); // Set enable pin low
+        if(Add_pDisplay->PartCount==CLCD_SECOND_PART||Add_pDisplay->PartCount==CLCD_FIRST_SECOND_PART)
+        {
+            if(Add_pDisplay->FrameOp==CLCD_FrameWriteChar)
+            {
+                Local_Line=Add_pDisplay->FrameCell/HLCD_FRAME_COLUMNS;
+                Local_Column=Add_pDisplay->FrameCell%HLCD_FRAME_COLUMNS;
+                CLCD_STAT_ADD(Add_pDisplay,FrameCells,1);
+                if(Add_pDisplay->Frame[Local_Line][Local_Column]==Add_pDisplay->FrameSentChar)
+                {
+                    Add_pDisplay->FrameDirty[Local_Line]&=~(1<<Local_Column);
+                }
+                #if HLCD_INCREMENT_DECREMENT == HLCD_INCREMENT
+                // The counter moves past the visible columns after the last cell of a line
+                Add_pDisplay->FrameCursor=(Local_Column<(HLCD_FRAME_COLUMNS-1))?(Add_pDisplay->FrameCell+1):CLCD_FRAME_NO_CURSOR;
+                #else
+                Add_pDisplay->FrameCursor=CLCD_FRAME_NO_CURSOR;
+                #endif
+            }
+            else
+            {
+                Add_pDisplay->FrameCursor=Add_pDisplay->FrameCell;
+            }
+            Add_pDisplay->FrameOp=CLCD_FrameNoOp;
+            if(Add_pDisplay->PartCount==CLCD_SECOND_PART)
+            {
+                Add_pDisplay->PartCount=CLCD_FIRST_PART;
+            }
+        }
+    }
+}
+/***********************************************************************************************/
+u8 CLCD_FrameNextDirtyCell(CLCD_Display_tstr * Add_pDisplay)
+{
+    u8 Local_Cell=(Add_pDisplay->FrameCursor==CLCD_FRAME_NO_CURSOR)?0:Add_pDisplay->FrameCursor;
+    u8 Local_Count=0;
+    for(Local_Count=0;Local_Count<(HLCD_FRAME_LINES*HLCD_FRAME_COLUMNS);Local_Count++)
+    {
+        if((Add_pDisplay->FrameDirty[Local_Cell/HLCD_FRAME_COLUMNS]>>(Local_Cell%HLCD_FRAME_COLUMNS))&0x01)
+        {
+            return Local_Cell;
+        }
+        Local_Cell++;
+        if(Local_Cell==(HLCD_FRAME_LINES*HLCD_FRAME_COLUMNS))
+        {
+            Local_Cell=0;
+        }
+    }
+    return CLCD_FRAME_NO_CURSOR;
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_FrameWriteString(u8 Copy_Display , u8 Copy_X , u8 Copy_Y , const char * Add_pStr , u8 Copy_len)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK; // Initialize local error status
+    u8 idx=0;
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if(Add_pStr==NULL) // Check if string pointer is NULL
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer;
+    }
+    else if (Copy_X >= HLCD_FRAME_LINES || Copy_Y >= HLCD_FRAME_COLUMNS) // Check if row and column numbers are within valid range
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else
+    {
+        for(idx=0 ; (idx<Copy_len)&&((Copy_Y+idx)<HLCD_FRAME_COLUMNS) ; idx++)
+        {
+            if(Local_pDisplay->Frame[Copy_X][Copy_Y+idx]!=Add_pStr[idx]) // Only the changed cells have to be pushed
+            {
+                Local_pDisplay->Frame[Copy_X][Copy_Y+idx]=Add_pStr[idx];
+                Local_pDisplay->FrameDirty[Copy_X]|=(1<<(Copy_Y+idx));
+            }
+        }
+    }
+    return Local_ErrorStatus;
+}
+/******************************************user Functions*****************************************************/
+void CLCD_FrameClear(u8 Copy_Display)
+{
+    u8 Local_Line=0;
+    u8 Local_Column=0;
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    for(Local_Line=0 ; (Local_pDisplay!=NULL)&&(Local_Line<HLCD_FRAME_LINES) ; Local_Line++)
+    {
+        for(Local_Column=0 ; Local_Column<HLCD_FRAME_COLUMNS ; Local_Column++)
+        {
+            if(Local_pDisplay->Frame[Local_Line][Local_Column]!=' ')
+            {
+                Local_pDisplay->Frame[Local_Line][Local_Column]=' ';
+                Local_pDisplay->FrameDirty[Local_Line]|=(1<<Local_Column);
+            }
+        }
+    }
+}
+/***********************************************************************************************/
+u8 CLCD_ReserveReq(CLCD_Display_tstr * Add_pDisplay)
+{
+    u8 Local_Slot=LCD_BUFFERSIZE;
+    if(Add_pDisplay->QueueCount<LCD_BUFFERSIZE)
+    {
+        Local_Slot=Add_pDisplay->QueueTail;
+        Add_pDisplay->UserReq[Local_Slot].State=CLCD_ReqStart; // Set request state to request start
+        Add_pDisplay->UserWriteReq[Local_Slot].CurrPos=0; // Reset current position
+    }
+    return Local_Slot;
+}
+/***********************************************************************************************/
+void CLCD_CommitReq(CLCD_Display_tstr * Add_pDisplay)
+{
+    Add_pDisplay->QueueTail++;
+    if(Add_pDisplay->QueueTail==LCD_BUFFERSIZE)
+    {
+        Add_pDisplay->QueueTail=0;
+    }
+    Add_pDisplay->QueueCount++;
+}
+/***********************************************************************************************/
+u8 CLCD_CoalesceWrite(CLCD_Display_tstr * Add_pDisplay , const char * Add_pStr , u8 Copy_len)
+{
+    u8 Local_Merged=0;
+    u8 Local_Last=(Add_pDisplay->QueueTail==0)?(LCD_BUFFERSIZE-1):(Add_pDisplay->QueueTail-1);
+    CLCD_UserReq_tstr * Local_pReq=&Add_pDisplay->UserReq[Local_Last];
+    if((Add_pDisplay->QueueCount>0)&&(Local_pReq->Type==WriteReq)&&(Local_pReq->State==CLCD_ReqStart)&&
+       ((Local_pReq->Len+Copy_len)<=LCD_BURST_SIZE))
+    {
+        if(Local_pReq->Str!=Local_pReq->Burst)
+        {
+            memcpy(Local_pReq->Burst,Local_pReq->Str,Local_pReq->Len); // First merge, take a copy of the first string
+            Local_pReq->Str=Local_pReq->Burst;
+        }
+        memcpy(&Local_pReq->Burst[Local_pReq->Len],Add_pStr,Copy_len);
+        Local_pReq->Len+=Copy_len;
+        Local_Merged=1;
+    }
+    return Local_Merged;
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_WriteStringAsynch(u8 Copy_Display , char * Add_pStr , u8 Copy_len){
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK; // Initialize local error status
+    u8 idx_Buffer=0; // Declare buffer index variable
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if(Add_pStr==NULL) // Check if string pointer is NULL
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer; // Set error status to null pointer error
+    }
+    else if(CLCD_CoalesceWrite(Local_pDisplay,Add_pStr,Copy_len)==0) // Try to extend the last write first
+    {
+        idx_Buffer=CLCD_ReserveReq(Local_pDisplay);
+        if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
+        {
+            Local_ErrorStatus=LBTY_Busy; // Back-pressure, the caller has to retry
+        }
+        else
+        {
+            Local_pDisplay->UserReq[idx_Buffer].Str=Add_pStr; // Set string pointer
+            Local_pDisplay->UserReq[idx_Buffer].Len=Copy_len; // Set string length
+            Local_pDisplay->UserReq[idx_Buffer].Type=WriteReq; // Set request type to write
+            CLCD_CommitReq(Local_pDisplay);
+        }
+    }
+    return Local_ErrorStatus; // Return error status
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_GoToXYAsynch(u8 Copy_Display , u8 Copy_X , u8 Copy_Y)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK; // Initialize local error status
+    u8 idx_Buffer=0; // Declare buffer index variable
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+	if ((Local_pDisplay!=NULL) && Copy_X <= SECOND_LINE && Copy_Y < COLOUM_NUMBER) // Check if row and column numbers are within valid range
 	{
-	    for(idx_Buffer=0;idx_Buffer<LCD_BUFFERSIZE;idx_Buffer++) // Loop through LCD buffers
-	    {
-	        if (G_UserReq[idx_Buffer].BufferState==NotBuffered) // Check if buffer is not currently buffered
-	        {
-
-	        		G_UserWriteReq[idx_Buffer].CLCD_PositionX=Copy_X; // Set current row
-	                G_UserWriteReq[idx_Buffer].CLCD_PositionY=Copy_Y; // Set current column
-	                G_UserReq[idx_Buffer].Type=SetPositionReq; // Set request type to set position
-	                G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-	                G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-	                break; // Exit loop
-	        }
-	    }
-
+        idx_Buffer=CLCD_ReserveReq(Local_pDisplay);
+        if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
+        {
+            Local_ErrorStatus=LBTY_Busy;
+        }
+        else
+        {
+            Local_pDisplay->UserWriteReq[idx_Buffer].CLCD_PositionX=Copy_X; // Set current row
+            Local_pDisplay->UserWriteReq[idx_Buffer].CLCD_PositionY=Copy_Y; // Set current column
+            Local_pDisplay->UserReq[idx_Buffer].Type=SetPositionReq; // Set request type to set position
+            CLCD_CommitReq(Local_pDisplay);
+        }
 	}
     else
     {
         Local_ErrorStatus = LBTY_ErrorInvalidInput; // Set error status to invalid input
     }
 
-    if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
-    {
-    	Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
-    }
-
     return Local_ErrorStatus; // Return error status
 }
 /******************************************user Functions*****************************************************/
-tenu_ErrorStatus CLCD_ClearScreenAsynch(void)
+tenu_ErrorStatus CLCD_ClearScreenAsynch(u8 Copy_Display)
 {
     tenu_ErrorStatus Local_ErrorStatus= LBTY_OK;
     u8 idx_Buffer=0; // Declare buffer index variable
-	for(idx_Buffer=0;idx_Buffer<LCD_BUFFERSIZE;idx_Buffer++) // Loop through LCD buffers
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
     {
-		if (G_UserReq[idx_Buffer].BufferState==NotBuffered) // Check if buffer is not currently buffered
-		{
-			G_UserReq[idx_Buffer].Type=ClearReq; // Set request type to clear screen
-			G_UserReq[idx_Buffer].BufferState=Buffered; // Set
-            G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-            break; // Exit loop
-
-
-		}
-	}
-    if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if ((idx_Buffer=CLCD_ReserveReq(Local_pDisplay))==LCD_BUFFERSIZE) // Check if the ring is full
     {
-        Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+        Local_ErrorStatus=LBTY_Busy;
+    }
+    else
+    {
+        Local_pDisplay->UserReq[idx_Buffer].Type=ClearReq; // Set request type to clear screen
+        CLCD_CommitReq(Local_pDisplay);
+        // The frame is only pushed once the queue is idle, so after this clear: drop what it still had to push
+        memset(Local_pDisplay->Frame,' ',sizeof(Local_pDisplay->Frame));
+        Local_pDisplay->FrameDirty[FIRST_LINE]=0;
+        Local_pDisplay->FrameDirty[SECOND_LINE]=0;
     }
     return Local_ErrorStatus;
 
 
 }
 /******************************************user Functions*****************************************************/
-tenu_ErrorStatus CLCD_WriteCommandAsynch(u8 Copy_Command){
+tenu_ErrorStatus CLCD_WriteCommandAsynch(u8 Copy_Display , u8 Copy_Command){
     tenu_ErrorStatus Local_ErrorStatus =LBTY_OK;
     u8 idx_Buffer=0; // Declare buffer index variable
-     for(idx_Buffer=0;idx_Buffer<LCD_BUFFERSIZE;idx_Buffer++) // Loop through LCD buffers
-     {
-        if (G_UserReq[idx_Buffer].BufferState==NotBuffered) // Check if buffer is not currently buffered
-         {
-             G_UserReq[idx_Buffer].Command=Copy_Command; // Set command to be written
-             G_UserReq[idx_Buffer].Type=CommandReq; // Set request type to command
-             G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-             G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-              break; // Exit loop
-         }
-     }
-    if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
-    {
-        Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if ((idx_Buffer=CLCD_ReserveReq(Local_pDisplay))==LCD_BUFFERSIZE) // Check if the ring is full
+    {
+        Local_ErrorStatus=LBTY_Busy;
+    }
+    else
+    {
+        Local_pDisplay->UserReq[idx_Buffer].Command=Copy_Command; // Set command to be written
+        Local_pDisplay->UserReq[idx_Buffer].Type=CommandReq; // Set request type to command
+        CLCD_CommitReq(Local_pDisplay);
     }
      return Local_ErrorStatus;
 }
 /******************************************user Functions*****************************************************/
-tenu_ErrorStatus CLCD_WriteNumberAsynch(s32 Copy_Number)
+tenu_ErrorStatus CLCD_WriteNumberAsynch(u8 Copy_Display , s32 Copy_Number)
+{
+    return CLCD_WriteFormattedAsynch(Copy_Display,Copy_Number,0,0,HLCD_PAD_SPACE);
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_WriteFormattedAsynch(u8 Copy_Display , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad)
 {
 	tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
-    u8 idx_Buffer=0;
-        for(idx_Buffer=0;idx_Buffer<LCD_BUFFERSIZE;idx_Buffer++) // Loop through LCD buffers
+    char Local_Text[CLCD_FORMAT_MAX_LEN+LCD_BURST_SIZE]; // Room for the longest number whatever LCD_BURST_SIZE is
+    u8 Local_Len=0;
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if((Local_pDisplay==NULL)||(Copy_Width>LCD_BURST_SIZE)||(Copy_Decimals>CLCD_MAX_DECIMALS)||(Copy_Pad>HLCD_PAD_ZERO))
     {
-        if (G_UserReq[idx_Buffer].BufferState==NotBuffered) // Check if buffer is not currently buffered
-        {
-            G_UserReq[idx_Buffer].Number=Copy_Number; // Copy the string to the buffer
-            G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-            G_UserReq[idx_Buffer].Type=WriteNumReq; // Set request type to write
-            G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-
-            break; // Exit loop
-        }
+        Local_ErrorStatus=LBTY_ErrorInvalidInput;
     }
-    if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
+    else
     {
-        Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+        Local_Len=CLCD_FormatNumber(Local_Text,Copy_Number,Copy_Width,Copy_Decimals,Copy_Pad);
+        Local_ErrorStatus=CLCD_QueueCopy(Local_pDisplay,Local_Text,Local_Len); // The text is rendered now, one write request whatever the number of digits
+    }
+	return Local_ErrorStatus;
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_FrameWriteFormatted(u8 Copy_Display , u8 Copy_X , u8 Copy_Y , s32 Copy_Number , u8 Copy_Width , u8 Copy_Decimals , u8 Copy_Pad)
+{
+	tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    char Local_Text[CLCD_FORMAT_MAX_LEN+HLCD_FRAME_COLUMNS];
+    u8 Local_Len=0;
+    if((Copy_Width>HLCD_FRAME_COLUMNS)||(Copy_Decimals>CLCD_MAX_DECIMALS)||(Copy_Pad>HLCD_PAD_ZERO))
+    {
+        Local_ErrorStatus=LBTY_ErrorInvalidInput;
+    }
+    else
+    {
+        Local_Len=CLCD_FormatNumber(Local_Text,Copy_Number,Copy_Width,Copy_Decimals,Copy_Pad);
+        Local_ErrorStatus=CLCD_FrameWriteString(Copy_Display,Copy_X,Copy_Y,Local_Text,Local_Len);
     }
-
-
-
 	return Local_ErrorStatus;
 }
 /******************************************user Functions*****************************************************/
 
-tenu_ErrorStatus CLCD_WriteSpecialCharAsynch(char * Add_Pattern, u8 Copy_CGRAMBlockNumber)
+tenu_ErrorStatus CLCD_WriteSpecialCharAsynch(u8 Copy_Display , char * Add_Pattern, u8 Copy_CGRAMBlockNumber)
 {
     tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
     u8 idx_Buffer=0;
-    if(Add_Pattern==NULL)
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if(Add_Pattern==NULL)
     {
         Local_ErrorStatus =LBTY_ErrorNullPointer;
     }
-    else if (Copy_CGRAMBlockNumber>CLCD_NUMBER_OF_CGRAM_BYTES)
+    else if (Copy_CGRAMBlockNumber>=CLCD_NUMBER_OF_CGRAM_BLOCKS)
     {
         Local_ErrorStatus =LBTY_ErrorInvalidInput;
     }
     else
     {
-        for(idx_Buffer=0 ; idx_Buffer<LCD_BUFFERSIZE ; idx_Buffer++)
+        idx_Buffer=CLCD_ReserveReq(Local_pDisplay);
+        if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
         {
-            if(G_UserReq[idx_Buffer].BufferState==NotBuffered)
-            {
-            G_UserReq[idx_Buffer].Str=Add_Pattern; // Set string pointer
-            G_UserReq[idx_Buffer].CGRAMBlockNumber=Copy_CGRAMBlockNumber;
-            G_UserWriteReq[idx_Buffer].CurrPos=0; // Reset current position
-            G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-            G_UserReq[idx_Buffer].Len=CLCD_NUMBER_OF_CGRAM_BYTES; // Set string length
-            G_UserReq[idx_Buffer].Type=WriteSpecialChar; // Set request type to write
-            G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-            break;
-
-
-            }
-         }
-        if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
+    	    Local_ErrorStatus=LBTY_Busy;
+        }
+        else
         {
-    	    Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+            Local_pDisplay->UserReq[idx_Buffer].Str=Add_Pattern; // Set string pointer
+            Local_pDisplay->UserReq[idx_Buffer].CGRAMBlockNumber=Copy_CGRAMBlockNumber;
+            Local_pDisplay->UserReq[idx_Buffer].Len=CLCD_NUMBER_OF_CGRAM_BYTES; // Set string length
+            Local_pDisplay->UserReq[idx_Buffer].Type=WriteSpecialChar; // Set request type to write
+            CLCD_CommitReq(Local_pDisplay);
+            CLCD_GlyphInvalidate(Local_pDisplay,Copy_CGRAMBlockNumber);
         }
     }
     
@@ -1112,37 +1660,178 @@ tenu_ErrorStatus CLCD_WriteSpecialCharAsynch(char * Add_Pattern, u8 Copy_CGRAMBl
     return Local_ErrorStatus;
 
 }
-tenu_ErrorStatus CLCD_DisplaySpecialCharAsynch( u8 Copy_CGRAMBlockNumber)
+tenu_ErrorStatus CLCD_DisplaySpecialCharAsynch(u8 Copy_Display , u8 Copy_CGRAMBlockNumber)
 {
     tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
     u8 idx_Buffer=0;
-    if (Copy_CGRAMBlockNumber>CLCD_NUMBER_OF_CGRAM_BYTES)
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if ((Local_pDisplay==NULL)||Copy_CGRAMBlockNumber>=CLCD_NUMBER_OF_CGRAM_BLOCKS)
     {
         Local_ErrorStatus =LBTY_ErrorInvalidInput;
     }
     else
     {
-        for(idx_Buffer=0 ; idx_Buffer<LCD_BUFFERSIZE ; idx_Buffer++)
+        idx_Buffer=CLCD_ReserveReq(Local_pDisplay);
+        if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
         {
-            if(G_UserReq[idx_Buffer].BufferState==NotBuffered)
-            {
-
-            G_UserReq[idx_Buffer].CGRAMBlockNumber=Copy_CGRAMBlockNumber;
-            G_UserReq[idx_Buffer].Type=DisplaySpecialChar; // Set request type to write
-            G_UserReq[idx_Buffer].State=CLCD_ReqStart; // Set request state to request start
-            G_UserReq[idx_Buffer].BufferState=Buffered; // Set buffer state to buffered
-            break;
-
-
-            }
-         }
-        if (idx_Buffer==LCD_BUFFERSIZE) // Check if buffer index reaches buffer size
+    	    Local_ErrorStatus=LBTY_Busy;
+        }
+        else
         {
-    	    Local_ErrorStatus=LBTY_NOK; // Set error status to not ok
+            Local_pDisplay->UserReq[idx_Buffer].CGRAMBlockNumber=Copy_CGRAMBlockNumber;
+            Local_pDisplay->UserReq[idx_Buffer].Type=DisplaySpecialChar; // Set request type to write
+            CLCD_CommitReq(Local_pDisplay);
         }
     }
     
 
     return Local_ErrorStatus;
 
-}
\ No newline at end of file
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_GetGlyphAsynch(u8 Copy_Display , const char * Add_Pattern , u8 * Add_pCode)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    u32 Local_Hash=0;
+    u8 Local_Slot=0;
+    u8 Local_Victim=0;
+    u8 idx_Buffer=0;
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if((Add_Pattern==NULL)||(Add_pCode==NULL))
+    {
+        Local_ErrorStatus =LBTY_ErrorNullPointer;
+    }
+    else
+    {
+        Local_Hash=CLCD_GlyphHash(Add_Pattern);
+        Local_pDisplay->GlyphClock++;
+        for(Local_Slot=0 ; Local_Slot<CLCD_GLYPH_SLOTS ; Local_Slot++)
+        {
+            if((Local_pDisplay->Glyphs[Local_Slot].Valid)&&(Local_pDisplay->Glyphs[Local_Slot].Hash==Local_Hash)&&
+               (memcmp(Local_pDisplay->Glyphs[Local_Slot].Pattern,Add_Pattern,CLCD_NUMBER_OF_CGRAM_BYTES)==0))
+            {
+                break; // Resident, nothing to upload
+            }
+            // Free blocks first, then the one unused for the longest time (the clock wraps, compare the ages)
+            if((Local_pDisplay->Glyphs[Local_Victim].Valid)&&((!Local_pDisplay->Glyphs[Local_Slot].Valid)||
+               ((u16)(Local_pDisplay->GlyphClock-Local_pDisplay->Glyphs[Local_Slot].LastUse)>(u16)(Local_pDisplay->GlyphClock-Local_pDisplay->Glyphs[Local_Victim].LastUse))))
+            {
+                Local_Victim=Local_Slot;
+            }
+        }
+        if(Local_Slot==CLCD_GLYPH_SLOTS)
+        {
+            idx_Buffer=CLCD_ReserveReq(Local_pDisplay);
+            if (idx_Buffer==LCD_BUFFERSIZE) // Check if the ring is full
+            {
+                Local_ErrorStatus=LBTY_Busy;
+            }
+            else
+            {
+                Local_Slot=Local_Victim;
+                memcpy(Local_pDisplay->Glyphs[Local_Slot].Pattern,Add_Pattern,CLCD_NUMBER_OF_CGRAM_BYTES);
+                Local_pDisplay->Glyphs[Local_Slot].Hash=Local_Hash;
+                Local_pDisplay->Glyphs[Local_Slot].Valid=1;
+                Local_pDisplay->UserReq[idx_Buffer].Str=Local_pDisplay->Glyphs[Local_Slot].Pattern;
+                Local_pDisplay->UserReq[idx_Buffer].CGRAMBlockNumber=HLCD_GLYPH_FIRST_BLOCK+Local_Slot;
+                Local_pDisplay->UserReq[idx_Buffer].Len=CLCD_NUMBER_OF_CGRAM_BYTES;
+                Local_pDisplay->UserReq[idx_Buffer].Type=WriteSpecialChar;
+                CLCD_CommitReq(Local_pDisplay);
+            }
+        }
+        if(Local_ErrorStatus==LBTY_OK)
+        {
+            Local_pDisplay->Glyphs[Local_Slot].LastUse=Local_pDisplay->GlyphClock;
+            *Add_pCode=HLCD_GLYPH_FIRST_BLOCK+Local_Slot;
+        }
+    }
+    return Local_ErrorStatus;
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_DisplayGlyphAsynch(u8 Copy_Display , const char * Add_Pattern)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    u8 Local_Code=0;
+    if(Add_Pattern==NULL)
+    {
+        Local_ErrorStatus =LBTY_ErrorNullPointer;
+    }
+    else if(CLCD_GetFreeSlots(Copy_Display)<2) // Upload and display go together or not at all
+    {
+        Local_ErrorStatus =LBTY_Busy;
+    }
+    else
+    {
+        Local_ErrorStatus=CLCD_GetGlyphAsynch(Copy_Display,Add_Pattern,&Local_Code);
+        if(Local_ErrorStatus==LBTY_OK)
+        {
+            Local_ErrorStatus=CLCD_DisplaySpecialCharAsynch(Copy_Display,Local_Code);
+        }
+    }
+    return Local_ErrorStatus;
+}
+/***********************************************************************************************/
+u32 CLCD_GlyphHash(const char * Add_Pattern)
+{
+    u32 Local_Hash=CLCD_GLYPH_HASH_BASIS;
+    u8 idx=0;
+    for(idx=0 ; idx<CLCD_NUMBER_OF_CGRAM_BYTES ; idx++)
+    {
+        Local_Hash=(Local_Hash^(u8)Add_Pattern[idx])*CLCD_GLYPH_HASH_PRIME;
+    }
+    return Local_Hash;
+}
+/***********************************************************************************************/
+void CLCD_GlyphInvalidate(CLCD_Display_tstr * Add_pDisplay , u8 Copy_CGRAMBlockNumber)
+{
+    if((u8)(Copy_CGRAMBlockNumber-HLCD_GLYPH_FIRST_BLOCK)<CLCD_GLYPH_SLOTS) // Blocks below the cache wrap to big values
+    {
+        Add_pDisplay->Glyphs[Copy_CGRAMBlockNumber-HLCD_GLYPH_FIRST_BLOCK].Valid=0;
+    }
+}
+/******************************************user Functions*****************************************************/
+u8 CLCD_GetFreeSlots(u8 Copy_Display)
+{
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    return (Local_pDisplay==NULL)?0:(LCD_BUFFERSIZE-Local_pDisplay->QueueCount);
+}
+/******************************************user Functions*****************************************************/
+tenu_ErrorStatus CLCD_GetStats(u8 Copy_Display , CLCD_Stats_tstr * Add_pStats)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    if(Add_pStats==NULL)
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer;
+    }
+    else if(Local_pDisplay==NULL) // Check the display index
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else
+    {
+    #if HLCD_STATS == HLCD_ENABLE
+        *Add_pStats=Local_pDisplay->Stats;
+    #else
+        Local_ErrorStatus = LBTY_NOK; // Not counted in this build
+    #endif
+    }
+    return Local_ErrorStatus;
+}
+/******************************************user Functions*****************************************************/
+void CLCD_ResetStats(u8 Copy_Display)
+{
+    CLCD_Display_tstr * Local_pDisplay=CLCD_GetDisplay(Copy_Display);
+    #if HLCD_STATS == HLCD_ENABLE
+    if(Local_pDisplay!=NULL)
+    {
+        memset(&Local_pDisplay->Stats,0,sizeof(CLCD_Stats_tstr));
+    }
+    #else
+    (void)Local_pDisplay;
+    #endif
+}
@@ -1,22 +1,56 @@
-
 #include"STD_TYPES.h"
 #include"HKPD/KYD.h"
 #include"MGPIO/GPIO.h"
+#include"Bit_Math.h"
+#include"Atomic.h"
+#include"MRCC/RCC.h"
+
+#if (KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS) > 16
+#error "the keypad is scanned into a u16 bitmap, KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS must not exceed 16"
+#endif
+#if KPD_DELAY_LOOP_CYCLES == 0
+#error "KPD_DELAY_LOOP_CYCLES must not be 0"
+#endif
 
-#define THRESHOLD          5
-#define SWITCH_OFFSET_4    4
-#define SWITCH_PRESSED     1
-#define SWITCH_NOT_PRESSED 0 
-#define INIT               0
-#define PRESSED            1
-#define NOT_PRESSED        2
 #define NOT_SW_PRESSED     0
 #define NEW_VALUE          1
 #define OLD_VLAUE          0
+/* bit of the key at column COL and row ROW in the bitmaps, same order as the old scan */
+#define KPD_KEY_BIT(COL,ROW)    (((COL)*KPD_NUMBER_OF_ROWS)+(ROW))
+#define KPD_NS_PER_SECOND       1000000000ULL
+
+/* A port holding row pins, it is read once per column */
+typedef struct
+{
+	void * Port;
+	u16 PinMask;           // Row pins of the port
+}KPD_RowPort_tstr;
 
 extern tstr_KPDPinConfiguration KPD_Conf;
+static KPD_RowPort_tstr KPDRowPorts[KPD_NUMBER_OF_ROWS]; // At most one port per row
+static u8 KPDRowPortsNum=0;
+static u8 KPDRowPortOf[KPD_NUMBER_OF_ROWS]; // Index in KPDRowPorts of each row
+/* Debouncer of the whole matrix, bit n is the key KPD_KEY_BIT, 1 is pressed.
+ * Vertical counter: Count1:Count0 is a 2-bit counter per key, it counts the scans that differ
+ * from KPDPressed and is cleared by any scan that agrees with it, the key toggles on the 4th one. */
+static u16 KPDPressed=0;
+static u16 KPDCount0=0;
+static u16 KPDCount1=0;
+static volatile u16 KPDPressEdges=0;   // Keys that became pressed since the last KPD_GetTransitions
+static volatile u16 KPDReleaseEdges=0; // Keys that became released since the last KPD_GetTransitions
+static u32 KPDSettleLoops=0; // Busy loop iterations of KPD_SETTLE_NS at the current HCLK
 static char KPDPressedKey=0;
 static u8 NewValueflag=0;
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+/* Set from the EXTI interrupt of any row, the runnable does nothing until it is set */
+static volatile u8 KPDWake=0;
+static u8 KPDScanning=0;
+static void KPD_RowCallBack(u8 Copy_Line);
+static void KPD_Sleep(void);
+static void KPD_Wakeup(void);
+#endif
+static u16 KPD_Scan(void);
+static void KPD_ClockChanged(void);
 
 tenu_ErrorStatus KPD_INIT(void)
 {
@@ -25,8 +59,12 @@ tenu_ErrorStatus KPD_INIT(void)
 	Switch_Pin.Speed=GPIO_SPEED_HIGH;
 	/*define variable to indicating the success or failure of the function */
 	tenu_ErrorStatus Local_u8ErrorStatus = LBTY_OK;
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+	tenu_ErrorStatus Local_EXTIStatus;
+#endif
 	/*define variable to loop on all col pins and row pins */
 	u8 Local_u8Index=0;
+	u8 Local_u8Port=0;
 	/*define all col pin as output high */
 	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_COLUMNS;Local_u8Index++)
 	{
@@ -37,86 +75,122 @@ tenu_ErrorStatus KPD_INIT(void)
 		MGPIO_SetPin(Switch_Pin.Port,Switch_Pin.Pin,GPIO_High);
 	}
 	/*define all row pin as input pull up */
+	KPDRowPortsNum=0;
 	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_ROWS;Local_u8Index++)
 	{
 		Switch_Pin.Mode=KPD_Conf.RowModePin[Local_u8Index];
 		Switch_Pin.Pin=KPD_Conf.RowPinNumber[Local_u8Index];
 		Switch_Pin.Port=KPD_Conf.RowPortNumber[Local_u8Index];
 		MGPIO_InitPin(&Switch_Pin);
+		/*group the row with the others of its port*/
+		for(Local_u8Port=0;(Local_u8Port<KPDRowPortsNum)&&(KPDRowPorts[Local_u8Port].Port!=Switch_Pin.Port);Local_u8Port++);
+		if(Local_u8Port==KPDRowPortsNum)
+		{
+			KPDRowPortsNum++;
+			KPDRowPorts[Local_u8Port].Port=Switch_Pin.Port;
+			KPDRowPorts[Local_u8Port].PinMask=0;
+		}
+		KPDRowPortOf[Local_u8Index]=Local_u8Port;
+		KPDRowPorts[Local_u8Port].PinMask|=(1<<Switch_Pin.Pin);
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+		/* LBTY_Busy is passed up as is, the row line belongs to another module */
+		Local_EXTIStatus=MGPIO_ConfigEXTI(Switch_Pin.Port,Switch_Pin.Pin,GPIO_EXTI_FALLING,KPD_RowCallBack);
+		if(Local_EXTIStatus!=LBTY_OK)
+		{
+			Local_u8ErrorStatus=Local_EXTIStatus;
+		}
+#endif
 	}
+	KPD_ClockChanged();
+	MRCC_SubscribeClockChange(KPD_ClockChanged);
+	KPDPressed=0;
+	KPDCount0=0;
+	KPDCount1=0;
+	KPDPressEdges=0;
+	KPDReleaseEdges=0;
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+	KPD_Sleep();
+#endif
 	/*return value of Local_u8ErrorStatus variable */
 	return Local_u8ErrorStatus;
 }
 /******************************************************************************************************************************/
-void KPD_Runnable(void)
+/*clock change subscriber, converts KPD_SETTLE_NS to busy loop iterations at the new HCLK*/
+static void KPD_ClockChanged(void)
 {
-	u8 Local_Current=2;
-	
-	u8 Local_CurrentPreesedKey=0;
-	/*define variable to loop on all col pins */
-	u8 Local_u8Index1=0;
-	/*define variable to loop on all row pins */
-	u8 Local_u8Index2=0;
-	
-
-	static u8 Local_State[KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS]={INIT};
-	
-	/*local array to store keypad name that user entered it in configuration*/
-	u8 Local_u8KpdArr[KPD_NUMBER_OF_ROWS][KPD_NUMBER_OF_COLUMNS] = KPD_ARRAY;
-	for(Local_u8Index1=0;(Local_u8Index1<KPD_NUMBER_OF_COLUMNS&&Local_CurrentPreesedKey==NOT_SW_PRESSED);Local_u8Index1++)
+	u64 Local_u64Cycles=(((u64)KPD_SETTLE_NS*MRCC_GetHCLKHz())+KPD_NS_PER_SECOND-1)/KPD_NS_PER_SECOND;
+	KPDSettleLoops=(u32)((Local_u64Cycles+KPD_DELAY_LOOP_CYCLES-1)/KPD_DELAY_LOOP_CYCLES);
+}
+/******************************************************************************************************************************/
+/*drive one column low at a time and read every row port once, returns the raw bitmap of the keys seen pressed*/
+static u16 KPD_Scan(void)
+{
+	u16 Local_u16Raw=0;
+	u16 Local_u16PortLevel[KPD_NUMBER_OF_ROWS];
+	u8 Local_u8Col=0;
+	u8 Local_u8Row=0;
+	u8 Local_u8Port=0;
+	volatile u32 Local_u32Count=0;
+	for(Local_u8Col=0;Local_u8Col<KPD_NUMBER_OF_COLUMNS;Local_u8Col++)
 	{
 		/*define col pin as output low */
-		MGPIO_SetPin(KPD_Conf.ColPortNumber[Local_u8Index1],KPD_Conf.ColPinNumber[Local_u8Index1],GPIO_Low);
-		/*read the current row (pressed--->low) (not pressed--->high)*/
-		for(Local_u8Index2=0;(Local_u8Index2<KPD_NUMBER_OF_ROWS&&Local_CurrentPreesedKey==NOT_SW_PRESSED);Local_u8Index2++)
+		MGPIO_FastWritePin(KPD_Conf.ColPortNumber[Local_u8Col],KPD_Conf.ColPinNumber[Local_u8Col],GPIO_Low);
+		/*let the rows settle, a row the previous column pulled low needs its pull-up time to read high again*/
+		for(Local_u32Count=0;Local_u32Count<KPDSettleLoops;Local_u32Count++);
+		/*read the rows (pressed--->low) (not pressed--->high), one IDR load per port*/
+		for(Local_u8Port=0;Local_u8Port<KPDRowPortsNum;Local_u8Port++)
 		{
-
-			/*check if switch is pressed */
-			switch (Local_State[(Local_u8Index1*KPD_NUMBER_OF_ROWS)+Local_u8Index2])
+			Local_u16PortLevel[Local_u8Port]=MGPIO_FastReadPort(KPDRowPorts[Local_u8Port].Port);
+		}
+		/*define col pin as output high */
+		MGPIO_FastWritePin(KPD_Conf.ColPortNumber[Local_u8Col],KPD_Conf.ColPinNumber[Local_u8Col],GPIO_High);
+		for(Local_u8Row=0;Local_u8Row<KPD_NUMBER_OF_ROWS;Local_u8Row++)
+		{
+			if(((Local_u16PortLevel[KPDRowPortOf[Local_u8Row]]>>KPD_Conf.RowPinNumber[Local_u8Row])&0x01)==GPIO_Low)
 			{
-			case INIT:
-				/*get pin value of current row */
-				MGPIO_GetPinState(KPD_Conf.RowPortNumber[Local_u8Index2],KPD_Conf.RowPinNumber[Local_u8Index2],&Local_Current);
-				if(Local_Current==GPIO_Low)
-				{
-					Local_State[(Local_u8Index1*KPD_NUMBER_OF_ROWS)+Local_u8Index2]=PRESSED;
-				}
-				else
-				{
-					Local_State[(Local_u8Index1*KPD_NUMBER_OF_ROWS)+Local_u8Index2]=NOT_PRESSED;
-				}
-				break;
-			case PRESSED:
-				/*get pin value of current row */
-				MGPIO_GetPinState(KPD_Conf.RowPortNumber[Local_u8Index2],KPD_Conf.RowPinNumber[Local_u8Index2],&Local_Current);
-				if(Local_Current==GPIO_Low)
-				{
-					Local_CurrentPreesedKey=Local_u8KpdArr[Local_u8Index1][Local_u8Index2];
-				}
-				else
-				{
-					Local_State[(Local_u8Index1*KPD_NUMBER_OF_ROWS)+Local_u8Index2]=NOT_PRESSED;
-				}
-				break;	
-			case NOT_PRESSED:
-				/*get pin value of current row */
-				MGPIO_GetPinState(KPD_Conf.RowPortNumber[Local_u8Index2],KPD_Conf.RowPinNumber[Local_u8Index2],&Local_Current);
-				if(Local_Current==GPIO_Low)
-				{
-					Local_State[(Local_u8Index1*KPD_NUMBER_OF_ROWS)+Local_u8Index2]=PRESSED;
-				}
-
-				break;								
-			
-			default:
-				break;
+				Local_u16Raw|=(1<<KPD_KEY_BIT(Local_u8Col,Local_u8Row));
 			}
-				
 		}
-		/*define col pin as output high */
-		MGPIO_SetPin(KPD_Conf.ColPortNumber[Local_u8Index1],KPD_Conf.ColPinNumber[Local_u8Index1],GPIO_High);
-
-
+	}
+	return Local_u16Raw;
+}
+/******************************************************************************************************************************/
+void KPD_Runnable(void)
+{
+	u16 Local_u16Delta;
+	u16 Local_u16Toggle;
+	char Local_CurrentPreesedKey=NOT_SW_PRESSED;
+	/*local array to store keypad name that user entered it in configuration*/
+	u8 Local_u8KpdArr[KPD_NUMBER_OF_COLUMNS][KPD_NUMBER_OF_ROWS] = KPD_ARRAY;
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+	if(KPDScanning==0)
+	{
+		if(KPDWake==0)
+		{
+			/*no edge on the rows since the last scan, nothing is pressed*/
+			return;
+		}
+		KPDWake=0;
+		KPDScanning=1;
+		KPD_Wakeup();
+	}
+#endif
+	Local_u16Delta=KPD_Scan()^KPDPressed;
+	/*keys that agree with the debounced state are cleared, the others count up and toggle on the wrap*/
+	KPDCount1=(KPDCount1^KPDCount0)&Local_u16Delta;
+	KPDCount0=(~KPDCount0)&Local_u16Delta;
+	Local_u16Toggle=Local_u16Delta&~(KPDCount0|KPDCount1);
+	if(Local_u16Toggle)
+	{
+		KPDPressed^=Local_u16Toggle;
+		ATOMIC_SET_BITS(KPDPressEdges,(u16)(Local_u16Toggle&KPDPressed));
+		ATOMIC_SET_BITS(KPDReleaseEdges,(u16)(Local_u16Toggle&~KPDPressed));
+	}
+	/*KPD_GetPressedKey keeps reporting the first pressed key in scan order*/
+	if(KPDPressed)
+	{
+		u8 Local_u8Bit=GET_LOWEST_SET_BIT(KPDPressed);
+		Local_CurrentPreesedKey=Local_u8KpdArr[Local_u8Bit/KPD_NUMBER_OF_ROWS][Local_u8Bit%KPD_NUMBER_OF_ROWS];
 	}
 	if(Local_CurrentPreesedKey!=KPDPressedKey)
 	{
@@ -127,8 +201,57 @@ void KPD_Runnable(void)
 	{
 		/*do nothing*/
 	}	
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+	if((KPDPressed|KPDCount0|KPDCount1)==0)
+	{
+		/*no key is pressed or being debounced, go back to sleep*/
+		KPDScanning=0;
+		KPD_Sleep();
+	}
+#endif
 
 }
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+/******************************************************************************************************************************/
+static void KPD_RowCallBack(u8 Copy_Line)
+{
+	(void)Copy_Line;
+	KPDWake=1;
+}
+/******************************************************************************************************************************/
+/*hold all columns low so that any key pulls its row low, then unmask the rows*/
+static void KPD_Sleep(void)
+{
+	u8 Local_u8Index=0;
+	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_COLUMNS;Local_u8Index++)
+	{
+		MGPIO_FastWritePin(KPD_Conf.ColPortNumber[Local_u8Index],KPD_Conf.ColPinNumber[Local_u8Index],GPIO_Low);
+	}
+	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_ROWS;Local_u8Index++)
+	{
+		MGPIO_EnableEXTI(KPD_Conf.RowPinNumber[Local_u8Index]);
+		/*a key pressed before the line was unmasked gives no edge*/
+		if(MGPIO_FastReadPin(KPD_Conf.RowPortNumber[Local_u8Index],KPD_Conf.RowPinNumber[Local_u8Index])==GPIO_Low)
+		{
+			KPDWake=1;
+		}
+	}
+}
+/******************************************************************************************************************************/
+/*mask the rows while scanning, the column toggling would fire them, and return the columns to high*/
+static void KPD_Wakeup(void)
+{
+	u8 Local_u8Index=0;
+	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_ROWS;Local_u8Index++)
+	{
+		MGPIO_DisableEXTI(KPD_Conf.RowPinNumber[Local_u8Index]);
+	}
+	for(Local_u8Index=0;Local_u8Index<KPD_NUMBER_OF_COLUMNS;Local_u8Index++)
+	{
+		MGPIO_FastWritePin(KPD_Conf.ColPortNumber[Local_u8Index],KPD_Conf.ColPinNumber[Local_u8Index],GPIO_High);
+	}
+}
+#endif
 tenu_ErrorStatus KPD_GetPressedKey(u8 *Copy_pu8Key)
 {
 
@@ -159,3 +282,58 @@ tenu_ErrorStatus KPD_GetPressedKey(u8 *Copy_pu8Key)
      /*return value of Local_u8ErrorStatus variable */
        return Local_u8ErrorStatus;
 }
+/******************************************************************************************************************************/
+tenu_ErrorStatus KPD_GetPressedKeys(u16 *Copy_pu16Keys)
+{
+	tenu_ErrorStatus Local_u8ErrorStatus = LBTY_OK;
+	if(Copy_pu16Keys!=NULL)
+	{
+		*Copy_pu16Keys=KPDPressed;
+	}
+	else
+	{
+		Local_u8ErrorStatus=LBTY_ErrorNullPointer;
+	}
+	return Local_u8ErrorStatus;
+}
+/******************************************************************************************************************************/
+tenu_ErrorStatus KPD_GetTransitions(u16 *Copy_pu16Pressed, u16 *Copy_pu16Released)
+{
+	tenu_ErrorStatus Local_u8ErrorStatus = LBTY_OK;
+	u16 Local_u16Press;
+	u16 Local_u16Release;
+	if((Copy_pu16Pressed!=NULL)&&(Copy_pu16Released!=NULL))
+	{
+		/*take the edges and clear them, the bits taken are only cleared if still set*/
+		Local_u16Press=KPDPressEdges;
+		Local_u16Release=KPDReleaseEdges;
+		ATOMIC_CLR_BITS(KPDPressEdges,Local_u16Press);
+		ATOMIC_CLR_BITS(KPDReleaseEdges,Local_u16Release);
+		*Copy_pu16Pressed=Local_u16Press;
+		*Copy_pu16Released=Local_u16Release;
+	}
+	else
+	{
+		Local_u8ErrorStatus=LBTY_ErrorNullPointer;
+	}
+	return Local_u8ErrorStatus;
+}
+/******************************************************************************************************************************/
+tenu_ErrorStatus KPD_GetKeyName(u8 Copy_u8KeyBit, u8 *Copy_pu8Key)
+{
+	tenu_ErrorStatus Local_u8ErrorStatus = LBTY_OK;
+	u8 Local_u8KpdArr[KPD_NUMBER_OF_COLUMNS][KPD_NUMBER_OF_ROWS] = KPD_ARRAY;
+	if(Copy_pu8Key==NULL)
+	{
+		Local_u8ErrorStatus=LBTY_ErrorNullPointer;
+	}
+	else if(Copy_u8KeyBit>=(KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS))
+	{
+		Local_u8ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else
+	{
+		*Copy_pu8Key=Local_u8KpdArr[Copy_u8KeyBit/KPD_NUMBER_OF_ROWS][Copy_u8KeyBit%KPD_NUMBER_OF_ROWS];
+	}
+	return Local_u8ErrorStatus;
+}
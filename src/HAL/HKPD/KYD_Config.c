@@ -10,6 +10,8 @@
 #include"MGPIO/GPIO.h"
 
 
+/* rows on PA0..PA3 and columns on PA4..PA7, the board shares PA1..PA4 with the switches: with both drivers
+ * in their default polling mode no EXTI line is taken, KPD_MODE_EXTI and SWITCH_MODE_EXTI can't be used together */
 tstr_KPDPinConfiguration KPD_Conf = {
   .RowPinNumber[0] =GPIO_PIN_0 ,.RowPinNumber[1]=GPIO_PIN_1,.RowPinNumber[2]=GPIO_PIN_2,.RowPinNumber[3]=GPIO_PIN_3,
   .RowPortNumber[0]=GPIOA,.RowPortNumber[1]=GPIOA,.RowPortNumber[2]=GPIOA,.RowPortNumber[3]=GPIOA,
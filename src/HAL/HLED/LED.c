@@ -12,19 +12,96 @@
 #include "HLED/LED.h"
 #include "MGPIO/GPIO.h"
 #include "MRCC/RCC.h"
+#include "Atomic.h"
+#if _LED_NUM > 32
+#error "HLED_SetFrame takes the LEDs in a u32, _LED_NUM must not exceed 32"
+#endif
+
+/* Pins of the LEDs grouped by port, so that a frame is one BSRR store per port */
+typedef struct
+{
+	void * Port;
+	u16 PinMask;           // Pins of the port used by LEDs
+	u16 ActiveLowMask;     // Pins of LED_ACTIVE_LOW LEDs, the level is the inverse of the LED state
+}LED_Port_tstr;
 
 extern  const LEDSCfg_tstr LEDS[_LED_NUM];
+static LED_Port_tstr LedPorts[_LED_NUM]; // At most one port per LED
+static u8 LedPortsNum=0;
+static u8 LedPortOf[_LED_NUM]; // Index in LedPorts of each LED
+
+/* An edge of the software PWM, the pins to write when the LEDs of one duty are turned off */
+typedef struct
+{
+	u16 Step;
+	u16 Set[_LED_NUM];     // Per port, the active low LEDs
+	u16 Reset[_LED_NUM];   // Per port, the active high LEDs
+}LED_PwmEdge_tstr;
+
+/* The edges of a PWM period, StartSet/StartReset turn on the LEDs with a duty and off those at 0 */
+typedef struct
+{
+	u16 StartSet[_LED_NUM];
+	u16 StartReset[_LED_NUM];
+	u8 EdgesNum;
+	LED_PwmEdge_tstr Edges[_LED_NUM]; // Sorted by Step, one per distinct duty
+}LED_PwmTable_tstr;
+
+/* Triple buffer: the interrupt reads LedPwmTables[LedPwmFront], the application builds
+ * LedPwmTables[LedPwmBack], and they swap through LedPwmMiddle, which is never used by both at once.
+ * LED_PWM_FRESH in LedPwmMiddle marks a table the interrupt has not taken yet. */
+#define LED_PWM_FRESH           0x80
+static LED_PwmTable_tstr LedPwmTables[3];
+static u8 LedPwmFront=0;
+static volatile u8 LedPwmMiddle=1;
+static u8 LedPwmBack=2;
+static u16 LedPwmDuty[_LED_NUM];
+static u32 LedPwmMask=0;      // LEDs driven by the PWM
+static u8 LedPwmNext=0;       // 0 at the start of a period, else the edge applied by the next HLED_PwmEdge plus one
+static u16 LedPwmWait=1;      // Steps of HLED_PwmTick before the next edge
+
+static void HLED_PwmBuild(void);
+
+/* A track of the sequencer */
+typedef struct
+{
+	const LEDPattern_tstr * Pattern; // NULL when the track is stopped
+	u32 DueMs;                       // End of the current step
+	u8 Step;
+	u8 LoopsLeft;
+	u8 Start;                        // The pattern starts on the next HLED_SeqUpdate
+}LED_SeqTrack_tstr;
+
+static LED_SeqTrack_tstr LedSeqTracks[LED_SEQ_TRACKS];
+static LED_SeqWakeCBF_t LedSeqWake=NULL;
 tenu_ErrorStatus HLED_Init(void)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
 	GPIO_Pin_tstr PIN;
 	PIN.Mode=GPIO_MODE_OP_PP;
 	PIN.Speed=GPIO_SPEED_HIGH;
+	u8 Local_Port=0;
+	LedPortsNum=0;
 	for(u8 idk=0; idk<_LED_NUM;idk++)
 	{
 		PIN.Pin=LEDS[idk].Pin;
 		PIN.Port=LEDS[idk].Port;
 		MGPIO_InitPin(&PIN);
+		/* group the LED with the others of its port */
+		for(Local_Port=0;(Local_Port<LedPortsNum)&&(LedPorts[Local_Port].Port!=LEDS[idk].Port);Local_Port++);
+		if(Local_Port==LedPortsNum)
+		{
+			LedPortsNum++;
+			LedPorts[Local_Port].Port=LEDS[idk].Port;
+			LedPorts[Local_Port].PinMask=0;
+			LedPorts[Local_Port].ActiveLowMask=0;
+		}
+		LedPortOf[idk]=Local_Port;
+		LedPorts[Local_Port].PinMask|=(1<<LEDS[idk].Pin);
+		if(LEDS[idk].Connection==LED_ACTIVE_LOW)
+		{
+			LedPorts[Local_Port].ActiveLowMask|=(1<<LEDS[idk].Pin);
+		}
 	}
 	return Local_ErrorStatus;
 }
@@ -39,7 +116,7 @@ tenu_ErrorStatus HLED_SetStatus(u32 Copy_Led, u8 Copy_status)
 	}
 	else
 	{
-		MGPIO_SetPin(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin,(LEDS[Copy_Led].Connection)^Copy_status);
+		MGPIO_FastWritePin(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin,(LEDS[Copy_Led].Connection)^Copy_status);
 	}
 
 	return Local_ErrorStatus;
@@ -48,13 +125,13 @@ tenu_ErrorStatus HLED_SetStatus(u32 Copy_Led, u8 Copy_status)
 tenu_ErrorStatus HLED_Toggle(u32 Copy_Led)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
-	if(Copy_Led>_LED_NUM )
+	if(Copy_Led>=_LED_NUM )
 	{
 		Local_ErrorStatus=LBTY_NOK;
 	}
 	else
 	{
-		Local_ErrorStatus=MGPIO_TogglePin(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin);
+		MGPIO_FastTogglePin(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin);
 	}
 
 	return Local_ErrorStatus;
@@ -63,16 +140,325 @@ tenu_ErrorStatus HLED_Toggle(u32 Copy_Led)
 tenu_ErrorStatus HLED_GetStatus(u32 Copy_Led, u8 *ADD_status)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
-	u8 Local_status=0;
-	if(Copy_Led>_LED_NUM || ADD_status==NULL)
+	if(Copy_Led>=_LED_NUM || ADD_status==NULL)
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		*ADD_status=MGPIO_FastReadPin(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin)^LEDS[Copy_Led].Connection;
+	}
+
+	return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus HLED_SetFrame(u32 Copy_Frame)
+{
+	return HLED_SetFrameMasked(LED_ALL_MASK,Copy_Frame);
+}
+
+tenu_ErrorStatus HLED_SetFrameMasked(u32 Copy_Mask, u32 Copy_Frame)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u16 Local_Pins[_LED_NUM];  // Pins of the LEDs to update, per port
+	u16 Local_On[_LED_NUM];    // Pins of the LEDs to turn on, per port
+	u16 Local_Level;
+	u8 idx;
+	if(Copy_Mask&~LED_ALL_MASK)
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		for(idx=0;idx<LedPortsNum;idx++)
+		{
+			Local_Pins[idx]=0;
+			Local_On[idx]=0;
+		}
+		for(idx=0;idx<_LED_NUM;idx++)
+		{
+			if((Copy_Mask>>idx)&0x01)
+			{
+				Local_Pins[LedPortOf[idx]]|=(1<<LEDS[idx].Pin);
+				if((Copy_Frame>>idx)&0x01)
+				{
+					Local_On[LedPortOf[idx]]|=(1<<LEDS[idx].Pin);
+				}
+			}
+		}
+		for(idx=0;idx<LedPortsNum;idx++)
+		{
+			/* pin level of each LED to update, the active low ones are inverted */
+			Local_Level=(Local_On[idx]^LedPorts[idx].ActiveLowMask)&Local_Pins[idx];
+			if(Local_Pins[idx])
+			{
+				MGPIO_FastWritePort(LedPorts[idx].Port,Local_Level,Local_Pins[idx]&~Local_Level);
+			}
+		}
+	}
+
+	return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus HLED_SetBrightness(u32 Copy_Led, u16 Copy_Duty)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	if(Copy_Led>=_LED_NUM || Copy_Duty>LED_PWM_STEPS)
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		LedPwmDuty[Copy_Led]=Copy_Duty;
+		LedPwmMask|=LED_BIT(Copy_Led);
+		HLED_PwmBuild();
+	}
+
+	return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus HLED_StopBrightness(u32 Copy_Led)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	if(Copy_Led>=_LED_NUM)
 	{
 		Local_ErrorStatus=LBTY_NOK;
 	}
 	else
 	{
-		Local_ErrorStatus=MGPIO_GetPinState(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin,&Local_status);
-		*ADD_status=Local_status^LEDS[Copy_Led].Connection;
+		LedPwmMask&=~LED_BIT(Copy_Led);
+		HLED_PwmBuild();
 	}
 
 	return Local_ErrorStatus;
 }
+
+u16 HLED_PwmEdge(void)
+{
+	LED_PwmTable_tstr * Local_pTable;
+	LED_PwmEdge_tstr * Local_pEdge;
+	u16 Local_Step;
+	u16 Local_Delay;
+	u8 idx;
+	if(LedPwmNext==0)
+	{
+		/* start of a period, take the last table built */
+		if(LedPwmMiddle&LED_PWM_FRESH)
+		{
+			LedPwmFront=ATOMIC_EXCHANGE(LedPwmMiddle,LedPwmFront)&~LED_PWM_FRESH;
+		}
+		Local_pTable=&LedPwmTables[LedPwmFront];
+		for(idx=0;idx<LedPortsNum;idx++)
+		{
+			if(Local_pTable->StartSet[idx]|Local_pTable->StartReset[idx])
+			{
+				MGPIO_FastWritePort(LedPorts[idx].Port,Local_pTable->StartSet[idx],Local_pTable->StartReset[idx]);
+			}
+		}
+		Local_Step=0;
+	}
+	else
+	{
+		Local_pTable=&LedPwmTables[LedPwmFront];
+		Local_pEdge=&Local_pTable->Edges[LedPwmNext-1];
+		for(idx=0;idx<LedPortsNum;idx++)
+		{
+			if(Local_pEdge->Set[idx]|Local_pEdge->Reset[idx])
+			{
+				MGPIO_FastWritePort(LedPorts[idx].Port,Local_pEdge->Set[idx],Local_pEdge->Reset[idx]);
+			}
+		}
+		Local_Step=Local_pEdge->Step;
+	}
+	if(LedPwmNext<Local_pTable->EdgesNum)
+	{
+		Local_Delay=Local_pTable->Edges[LedPwmNext].Step-Local_Step;
+		LedPwmNext++;
+	}
+	else
+	{
+		Local_Delay=LED_PWM_STEPS-Local_Step;
+		LedPwmNext=0;
+	}
+	return Local_Delay;
+}
+
+void HLED_PwmTick(void)
+{
+	LedPwmWait--;
+	if(LedPwmWait==0)
+	{
+		LedPwmWait=HLED_PwmEdge();
+	}
+}
+
+/**
+ * @brief Builds the edge table of the current duties and hands it to the interrupt.
+ */
+static void HLED_PwmBuild(void)
+{
+	LED_PwmTable_tstr * Local_pTable=&LedPwmTables[LedPwmBack];
+	u16 Local_Pin;
+	u16 Local_Duty;
+	u8 Local_Port;
+	u8 Local_Edge;
+	u8 idx;
+	u8 idk;
+	for(idx=0;idx<LedPortsNum;idx++)
+	{
+		Local_pTable->StartSet[idx]=0;
+		Local_pTable->StartReset[idx]=0;
+	}
+	Local_pTable->EdgesNum=0;
+	for(idx=0;idx<_LED_NUM;idx++)
+	{
+		if(!((LedPwmMask>>idx)&0x01))
+		{
+			continue;
+		}
+		Local_Pin=(1<<LEDS[idx].Pin);
+		Local_Port=LedPortOf[idx];
+		Local_Duty=LedPwmDuty[idx];
+		/* on at the start of the period unless the duty is 0, the active low LEDs are on when low */
+		if((Local_Duty!=0)^(LEDS[idx].Connection==LED_ACTIVE_LOW))
+		{
+			Local_pTable->StartSet[Local_Port]|=Local_Pin;
+		}
+		else
+		{
+			Local_pTable->StartReset[Local_Port]|=Local_Pin;
+		}
+		if((Local_Duty==0)||(Local_Duty==LED_PWM_STEPS))
+		{
+			/* no edge, the LED keeps its start level for the whole period */
+			continue;
+		}
+		/* find the edge of the duty, or insert it to keep the edges sorted */
+		for(Local_Edge=0;(Local_Edge<Local_pTable->EdgesNum)&&(Local_pTable->Edges[Local_Edge].Step<Local_Duty);Local_Edge++);
+		if((Local_Edge==Local_pTable->EdgesNum)||(Local_pTable->Edges[Local_Edge].Step!=Local_Duty))
+		{
+			for(idk=Local_pTable->EdgesNum;idk>Local_Edge;idk--)
+			{
+				Local_pTable->Edges[idk]=Local_pTable->Edges[idk-1];
+			}
+			Local_pTable->EdgesNum++;
+			Local_pTable->Edges[Local_Edge].Step=Local_Duty;
+			for(idk=0;idk<LedPortsNum;idk++)
+			{
+				Local_pTable->Edges[Local_Edge].Set[idk]=0;
+				Local_pTable->Edges[Local_Edge].Reset[idk]=0;
+			}
+		}
+		if(LEDS[idx].Connection==LED_ACTIVE_LOW)
+		{
+			Local_pTable->Edges[Local_Edge].Set[Local_Port]|=Local_Pin;
+		}
+		else
+		{
+			Local_pTable->Edges[Local_Edge].Reset[Local_Port]|=Local_Pin;
+		}
+	}
+	/* publish the table, the one given back is free since the interrupt takes the fresh one */
+	LedPwmBack=ATOMIC_EXCHANGE(LedPwmMiddle,(u8)(LedPwmBack|LED_PWM_FRESH))&~LED_PWM_FRESH;
+}
+
+tenu_ErrorStatus HLED_SeqPlay(u8 Copy_Track, const LEDPattern_tstr * ADD_Pattern)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	if(Copy_Track>=LED_SEQ_TRACKS)
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else if((ADD_Pattern!=NULL)&&((ADD_Pattern->Steps==NULL)||(ADD_Pattern->StepsNum==0)))
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		LedSeqTracks[Copy_Track].Pattern=ADD_Pattern;
+		LedSeqTracks[Copy_Track].Start=1;
+		if(LedSeqWake!=NULL)
+		{
+			LedSeqWake();
+		}
+	}
+
+	return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus HLED_SeqSetWakeCallBack(LED_SeqWakeCBF_t Copy_CallBack)
+{
+	LedSeqWake=Copy_CallBack;
+	return LBTY_OK;
+}
+
+u32 HLED_SeqUpdate(u32 Copy_NowMs)
+{
+	u32 Local_Delay=LED_SEQ_IDLE;
+	LED_SeqTrack_tstr * Local_pTrack;
+	const LEDPattern_tstr * Local_pPattern;
+	u8 Local_Show;
+	for(u8 idx=0;idx<LED_SEQ_TRACKS;idx++)
+	{
+		Local_pTrack=&LedSeqTracks[idx];
+		Local_Show=0;
+		if(Local_pTrack->Pattern==NULL)
+		{
+			continue;
+		}
+		if(Local_pTrack->Start)
+		{
+			Local_pTrack->Start=0;
+			Local_pTrack->Step=0;
+			Local_pTrack->LoopsLeft=Local_pTrack->Pattern->Loops;
+			Local_pTrack->DueMs=Copy_NowMs+Local_pTrack->Pattern->Steps[0].DurationMs;
+			Local_Show=1;
+		}
+		/* go through the steps that ended, only the last one is shown */
+		while((Local_pTrack->Pattern!=NULL)&&((s32)(Copy_NowMs-Local_pTrack->DueMs)>=0))
+		{
+			Local_pTrack->Step++;
+			if(Local_pTrack->Step==Local_pTrack->Pattern->StepsNum)
+			{
+				Local_pTrack->Step=0;
+				if(Local_pTrack->Pattern->Loops!=0)
+				{
+					Local_pTrack->LoopsLeft--;
+					if(Local_pTrack->LoopsLeft==0)
+					{
+						/* chain the next pattern, a pattern without steps stops the track like NULL */
+						Local_pPattern=Local_pTrack->Pattern->Next;
+						if((Local_pPattern!=NULL)&&((Local_pPattern->Steps==NULL)||(Local_pPattern->StepsNum==0)))
+						{
+							Local_pPattern=NULL;
+						}
+						Local_pTrack->Pattern=Local_pPattern;
+						if(Local_pPattern!=NULL)
+						{
+							Local_pTrack->LoopsLeft=Local_pPattern->Loops;
+						}
+					}
+				}
+			}
+			if(Local_pTrack->Pattern!=NULL)
+			{
+				/* a step of 0 ms would never end the loop, it is shown for 1 ms */
+				Local_pTrack->DueMs+=Local_pTrack->Pattern->Steps[Local_pTrack->Step].DurationMs?
+						Local_pTrack->Pattern->Steps[Local_pTrack->Step].DurationMs:1;
+				Local_Show=1;
+			}
+		}
+		if(Local_pTrack->Pattern!=NULL)
+		{
+			if(Local_Show)
+			{
+				HLED_SetFrameMasked(Local_pTrack->Pattern->Mask,Local_pTrack->Pattern->Steps[Local_pTrack->Step].Frame);
+			}
+			if((Local_pTrack->DueMs-Copy_NowMs)<Local_Delay)
+			{
+				Local_Delay=Local_pTrack->DueMs-Copy_NowMs;
+			}
+		}
+	}
+	return Local_Delay;
+}
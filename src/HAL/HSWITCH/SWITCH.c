@@ -12,60 +12,165 @@
 #include "HSWITCH/SWITCH.h"
 #include "MGPIO/GPIO.h"
 #include "MRCC/RCC.h"
-#define THRESHOLD        5  
-
+#include "Atomic.h"
+#if _NUM_SWITCH > 32
+#error "HSWITCH_GetEdges reports the switches in a u32, _NUM_SWITCH must not exceed 32"
+#endif
 
+/* One debouncer per GPIO port, every switch of the port is a bit lane of the 16-bit words below.
+ * Vertical counter: Count1:Count0 is a 2-bit counter per lane, it counts the samples that differ
+ * from the debounced State and is cleared by any sample that agrees with it. When it wraps after
+ * 4 differing samples (20 ms at the 5 ms period) the lane toggles. The cost of a tick is one IDR
+ * read and a few logic operations per port, whatever the number of switches. */
+typedef struct
+{
+	void * Port;
+	u16 PinMask;           // Pins of the port used by switches
+	u16 PolarityMask;      // Pins of pull down switches (pressed when high), from MODE>>SWITCH_OFFSET_4
+	u16 State;             // Debounced pin levels
+	u16 Count0;            // Vertical counter, bit 0 of each lane
+	u16 Count1;            // Vertical counter, bit 1 of each lane
+	volatile u16 PressEdges;   // Lanes that became pressed since the last HSWITCH_GetEdges
+	volatile u16 ReleaseEdges; // Lanes that became released since the last HSWITCH_GetEdges
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+	volatile u8 Edge;      // Set from the EXTI interrupt, cleared by the runnable when it starts debouncing
+	u8 Active;             // The port is sampled until its lanes are stable again
+#endif
+}SWITCH_Port_tstr;
 
 extern const SWITCH_tstr SWITCH[_NUM_SWITCH];
-static u8 SwitchState[_NUM_SWITCH];
+static SWITCH_Port_tstr SwitchPorts[_NUM_SWITCH]; // At most one port per switch
+static u8 SwitchPortsNum=0;
+static u8 SwitchPortOf[_NUM_SWITCH]; // Index in SwitchPorts of each switch
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+static void HSWITCH_EdgeCallBack(u8 Copy_Line);
+#endif
 void HSWITCH_Runnable(void);
  
 tenu_ErrorStatus HSWITCH_Init(void)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+	tenu_ErrorStatus Local_EXTIStatus;
+#endif
 	// MRCC_ControlClockAHP1Peripheral(RCC_AHB1_GPIOA,RCC_ENABLE);
 	GPIO_Pin_tstr Switch_Pin;
+	u8 Local_Port=0;
 	Switch_Pin.Speed=GPIO_SPEED_HIGH;
+	SwitchPortsNum=0;
 	for(u8 idk=0;idk<_NUM_SWITCH;idk++)
 	{
+		if(SWITCH[idk].PORT==NULL)
+		{
+			continue;
+		}
 		Switch_Pin.Mode=SWITCH[idk].MODE;
 		Switch_Pin.Pin=SWITCH[idk].PIN;
 		Switch_Pin.Port=SWITCH[idk].PORT;
 		MGPIO_InitPin(&Switch_Pin);
+		/* group the switch with the others of its port */
+		for(Local_Port=0;(Local_Port<SwitchPortsNum)&&(SwitchPorts[Local_Port].Port!=SWITCH[idk].PORT);Local_Port++);
+		if(Local_Port==SwitchPortsNum)
+		{
+			SwitchPortsNum++;
+			SwitchPorts[Local_Port].Port=SWITCH[idk].PORT;
+			SwitchPorts[Local_Port].PinMask=0;
+			SwitchPorts[Local_Port].PolarityMask=0;
+		}
+		SwitchPortOf[idk]=Local_Port;
+		SwitchPorts[Local_Port].PinMask|=(1<<SWITCH[idk].PIN);
+		if((SWITCH[idk].MODE>>SWITCH_OFFSET_4)&0x01)
+		{
+			SwitchPorts[Local_Port].PolarityMask|=(1<<SWITCH[idk].PIN);
+		}
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+		/* LBTY_Busy is passed up as is, the line belongs to another module */
+		Local_EXTIStatus=MGPIO_ConfigEXTI(SWITCH[idk].PORT,SWITCH[idk].PIN,GPIO_EXTI_BOTH,HSWITCH_EdgeCallBack);
+		if(Local_EXTIStatus!=LBTY_OK)
+		{
+			Local_ErrorStatus=Local_EXTIStatus;
+		}
+#endif
+	}
+	for(Local_Port=0;Local_Port<SwitchPortsNum;Local_Port++)
+	{
+		/* start from the released level, a switch held at reset gives a press edge once debounced */
+		SwitchPorts[Local_Port].State=SwitchPorts[Local_Port].PolarityMask^SwitchPorts[Local_Port].PinMask;
+		SwitchPorts[Local_Port].Count0=0;
+		SwitchPorts[Local_Port].Count1=0;
+		SwitchPorts[Local_Port].PressEdges=0;
+		SwitchPorts[Local_Port].ReleaseEdges=0;
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+		SwitchPorts[Local_Port].Edge=1;
+		SwitchPorts[Local_Port].Active=0;
+#endif
 	}
 	return Local_ErrorStatus;
 }
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+/**
+ * @brief EXTI callback, marks the port of the line that fired for debouncing.
+ */
+static void HSWITCH_EdgeCallBack(u8 Copy_Line)
+{
+	for (u8 idx=0 ; idx<SwitchPortsNum ; idx++)
+	{
+		if((SwitchPorts[idx].PinMask>>Copy_Line)&0x01)
+		{
+			SwitchPorts[idx].Edge=1;
+		}
+	}
+}
+#endif
 /**
  * @brief Runnable function to handle switch state changes.
  *
- * This function is periodically called to monitor the state changes of each switch.
- * It checks the current state of each switch, compares it with the previous state,
- * and updates the switch counts accordingly. If the count reaches a threshold (5),
- * it updates the switch state and resets the count.
+ * This function is periodically called to debounce all the switches. Each port is read once
+ * and all its switches go through the vertical counter together; a switch changes state after
+ * 4 consecutive samples at the new level, and the change is latched in the press/release edge masks.
+ * In SWITCH_MODE_EXTI only the ports that had an edge are read, until their switches settle,
+ * so the runnable returns without touching the ports while the inputs are idle.
  */
 
 void HSWITCH_Runnable(void)
 {
-	u8 Local_Current;
-	static u8 Local_Prev[_NUM_SWITCH]={0};
-	static u8 Local_Counts[_NUM_SWITCH]={0};
-	for (u8 idx=0 ; idx<_NUM_SWITCH ; idx++)
+	u16 Local_Delta;
+	u16 Local_Toggle;
+	u16 Local_Pressed;
+	SWITCH_Port_tstr * Local_pPort;
+	for (u8 idx=0 ; idx<SwitchPortsNum ; idx++)
 	{
-		MGPIO_GetPinState(SWITCH[idx].PORT,SWITCH[idx].PIN,&Local_Current);
-		if(Local_Current==Local_Prev[idx])
+		Local_pPort=&SwitchPorts[idx];
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+		if(Local_pPort->Edge)
+		{
+			Local_pPort->Edge=0;
+			Local_pPort->Active=1;
+		}
+		if(!Local_pPort->Active)
 		{
-			Local_Counts[idx]++;
+			continue;
 		}
-		else
+#endif
+		Local_Delta=(MGPIO_FastReadPort(Local_pPort->Port)^Local_pPort->State)&Local_pPort->PinMask;
+		/* lanes that agree with the state are cleared, the others count up and toggle on the wrap */
+		Local_pPort->Count1=(Local_pPort->Count1^Local_pPort->Count0)&Local_Delta;
+		Local_pPort->Count0=(~Local_pPort->Count0)&Local_Delta;
+		Local_Toggle=Local_Delta&~(Local_pPort->Count0|Local_pPort->Count1);
+		if(Local_Toggle)
 		{
-			Local_Counts[idx]=0;
+			Local_pPort->State^=Local_Toggle;
+			Local_Pressed=~(Local_pPort->State^Local_pPort->PolarityMask);
+			ATOMIC_SET_BITS(Local_pPort->PressEdges,(u16)(Local_Toggle&Local_Pressed));
+			ATOMIC_SET_BITS(Local_pPort->ReleaseEdges,(u16)(Local_Toggle&~Local_Pressed));
 		}
-		if(Local_Counts[idx]==THRESHOLD)
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+		if((Local_pPort->Count0|Local_pPort->Count1)==0)
 		{
-			SwitchState[idx]=Local_Current;
-			Local_Counts[idx]=0;
+			/* stable, sleep until the next edge */
+			Local_pPort->Active=0;
 		}
-		Local_Prev[idx]=Local_Current;
+#endif
 	}
 
 
@@ -73,11 +178,50 @@ void HSWITCH_Runnable(void)
 tenu_ErrorStatus HSWITCH_GetSwitchStatus(u8 Copy_SwitchName, u8 *ADD_SwitchStatus)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
-	if(ADD_SwitchStatus==NULL||Copy_SwitchName>_NUM_SWITCH)
+	u8 Local_Level;
+	if(ADD_SwitchStatus==NULL||Copy_SwitchName>=_NUM_SWITCH||SWITCH[Copy_SwitchName].PORT==NULL)
 	{
 		Local_ErrorStatus=LBTY_NOK;
 	}
-	*ADD_SwitchStatus=!(SwitchState[Copy_SwitchName]^(SWITCH[Copy_SwitchName].MODE>>SWITCH_OFFSET_4));
+	else
+	{
+		Local_Level=(SwitchPorts[SwitchPortOf[Copy_SwitchName]].State>>SWITCH[Copy_SwitchName].PIN)&0x01;
+		*ADD_SwitchStatus=!(Local_Level^(SWITCH[Copy_SwitchName].MODE>>SWITCH_OFFSET_4));
+	}
 
 	return Local_ErrorStatus;
 }
+tenu_ErrorStatus HSWITCH_GetEdges(u32 *ADD_PressMask, u32 *ADD_ReleaseMask)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u16 Local_Press[_NUM_SWITCH];
+	u16 Local_Release[_NUM_SWITCH];
+	u8 idx;
+	if(ADD_PressMask==NULL||ADD_ReleaseMask==NULL)
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		for(idx=0;idx<SwitchPortsNum;idx++)
+		{
+			/* take the edges of the port and clear them, the bits taken are only cleared if still set */
+			Local_Press[idx]=SwitchPorts[idx].PressEdges;
+			Local_Release[idx]=SwitchPorts[idx].ReleaseEdges;
+			ATOMIC_CLR_BITS(SwitchPorts[idx].PressEdges,Local_Press[idx]);
+			ATOMIC_CLR_BITS(SwitchPorts[idx].ReleaseEdges,Local_Release[idx]);
+		}
+		*ADD_PressMask=0;
+		*ADD_ReleaseMask=0;
+		for(idx=0;idx<_NUM_SWITCH;idx++)
+		{
+			if(SWITCH[idx].PORT==NULL)
+			{
+				continue;
+			}
+			*ADD_PressMask|=(u32)((Local_Press[SwitchPortOf[idx]]>>SWITCH[idx].PIN)&0x01)<<idx;
+			*ADD_ReleaseMask|=(u32)((Local_Release[SwitchPortOf[idx]]>>SWITCH[idx].PIN)&0x01)<<idx;
+		}
+	}
+	return Local_ErrorStatus;
+}
@@ -9,17 +9,30 @@
  **************************************************************************************************************/
 #include "STD_TYPES.h"
 #include "MGPIO/GPIO.h"
+#include "MRCC/RCC.h"
+#include "MNVIC/MNVIC.h"
+#include "Bit_Band.h"
 
-#define GPIO_BSRR_RESET_OFFSET      0x00000010
 #define GPIO_4_BIT_MASK             0x0000000F
 #define GPIO_PIN_OFFSET_4           0x00000004 
+#define GPIO_PORT_ADD_STEP          0x00000400
+
+/* Port and callback owning every EXTI line */
+static void* GPIO_EXTIPort[GPIO_EXTI_LINES_NUM];
+static GPIO_EXTICallBack_t GPIO_EXTICallBack[GPIO_EXTI_LINES_NUM];
+/* Pins of every port set up by MGPIO_InitPin or MGPIO_InitPinAF, each one holds a reference on the port clock */
+static u16 GPIO_ClaimedPins[GPIO_PORTS_NUM];
+
+static tenu_ErrorStatus GPIO_ClaimPin(void* Copy_Port, u8 Copy_Pin);
+static u8 GPIO_GetEXTIIRQ(u8 Copy_Line);
+static void GPIO_EXTIDispatch(u32 Copy_LinesMask);
 
 /************************************Function Initializes the Pin************************************/
 tenu_ErrorStatus MGPIO_InitPin(GPIO_Pin_tstr* ADD_PinCfg)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
 	u32 Local_Temp=0X0;
-	if (ADD_PinCfg->Pin>GPIO_PIN_15||ADD_PinCfg->Port==NULL)
+	if (ADD_PinCfg->Pin>GPIO_PIN_15||ADD_PinCfg->Port==NULL||GPIO_ClaimPin(ADD_PinCfg->Port,ADD_PinCfg->Pin)!=LBTY_OK)
 	{
 		Local_ErrorStatus=LBTY_NOK;
 	}
@@ -58,7 +71,8 @@ tenu_ErrorStatus MGPIO_InitPinAF(GPIO_Pin_tstr* ADD_PinCfg)
 {
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
 	u32 Local_Temp=0X0;
-	if (ADD_PinCfg->Pin>GPIO_PIN_15||ADD_PinCfg->Port==NULL)
+	u8 Local_AFIndex=0;
+	if (ADD_PinCfg->Pin>GPIO_PIN_15||ADD_PinCfg->Port==NULL||GPIO_ClaimPin(ADD_PinCfg->Port,ADD_PinCfg->Pin)!=LBTY_OK)
 	{
 		Local_ErrorStatus=LBTY_NOK;
 	}
@@ -83,11 +97,12 @@ tenu_ErrorStatus MGPIO_InitPinAF(GPIO_Pin_tstr* ADD_PinCfg)
 
 		if(ADD_PinCfg->Pin>7)
 		{
-			ADD_PinCfg->Pin-=8;
+			/* AFRH field of the pin, the caller's configuration stays untouched */
+			Local_AFIndex=ADD_PinCfg->Pin-8;
 		
         Local_Temp = ((GPIO_Reg *)(ADD_PinCfg->Port))->AFRH;
-        Local_Temp &= ~( (GPIO_4_BIT_MASK) << (ADD_PinCfg->Pin*GPIO_PIN_OFFSET_4) );
-        Local_Temp |= ( (ADD_PinCfg->AF) << (ADD_PinCfg->Pin*GPIO_PIN_OFFSET_4) );
+        Local_Temp &= ~( (GPIO_4_BIT_MASK) << (Local_AFIndex*GPIO_PIN_OFFSET_4) );
+        Local_Temp |= ( (ADD_PinCfg->AF) << (Local_AFIndex*GPIO_PIN_OFFSET_4) );
         ((GPIO_Reg *)(ADD_PinCfg->Port))->AFRH = Local_Temp;
 		}
 		else
@@ -106,6 +121,30 @@ tenu_ErrorStatus MGPIO_InitPinAF(GPIO_Pin_tstr* ADD_PinCfg)
 
 	return Local_ErrorStatus;
 }
+/************************************Function Deinitializes the Pin************************************/
+tenu_ErrorStatus MGPIO_DeinitPin(void* Copy_Port, u8 Copy_Pin)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_PortIndex=((u32)Copy_Port-GPIOA_BASE_ADD)/GPIO_PORT_ADD_STEP;
+	if (Copy_Pin>GPIO_PIN_15||Copy_Port==NULL||Local_PortIndex>=GPIO_PORTS_NUM)
+	{
+		Local_ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else if ((GPIO_ClaimedPins[Local_PortIndex]&(1U<<Copy_Pin))==0)
+	{
+		/* not set up by MGPIO_InitPin, there is no reference to give back */
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		/* analog without pull draws the least current */
+		((GPIO_Reg*)Copy_Port)->PUPDR&=~(GPIO_CLEAR_MASK<<(Copy_Pin*GPIO_PIN_OFFSET_2));
+		((GPIO_Reg*)Copy_Port)->MODER|=(GPIO_CLEAR_MASK<<(Copy_Pin*GPIO_PIN_OFFSET_2));
+		GPIO_ClaimedPins[Local_PortIndex]&=~(1U<<Copy_Pin);
+		Local_ErrorStatus=MRCC_ReleaseClock(RCC_AHB1,1UL<<Local_PortIndex);
+	}
+	return Local_ErrorStatus;
+}
 /************************************Function Set the Pin*****************************************/
 tenu_ErrorStatus MGPIO_SetPin(void* Copy_Port, u8 Copy_Pin, u8 Copy_State)
 {
@@ -119,10 +158,10 @@ tenu_ErrorStatus MGPIO_SetPin(void* Copy_Port, u8 Copy_Pin, u8 Copy_State)
 		switch(Copy_State)
 		{
 		    case GPIO_High:
-		        ((GPIO_Reg*)Copy_Port)->BSRR|=(1<<Copy_Pin);
+		        ((GPIO_Reg*)Copy_Port)->BSRR=(1<<Copy_Pin);
 		    	 break;
 		    case GPIO_Low:
-		    	((GPIO_Reg*)Copy_Port)->BSRR|=(1<<(Copy_Pin+GPIO_BSRR_RESET_OFFSET));
+		    	((GPIO_Reg*)Copy_Port)->BSRR=(1<<(Copy_Pin+GPIO_BSRR_RESET_OFFSET));
 		    	break;
 		    default:
 		    	Local_ErrorStatus=LBTY_NOK;
@@ -144,7 +183,8 @@ tenu_ErrorStatus MGPIO_TogglePin(void* Copy_Port, u8 Copy_Pin)
 	}
 	else
 	{
-		 ((GPIO_Reg*)Copy_Port)->ODR^=(1<<Copy_Pin);
+		/* BSRR store computed from ODR, doesn't write back the other pins of the port */
+		MGPIO_FastTogglePin(Copy_Port,Copy_Pin);
 
 
 	}
@@ -161,9 +201,225 @@ tenu_ErrorStatus MGPIO_GetPinState(void* Copy_Port, u8 Copy_Pin, u8 * ADD_State)
 		}
 		else
 		{
-			*ADD_State= ((((GPIO_Reg*)Copy_Port)->IDR >> Copy_Pin)&0x01);
+			*ADD_State= MGPIO_FastReadPin(Copy_Port,Copy_Pin);
 		}
 
 
 	return Local_ErrorStatus;
 }
+/************************************Function Set the Pins Mode****************************************/
+tenu_ErrorStatus MGPIO_SetPinsMode(void* Copy_Port, u16 Copy_PinMask, u32 Copy_Mode)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_Spread=Copy_PinMask;
+	u32 Local_Temp=0X0;
+	if (Copy_Port==NULL)
+	{
+		Local_ErrorStatus=LBTY_ErrorNullPointer;
+	}
+	else
+	{
+		/* spread the 16 pin bits to the low bit of each 2 bit MODER field */
+		Local_Spread=(Local_Spread|(Local_Spread<<8))&0x00FF00FF;
+		Local_Spread=(Local_Spread|(Local_Spread<<4))&0x0F0F0F0F;
+		Local_Spread=(Local_Spread|(Local_Spread<<2))&0x33333333;
+		Local_Spread=(Local_Spread|(Local_Spread<<1))&0x55555555;
+		Local_Temp=((GPIO_Reg*)Copy_Port)->MODER;
+		Local_Temp&=~(Local_Spread*GPIO_CLEAR_MASK);
+		Local_Temp|=(Local_Spread*(Copy_Mode&GPIO_MODE_MASK));
+		((GPIO_Reg*)Copy_Port)->MODER=Local_Temp;
+	}
+
+	return Local_ErrorStatus;
+}
+/************************************Function Configure the Pin EXTI************************************/
+tenu_ErrorStatus MGPIO_ConfigEXTI(void* Copy_Port, u8 Copy_Pin, u8 Copy_Edge, GPIO_EXTICallBack_t Copy_CallBack)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_Temp=0X0;
+	u32 Local_PortIndex=((u32)Copy_Port-GPIOA_BASE_ADD)/GPIO_PORT_ADD_STEP;
+	u8 Local_RegIndex=0;
+	u8 Local_FieldOffset=0;
+	if (Copy_Port==NULL || Copy_CallBack==NULL)
+	{
+		Local_ErrorStatus=LBTY_ErrorNullPointer;
+	}
+	else if (Copy_Pin>GPIO_PIN_15 || Copy_Edge<GPIO_EXTI_RISING || Copy_Edge>GPIO_EXTI_BOTH ||
+			Local_PortIndex>=GPIO_PORTS_NUM)
+	{
+		/* a port outside GPIOA..GPIOH would write past the 4 bits of its EXTICR field */
+		Local_ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else if (GPIO_EXTICallBack[Copy_Pin]!=NULL &&
+			(GPIO_EXTIPort[Copy_Pin]!=Copy_Port || GPIO_EXTICallBack[Copy_Pin]!=Copy_CallBack))
+	{
+		/* the line is already routed to another port or owned by another module */
+		Local_ErrorStatus=LBTY_Busy;
+	}
+	else
+	{
+		if (GPIO_EXTICallBack[Copy_Pin]==NULL)
+		{
+			/* one SYSCFG reference per owned line */
+			MRCC_AcquireClock(RCC_APB2,RCC_APB2_SYSCFG);
+		}
+
+		/* mask the line while it is reconfigured */
+		BITBAND_CLR_BIT(EXTI->IMR,Copy_Pin);
+		GPIO_EXTIPort[Copy_Pin]=Copy_Port;
+		GPIO_EXTICallBack[Copy_Pin]=Copy_CallBack;
+
+		Local_RegIndex=Copy_Pin/GPIO_EXTICR_LINES_PER_REG;
+		Local_FieldOffset=(Copy_Pin%GPIO_EXTICR_LINES_PER_REG)*GPIO_PIN_OFFSET_4;
+		Local_Temp=SYSCFG->EXTICR[Local_RegIndex];
+		Local_Temp&=~(GPIO_EXTICR_FIELD_MASK<<Local_FieldOffset);
+		Local_Temp|=(Local_PortIndex<<Local_FieldOffset);
+		SYSCFG->EXTICR[Local_RegIndex]=Local_Temp;
+
+		if (Copy_Edge&GPIO_EXTI_RISING)
+		{
+			EXTI->RTSR|=(1UL<<Copy_Pin);
+		}
+		else
+		{
+			EXTI->RTSR&=~(1UL<<Copy_Pin);
+		}
+		if (Copy_Edge&GPIO_EXTI_FALLING)
+		{
+			EXTI->FTSR|=(1UL<<Copy_Pin);
+		}
+		else
+		{
+			EXTI->FTSR&=~(1UL<<Copy_Pin);
+		}
+
+		MGPIO_EnableEXTI(Copy_Pin);
+		MNVIC_EnableInterrupt(GPIO_GetEXTIIRQ(Copy_Pin));
+	}
+
+	return Local_ErrorStatus;
+}
+/************************************Function Enable the Pin EXTI*************************************/
+tenu_ErrorStatus MGPIO_EnableEXTI(u8 Copy_Pin)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	if (Copy_Pin>GPIO_PIN_15)
+	{
+		Local_ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else
+	{
+		/* PR is write 1 to clear, so this doesn't touch the other lines */
+		EXTI->PR=(1UL<<Copy_Pin);
+		BITBAND_SET_BIT(EXTI->IMR,Copy_Pin);
+	}
+
+	return Local_ErrorStatus;
+}
+/************************************Function Disable the Pin EXTI************************************/
+tenu_ErrorStatus MGPIO_DisableEXTI(u8 Copy_Pin)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	if (Copy_Pin>GPIO_PIN_15)
+	{
+		Local_ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else
+	{
+		BITBAND_CLR_BIT(EXTI->IMR,Copy_Pin);
+	}
+
+	return Local_ErrorStatus;
+}
+/*************************************************************************************************/
+/* Takes a reference on the port clock the first time a pin of it is set up, the clock runs before the registers are written */
+static tenu_ErrorStatus GPIO_ClaimPin(void* Copy_Port, u8 Copy_Pin)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_PortIndex=((u32)Copy_Port-GPIOA_BASE_ADD)/GPIO_PORT_ADD_STEP;
+	if (Local_PortIndex>=GPIO_PORTS_NUM)
+	{
+		Local_ErrorStatus=LBTY_ErrorInvalidInput;
+	}
+	else if ((GPIO_ClaimedPins[Local_PortIndex]&(1U<<Copy_Pin))==0)
+	{
+		Local_ErrorStatus=MRCC_AcquireClock(RCC_AHB1,1UL<<Local_PortIndex);
+		if (Local_ErrorStatus==LBTY_OK)
+		{
+			GPIO_ClaimedPins[Local_PortIndex]|=(1U<<Copy_Pin);
+		}
+	}
+	return Local_ErrorStatus;
+}
+
+static u8 GPIO_GetEXTIIRQ(u8 Copy_Line)
+{
+	u8 Local_IRQ=NVIC_IRQ_EXTI15_10;
+	if (Copy_Line<=GPIO_PIN_4)
+	{
+		Local_IRQ=NVIC_IRQ_EXTI0+Copy_Line;
+	}
+	else if (Copy_Line<=GPIO_PIN_9)
+	{
+		Local_IRQ=NVIC_IRQ_EXTI9;
+	}
+	return Local_IRQ;
+}
+/*************************************************************************************************/
+static void GPIO_EXTIDispatch(u32 Copy_LinesMask)
+{
+	u32 Local_Pending=EXTI->PR&EXTI->IMR&Copy_LinesMask;
+	u8 Local_Line=0;
+	/* acknowledge only the lines being served, edges arriving after this are kept pending */
+	EXTI->PR=Local_Pending;
+	for (Local_Line=0;Local_Pending!=0;Local_Line++,Local_Pending>>=1)
+	{
+		if ((Local_Pending&0x01) && GPIO_EXTICallBack[Local_Line]!=NULL)
+		{
+			GPIO_EXTICallBack[Local_Line](Local_Line);
+		}
+	}
+}
+/*************************************************************************************************/
+void EXTI0_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI0);
+	GPIO_EXTIDispatch(1UL<<GPIO_PIN_0);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI0);
+}
+void EXTI1_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI1);
+	GPIO_EXTIDispatch(1UL<<GPIO_PIN_1);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI1);
+}
+void EXTI2_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI2);
+	GPIO_EXTIDispatch(1UL<<GPIO_PIN_2);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI2);
+}
+void EXTI3_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI3);
+	GPIO_EXTIDispatch(1UL<<GPIO_PIN_3);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI3);
+}
+void EXTI4_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI4);
+	GPIO_EXTIDispatch(1UL<<GPIO_PIN_4);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI4);
+}
+void EXTI9_5_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI9);
+	GPIO_EXTIDispatch(GPIO_EXTI_9_5_MASK);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI9);
+}
+void EXTI15_10_IRQHandler(void)
+{
+	NVIC_ISR_ENTER(NVIC_IRQ_EXTI15_10);
+	GPIO_EXTIDispatch(GPIO_EXTI_15_10_MASK);
+	NVIC_ISR_EXIT(NVIC_IRQ_EXTI15_10);
+}
@@ -0,0 +1,70 @@
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "MNVIC/MNVIC.h"
+#include "FreeRTOSConfig.h"
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#if NVIC_GROUP_SUP_DIST!=GROUP_4_BIT_SUB_0_BIT
+#error "FreeRTOS needs all the priority bits as preemption bits, NVIC_GROUP_SUP_DIST must be GROUP_4_BIT_SUB_0_BIT"
+#endif
+#if (NVIC_PRIO_DMA>=NVIC_PRIO_LEVELS)||(NVIC_PRIO_USART>=NVIC_PRIO_LEVELS)||(NVIC_PRIO_EXTI>=NVIC_PRIO_LEVELS)||(NVIC_PRIO_SYSTICK>=NVIC_PRIO_LEVELS)
+#error "the NVIC_PRIO_xxx levels must be 0..15"
+#endif
+/* FreeRTOS masks only the levels from its ceiling down, a handler above it could run inside a kernel critical section */
+#if (NVIC_DMA_RTOS==NVIC_RTOS_CALLS)&&(NVIC_PRIO_DMA<configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+#error "the DMA handlers call FreeRTOS, NVIC_PRIO_DMA must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY"
+#endif
+#if (NVIC_USART_RTOS==NVIC_RTOS_CALLS)&&(NVIC_PRIO_USART<configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+#error "the USART handlers call FreeRTOS, NVIC_PRIO_USART must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY"
+#endif
+#if (NVIC_EXTI_RTOS==NVIC_RTOS_CALLS)&&(NVIC_PRIO_EXTI<configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+#error "the EXTI handlers call FreeRTOS, NVIC_PRIO_EXTI must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY"
+#endif
+/* A latency-critical handler must preempt the bulk ones, a shared level would make it wait for them */
+#if (NVIC_PRIO_DMA>=NVIC_PRIO_EXTI)||(NVIC_PRIO_USART>=NVIC_PRIO_EXTI)
+#error "NVIC_PRIO_DMA and NVIC_PRIO_USART must be above (numerically below) NVIC_PRIO_EXTI"
+#endif
+#if (NVIC_PRIO_SYSTICK<NVIC_PRIO_EXTI)||(NVIC_PRIO_SYSTICK<configLIBRARY_LOWEST_INTERRUPT_PRIORITY)
+#error "SysTick must be the least urgent level, FreeRTOS sets it to configLIBRARY_LOWEST_INTERRUPT_PRIORITY"
+#endif
+
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+const NVIC_PriorityCfg_tstr NVIC_PriorityPlan[]={
+    /* latency-critical, transfer complete of the DMA streams */
+    {NVIC_IRQ_DMA1_STREAM0,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM1,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM2,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM3,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM4,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM5,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM6,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA1_STREAM7,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM0,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM1,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM2,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM3,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM4,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM5,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM6,NVIC_PRIO_DMA},
+    {NVIC_IRQ_DMA2_STREAM7,NVIC_PRIO_DMA},
+    /* latency-critical, a received byte is lost if it is not read before the next one */
+    {NVIC_IRQ_USART1,NVIC_PRIO_USART},
+    {NVIC_IRQ_USART2,NVIC_PRIO_USART},
+    {NVIC_IRQ_USART6,NVIC_PRIO_USART},
+    /* bulk, switches and keypad */
+    {NVIC_IRQ_EXTI0,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI1,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI2,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI3,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI4,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI9,NVIC_PRIO_EXTI},
+    {NVIC_IRQ_EXTI15_10,NVIC_PRIO_EXTI},
+};
+const u8 NVIC_PriorityPlanNum=sizeof(NVIC_PriorityPlan)/sizeof(NVIC_PriorityPlan[0]);
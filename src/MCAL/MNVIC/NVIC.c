@@ -11,6 +11,45 @@
 #define NVIC_BASE_ADDRESS  0xE000E100
 #define SCB_BASE_ADDRESS   0xE000ED00
 #define NVIC_OFFSET_4       4
+/* SysTick priority, byte 3 of SHPR3 */
+#define SCB_SHPR3_INDEX             2
+#define SCB_SHPR3_SYSTICK_OFFSET    28
+#define SCB_SHPR3_SYSTICK_MASK      0xFF000000
+/* Stack pointer and the 15 system exceptions come before the interrupts */
+#define NVIC_SYSTEM_VECTORS_NUM     16
+#define NVIC_VECTORS_NUM            (NVIC_SYSTEM_VECTORS_NUM+_NVIC_IRQ_NUM)
+/* VTOR needs the table aligned on its size rounded up to a power of 2 */
+#define NVIC_VECTORS_ALIGN          512
+#if NVIC_VECTORS_NUM*4>NVIC_VECTORS_ALIGN
+#error "NVIC_VECTORS_ALIGN must cover the whole vector table"
+#endif
+/* DWT cycle counter, enabled through the trace enable of DEMCR */
+#define DEMCR_ADDRESS               0xE000EDFC
+#define DEMCR_TRCENA                24
+#define DWT_CTRL_ADDRESS            0xE0001000
+#define DWT_CYCCNT_ADDRESS          0xE0001004
+#define DWT_CTRL_CYCCNTENA          0
+/* Handlers can only preempt a less urgent level, so no more than one per level are nested */
+#define NVIC_STATS_MAX_DEPTH        NVIC_PRIO_LEVELS
+
+#if defined(__arm__) || defined(__thumb__)
+#define NVIC_MASK_IRQ(PRIMASK)      __asm volatile("mrs %0, primask\n\tcpsid i":"=r"(PRIMASK)::"memory")
+#define NVIC_RESTORE_IRQ(PRIMASK)   __asm volatile("msr primask, %0"::"r"(PRIMASK):"memory")
+#define NVIC_DSB()                  __asm volatile("dsb":::"memory")
+#define NVIC_ISB()                  __asm volatile("isb":::"memory")
+#define NVIC_GET_IPSR(IPSR)         __asm volatile("mrs %0, ipsr":"=r"(IPSR))
+#define NVIC_CYCLES()               (*(volatile u32 *)DWT_CYCCNT_ADDRESS)
+#else
+/* Host builds run the statistics without interrupts, on NVIC_HostCycles and a PRIMASK kept in a variable */
+#define NVIC_MASK_IRQ(PRIMASK)      ((PRIMASK)=NVIC_HostPrimask,NVIC_HostPrimask=1)
+#define NVIC_RESTORE_IRQ(PRIMASK)   (NVIC_HostPrimask=(PRIMASK))
+#define NVIC_DSB()
+#define NVIC_ISB()
+#define NVIC_GET_IPSR(IPSR)         ((IPSR)=0)
+#define NVIC_CYCLES()               (NVIC_HostCycles)
+#endif
+/* Cycles since START, unsigned 32-bit difference so one wrap of the counter is measured right */
+#define NVIC_ELAPSED(START)         ((uint32_t)(NVIC_CYCLES()-(START)))
 
 /********************************************************************************************************/
 /************************************************Types***************************************************/
@@ -54,20 +93,62 @@ typedef struct
 } SCB_t;
 
 /*Pointers to NVIC and SCB structures, mapped to their respective base addresses.*/
+#if defined(__arm__) || defined(__thumb__)
 NVIC_t *const NVIC  = (NVIC_t *)NVIC_BASE_ADDRESS;
 SCB_t  *const SCB   = (SCB_t *)SCB_BASE_ADDRESS;
+#else
+/* Host builds have no core peripherals, the registers are kept in RAM where the tests can read them */
+static NVIC_t NVIC_HostRegs;
+static SCB_t  SCB_HostRegs;
+NVIC_t *const NVIC  = &NVIC_HostRegs;
+SCB_t  *const SCB   = &SCB_HostRegs;
+#endif
 
 
 
 /********************************************************************************************************/
 /************************************************Variables***********************************************/
 /********************************************************************************************************/
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+static volatile NVIC_Handler_t NVIC_RamVectors[NVIC_VECTORS_NUM] __attribute__((aligned(NVIC_VECTORS_ALIGN)));
+#endif
+#if !defined(__arm__) && !defined(__thumb__)
+volatile uint32_t NVIC_HostCycles=0;
+static u32 NVIC_HostPrimask=0;
+#endif
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+static NVIC_IrqStats_tstr NVIC_IrqStats[_NVIC_IRQ_NUM];
+/* Start of every nested handler and the cycles of the handlers that preempted it */
+static uint32_t NVIC_StatsStart[NVIC_STATS_MAX_DEPTH];
+static uint32_t NVIC_StatsNested[NVIC_STATS_MAX_DEPTH];
+static u8 NVIC_StatsDepth=0;
+static u8 NVIC_StatsMaxDepth=0;
+/* Outermost critical sections, nothing can preempt them so one start is enough */
+static NVIC_IrqStats_tstr NVIC_BlockedStats;
+static uint32_t NVIC_BlockedStart;
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+/* Handlers run by the wrapper, the RAM vectors of the interrupts all point to NVIC_StatsWrapper */
+static volatile NVIC_Handler_t NVIC_Handlers[_NVIC_IRQ_NUM];
+#endif
+#endif
 
 
 
 /********************************************************************************************************/
 /*****************************************Static Functions Prototype*************************************/
 /********************************************************************************************************/
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+/**
+ * @brief Copies the active vector table to NVIC_RamVectors and points VTOR to it, with interrupts masked.
+ */
+static void NVIC_RelocateVectors(void);
+#endif
+#if (NVIC_ISR_STATS==NVIC_STATS_ENABLE)&&(NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM)
+/**
+ * @brief Vector of every interrupt, measures the handler of the active interrupt read from IPSR.
+ */
+static void NVIC_StatsWrapper(void);
+#endif
 
 
 
@@ -76,8 +157,21 @@ SCB_t  *const SCB   = (SCB_t *)SCB_BASE_ADDRESS;
 /********************************************************************************************************/
 void MNVIC_Init()
 {
+    u8 Local_Index;
+#if (NVIC_ISR_STATS==NVIC_STATS_ENABLE)&&(defined(__arm__) || defined(__thumb__))
+    *(volatile u32 *)DEMCR_ADDRESS|=(1UL<<DEMCR_TRCENA);
+    *(volatile u32 *)DWT_CYCCNT_ADDRESS=0;
+    *(volatile u32 *)DWT_CTRL_ADDRESS|=(1UL<<DWT_CTRL_CYCCNTENA);
+#endif
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+    NVIC_RelocateVectors();
+#endif
     SCB->AIRCR=NVIC_GROUP_SUP_DIST;
-
+    for(Local_Index=0;Local_Index<NVIC_PriorityPlanNum;Local_Index++)
+    {
+        MNVIC_SetPriority(NVIC_PriorityPlan[Local_Index].InterruptID,NVIC_PriorityPlan[Local_Index].Priority);
+    }
+    SCB->SHPR[SCB_SHPR3_INDEX]=(SCB->SHPR[SCB_SHPR3_INDEX]&~SCB_SHPR3_SYSTICK_MASK)|((u32)NVIC_PRIO_SYSTICK<<SCB_SHPR3_SYSTICK_OFFSET);
 }
 tenu_ErrorStatus MNVIC_EnableInterrupt(u8 Copy_InterruptID){
     tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
@@ -180,7 +274,7 @@ tenu_ErrorStatus MNVIC_GetActiveStatus(u8 Copy_InterruptID,u8 * Add_Status){
 }
 tenu_ErrorStatus MNVIC_SetPriority(u8 Copy_InterruptID,u8 Copy_Priority){
     tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
-    if(Copy_InterruptID>=_NVIC_IRQ_NUM)
+    if(Copy_InterruptID>=_NVIC_IRQ_NUM || Copy_Priority>=NVIC_PRIO_LEVELS)
     {
         Local_ErrorStatus = LBTY_ErrorInvalidInput;
     }
@@ -205,3 +299,233 @@ tenu_ErrorStatus MNVIC_GenerateSWInterrupt(u8 Copy_InterruptID){
 
     return Local_ErrorStatus;
 }
+tenu_ErrorStatus MNVIC_SetHandler(u8 Copy_InterruptID,NVIC_Handler_t Copy_Handler,NVIC_Handler_t * ADD_OldHandler){
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    if(Copy_InterruptID>=_NVIC_IRQ_NUM)
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if(Copy_Handler==NULL)
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer;
+    }
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+    else if(SCB->VTOR!=(u32)NVIC_RamVectors)
+    {
+        Local_ErrorStatus = LBTY_NOK;
+    }
+    else
+    {
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+        volatile NVIC_Handler_t * Local_Slot=&NVIC_Handlers[Copy_InterruptID];
+#else
+        volatile NVIC_Handler_t * Local_Slot=&NVIC_RamVectors[NVIC_SYSTEM_VECTORS_NUM+Copy_InterruptID];
+#endif
+        if(ADD_OldHandler!=NULL)
+        {
+            *ADD_OldHandler=*Local_Slot;
+        }
+        /* one word store, the interrupt sees either the old or the new handler */
+        *Local_Slot=Copy_Handler;
+        NVIC_DSB();
+    }
+#else
+    else
+    {
+        /* the link-time table can't be changed, nothing is replaced */
+        (void)ADD_OldHandler;
+        Local_ErrorStatus = LBTY_NOK;
+    }
+#endif
+
+    return Local_ErrorStatus;
+}
+void MNVIC_StatsEnter(u8 Copy_InterruptID){
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    u32 Local_Primask;
+    NVIC_MASK_IRQ(Local_Primask);
+    if(NVIC_StatsDepth<NVIC_STATS_MAX_DEPTH)
+    {
+        NVIC_StatsNested[NVIC_StatsDepth]=0;
+        NVIC_StatsStart[NVIC_StatsDepth]=NVIC_CYCLES();
+    }
+    NVIC_StatsDepth++;
+    if(NVIC_StatsDepth>NVIC_StatsMaxDepth)
+    {
+        NVIC_StatsMaxDepth=NVIC_StatsDepth;
+    }
+    NVIC_RESTORE_IRQ(Local_Primask);
+#endif
+    (void)Copy_InterruptID;
+}
+void MNVIC_StatsExit(u8 Copy_InterruptID){
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    u32 Local_Primask;
+    uint32_t Local_Cycles;
+    uint32_t Local_OwnCycles;
+    NVIC_MASK_IRQ(Local_Primask);
+    if(NVIC_StatsDepth>0)
+    {
+        NVIC_StatsDepth--;
+        if((NVIC_StatsDepth<NVIC_STATS_MAX_DEPTH)&&(Copy_InterruptID<_NVIC_IRQ_NUM))
+        {
+            Local_Cycles=NVIC_ELAPSED(NVIC_StatsStart[NVIC_StatsDepth]);
+            Local_OwnCycles=Local_Cycles-NVIC_StatsNested[NVIC_StatsDepth];
+            NVIC_IrqStats[Copy_InterruptID].Count++;
+            NVIC_IrqStats[Copy_InterruptID].TotalCycles+=Local_OwnCycles;
+            if(Local_OwnCycles>NVIC_IrqStats[Copy_InterruptID].MaxCycles)
+            {
+                NVIC_IrqStats[Copy_InterruptID].MaxCycles=Local_OwnCycles;
+            }
+            if(NVIC_StatsDepth>0)
+            {
+                /* the whole handler, with its own nested ones, is taken out of the one it preempted */
+                NVIC_StatsNested[NVIC_StatsDepth-1]+=Local_Cycles;
+            }
+        }
+    }
+    NVIC_RESTORE_IRQ(Local_Primask);
+#endif
+    (void)Copy_InterruptID;
+}
+tenu_ErrorStatus MNVIC_GetIrqStats(u8 Copy_InterruptID,NVIC_IrqStats_tstr * ADD_Stats){
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    if(Copy_InterruptID>=_NVIC_IRQ_NUM)
+    {
+        Local_ErrorStatus = LBTY_ErrorInvalidInput;
+    }
+    else if(ADD_Stats==NULL)
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer;
+    }
+    else
+    {
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+        u32 Local_Primask;
+        NVIC_MASK_IRQ(Local_Primask);
+        *ADD_Stats=NVIC_IrqStats[Copy_InterruptID];
+        NVIC_RESTORE_IRQ(Local_Primask);
+#else
+        Local_ErrorStatus = LBTY_NOK;
+#endif
+    }
+
+    return Local_ErrorStatus;
+}
+u32 MNVIC_EnterCritical(void){
+    u32 Local_Primask;
+    NVIC_MASK_IRQ(Local_Primask);
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    if(Local_Primask==0)
+    {
+        NVIC_BlockedStart=NVIC_CYCLES();
+    }
+#endif
+    return Local_Primask;
+}
+void MNVIC_ExitCritical(u32 Copy_Primask){
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    uint32_t Local_Cycles;
+    if(Copy_Primask==0)
+    {
+        /* still masked here, the section is recorded before any interrupt can run */
+        Local_Cycles=NVIC_ELAPSED(NVIC_BlockedStart);
+        NVIC_BlockedStats.Count++;
+        NVIC_BlockedStats.TotalCycles+=Local_Cycles;
+        if(Local_Cycles>NVIC_BlockedStats.MaxCycles)
+        {
+            NVIC_BlockedStats.MaxCycles=Local_Cycles;
+        }
+    }
+#endif
+    NVIC_RESTORE_IRQ(Copy_Primask);
+}
+tenu_ErrorStatus MNVIC_GetBlockedStats(NVIC_IrqStats_tstr * ADD_Stats){
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    if(ADD_Stats==NULL)
+    {
+        Local_ErrorStatus = LBTY_ErrorNullPointer;
+    }
+    else
+    {
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+        u32 Local_Primask;
+        NVIC_MASK_IRQ(Local_Primask);
+        *ADD_Stats=NVIC_BlockedStats;
+        NVIC_RESTORE_IRQ(Local_Primask);
+#else
+        Local_ErrorStatus = LBTY_NOK;
+#endif
+    }
+
+    return Local_ErrorStatus;
+}
+u8 MNVIC_GetMaxPreemptionDepth(void){
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    return NVIC_StatsMaxDepth;
+#else
+    return 0;
+#endif
+}
+void MNVIC_ResetStats(void){
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    u32 Local_Primask;
+    u8 Local_Index;
+    NVIC_MASK_IRQ(Local_Primask);
+    for(Local_Index=0;Local_Index<_NVIC_IRQ_NUM;Local_Index++)
+    {
+        NVIC_IrqStats[Local_Index].Count=0;
+        NVIC_IrqStats[Local_Index].MaxCycles=0;
+        NVIC_IrqStats[Local_Index].TotalCycles=0;
+    }
+    NVIC_BlockedStats.Count=0;
+    NVIC_BlockedStats.MaxCycles=0;
+    NVIC_BlockedStats.TotalCycles=0;
+    /* the handlers running now stay counted in the depth */
+    NVIC_StatsMaxDepth=NVIC_StatsDepth;
+    NVIC_RESTORE_IRQ(Local_Primask);
+#endif
+}
+/********************************************************************************************************/
+/*********************************************Static Functions Implementation****************************/
+/********************************************************************************************************/
+#if NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM
+static void NVIC_RelocateVectors(void)
+{
+    NVIC_Handler_t * Local_FlashVectors=(NVIC_Handler_t *)SCB->VTOR;
+    u32 Local_Primask;
+    u8 Local_Index;
+    if(SCB->VTOR!=(u32)NVIC_RamVectors)
+    {
+        NVIC_MASK_IRQ(Local_Primask);
+        for(Local_Index=0;Local_Index<NVIC_VECTORS_NUM;Local_Index++)
+        {
+            NVIC_RamVectors[Local_Index]=Local_FlashVectors[Local_Index];
+        }
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+        for(Local_Index=0;Local_Index<_NVIC_IRQ_NUM;Local_Index++)
+        {
+            NVIC_Handlers[Local_Index]=Local_FlashVectors[NVIC_SYSTEM_VECTORS_NUM+Local_Index];
+            NVIC_RamVectors[NVIC_SYSTEM_VECTORS_NUM+Local_Index]=NVIC_StatsWrapper;
+        }
+#endif
+        NVIC_DSB();
+        SCB->VTOR=(u32)NVIC_RamVectors;
+        NVIC_DSB();
+        NVIC_ISB();
+        NVIC_RESTORE_IRQ(Local_Primask);
+    }
+}
+#endif
+#if (NVIC_ISR_STATS==NVIC_STATS_ENABLE)&&(NVIC_VECTOR_TABLE==NVIC_VECTORS_RAM)
+static void NVIC_StatsWrapper(void)
+{
+    u32 Local_IPSR;
+    u8 Local_IRQ;
+    NVIC_GET_IPSR(Local_IPSR);
+    Local_IRQ=(u8)(Local_IPSR-NVIC_SYSTEM_VECTORS_NUM);
+    MNVIC_StatsEnter(Local_IRQ);
+    NVIC_Handlers[Local_IRQ]();
+    MNVIC_StatsExit(Local_IRQ);
+}
+#endif
@@ -8,13 +8,16 @@
  *************************    Brief: This source file implements functions for RCC driver**********************.
  **************************************************************************************************************/
 
+#include <stdint.h>
 #include "STD_TYPES.h"
+#include "Bit_Math.h"
 
 
 #include "MRCC/RCC_Reg.h"
 #include "MRCC/RCC_Private.h"
 #include "MRCC/RCC_Cfg.h"
 #include "MRCC/RCC.h"
+#include "MNVIC/MNVIC.h"
 
 /**************************************Enable peripheral clk***********************************************/
 tenu_ErrorStatus MRCC_EnablePeripheralClock(u8 BusId,u8 PerId)
@@ -168,8 +171,8 @@ tenu_ErrorStatus MRCC_ControlClockABP1Peripheral(u32 APB1Peripheral,u8 Status)
 tenu_ErrorStatus MRCC_ControlClockABP2Peripheral(u32 APB2Peripheral,u8 Status)
 {
 	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
-	u32 Local_u32Temp=RCC_AHB1ENR;  /* Assign register to local value */
-		if(APB2Peripheral<=RCC_AHB1_DMA2) /*Check if Input Peripheral is valid or not */
+	u32 Local_u32Temp=RCC_APB2ENR;  /* Assign register to local value */
+		if(APB2Peripheral<=RCC_APB2_TIM11) /*Check if Input Peripheral is valid or not */
 		{
 			switch(Status)
 			{
@@ -547,3 +550,527 @@ tenu_ErrorStatus MRCC_SelectPLLNFactor(u32 PLLNFactor)
 
 
 
+
+/******************************Clock plan********************************************************************/
+/* Dividers of HPRE from 0b1000, and of PPRE1/PPRE2 from 0b100 */
+static const u16 RCC_AHBDividers[]={2,4,8,16,64,128,256,512};
+static const u16 RCC_APBDividers[]={2,4,8,16};
+
+/* CMSIS core clock, used by FreeRTOS (configCPU_CLOCK_HZ), same type as its declaration in FreeRTOSConfig.h */
+extern uint32_t SystemCoreClock;
+/* Frequencies of the current clock tree, reset values until the first update */
+static u32 RCC_SYSCLKHz=RCC_HSI_HZ;
+static u32 RCC_HCLKHz=RCC_HSI_HZ;
+static u32 RCC_PCLK1Hz=RCC_HSI_HZ;
+static u32 RCC_PCLK2Hz=RCC_HSI_HZ;
+static RCC_ClockCb_t RCC_ClockSubscribers[RCC_CLOCK_SUBSCRIBERS];
+static u8 RCC_ClockSubscribersNum=0;
+/* Users of every enable bit of AHB1, AHB2, APB1 and APB2 */
+static u8 RCC_ClockRefs[RCC_GATED_BUSES_NUM][RCC_NUMBER_OF_PINS];
+static const u32 RCC_BusClocksMasks[RCC_GATED_BUSES_NUM]={
+	RCC_AHB1_CLOCKS_MASK,
+	RCC_AHB2_CLOCKS_MASK,
+	RCC_APB1_CLOCKS_MASK,
+	RCC_APB2_CLOCKS_MASK,
+};
+static void RCC_ComputeFrequencies(void);
+static volatile u32 * RCC_GetEnableRegister(u8 Copy_u8BusId);
+static tenu_ErrorStatus RCC_CheckGatedClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral);
+
+/* Through MNVIC so the clock switches show up in the blocked time statistics */
+static u32 RCC_MaskInterrupts(void)
+{
+	return MNVIC_EnterCritical();
+}
+
+static void RCC_RestoreInterrupts(u32 Copy_u32Primask)
+{
+	MNVIC_ExitCritical(Copy_u32Primask);
+}
+
+/* Waits until (Reg&Mask)==Value, LBTY_NOK after RCC_READY_TIMEOUT loops */
+static tenu_ErrorStatus RCC_WaitFlag(volatile u32 * ADD_Reg, u32 Copy_u32Mask, u32 Copy_u32Value)
+{
+	u32 Local_u32TimeOut=RCC_READY_TIMEOUT;
+	while(((*ADD_Reg&Copy_u32Mask)!=Copy_u32Value)&&(Local_u32TimeOut>ZERO))
+	{
+		Local_u32TimeOut--;
+	}
+	return ((*ADD_Reg&Copy_u32Mask)==Copy_u32Value)?LBTY_OK:LBTY_NOK;
+}
+
+/* Gets the CFGR prescaler field of a divider, Copy_u8Base is the field of /2 */
+static tenu_ErrorStatus RCC_GetPrescaler(u16 Copy_u16Div, const u16 * ADD_Dividers, u8 Copy_u8Count, u8 Copy_u8Base, u32 *ADD_Field)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+	u8 Local_u8Index;
+	if(Copy_u16Div==1)
+	{
+		*ADD_Field=0;
+		Local_tenuErrorStatus = LBTY_OK;
+	}
+	for(Local_u8Index=0;(Local_u8Index<Copy_u8Count)&&(Local_tenuErrorStatus!=LBTY_OK);Local_u8Index++)
+	{
+		if(Copy_u16Div==ADD_Dividers[Local_u8Index])
+		{
+			*ADD_Field=Copy_u8Base+Local_u8Index;
+			Local_tenuErrorStatus = LBTY_OK;
+		}
+	}
+	return Local_tenuErrorStatus;
+}
+
+/* Checks a plan against the limits of the chip and builds its PLLCFGR and CFGR fields */
+static tenu_ErrorStatus RCC_CheckPlan(const RCC_ClockPlan_tstr * ADD_Plan, u32 *ADD_HCLK, u32 *ADD_PLLCFGR, u32 *ADD_CFGR)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	u32 Local_u32SourceHz=(ADD_Plan->PLLSource==RCC_PLL_SOURCE_HSI)?RCC_HSI_HZ:RCC_HSE_HZ;
+	u32 Local_u32VcoInHz=0;
+	u32 Local_u32VcoOutHz=0;
+	u32 Local_u32SysClkHz=0;
+	u32 Local_u32HPRE=0;
+	u32 Local_u32PPRE1=0;
+	u32 Local_u32PPRE2=0;
+	if((ADD_Plan->PLLSource>RCC_PLL_SOURCE_HSE_BYPASS)||
+	   ((ADD_Plan->PLLSource!=RCC_PLL_SOURCE_HSI)&&((RCC_HSE_HZ<RCC_HSE_MIN_HZ)||(RCC_HSE_HZ>RCC_HSE_MAX_HZ))))
+	{
+		Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+	}
+	else
+	{
+		switch(ADD_Plan->SystemClock)
+		{
+		case RCC_SYSTEM_CLOCK_HSI:
+			Local_u32SysClkHz=RCC_HSI_HZ;
+			break;
+		case RCC_SYSTEM_CLOCK_HSE:
+			Local_u32SysClkHz=RCC_HSE_HZ;
+			if(ADD_Plan->PLLSource==RCC_PLL_SOURCE_HSI)
+			{
+				Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+			}
+			break;
+		case RCC_SYSTEM_CLOCK_PLL:
+			if((ADD_Plan->PLLM<RCC_PLLM_MIN)||(ADD_Plan->PLLM>RCC_PLLM_MAX)||
+			   (ADD_Plan->PLLN<RCC_PLLN_VALUE_MIN)||(ADD_Plan->PLLN>RCC_PLLN_VALUE_MAX)||
+			   (ADD_Plan->PLLP<2)||(ADD_Plan->PLLP>8)||(ADD_Plan->PLLP&0x01)||
+			   (ADD_Plan->PLLQ<RCC_PLLQ_VALUE_MIN)||(ADD_Plan->PLLQ>RCC_PLLQ_VALUE_MAX))
+			{
+				Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+			}
+			else
+			{
+				Local_u32VcoInHz=Local_u32SourceHz/ADD_Plan->PLLM;
+				Local_u32VcoOutHz=Local_u32VcoInHz*ADD_Plan->PLLN;
+				Local_u32SysClkHz=Local_u32VcoOutHz/ADD_Plan->PLLP;
+				if((Local_u32SourceHz%ADD_Plan->PLLM)||
+				   (Local_u32VcoInHz<RCC_VCO_IN_MIN_HZ)||(Local_u32VcoInHz>RCC_VCO_IN_MAX_HZ)||
+				   (Local_u32VcoOutHz<RCC_VCO_OUT_MIN_HZ)||(Local_u32VcoOutHz>RCC_VCO_OUT_MAX_HZ)||
+				   ((Local_u32VcoOutHz/ADD_Plan->PLLQ)>RCC_PLL48_MAX_HZ))
+				{
+					Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+				}
+			}
+			break;
+		default:
+			Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+		}
+	}
+	if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		if((RCC_GetPrescaler(ADD_Plan->AHBDiv,RCC_AHBDividers,sizeof(RCC_AHBDividers)/sizeof(RCC_AHBDividers[0]),8,&Local_u32HPRE)!=LBTY_OK)||
+		   (RCC_GetPrescaler(ADD_Plan->APB1Div,RCC_APBDividers,sizeof(RCC_APBDividers)/sizeof(RCC_APBDividers[0]),4,&Local_u32PPRE1)!=LBTY_OK)||
+		   (RCC_GetPrescaler(ADD_Plan->APB2Div,RCC_APBDividers,sizeof(RCC_APBDividers)/sizeof(RCC_APBDividers[0]),4,&Local_u32PPRE2)!=LBTY_OK)||
+		   (Local_u32SysClkHz>RCC_SYSCLK_MAX_HZ)||
+		   ((Local_u32SysClkHz/ADD_Plan->AHBDiv/ADD_Plan->APB1Div)>RCC_APB1_MAX_HZ)||
+		   ((Local_u32SysClkHz/ADD_Plan->AHBDiv/ADD_Plan->APB2Div)>RCC_APB2_MAX_HZ))
+		{
+			Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+		}
+		else
+		{
+			*ADD_HCLK=Local_u32SysClkHz/ADD_Plan->AHBDiv;
+			*ADD_PLLCFGR=ADD_Plan->PLLM|((u32)ADD_Plan->PLLN<<RCC_PLLCFGR_N_OFFSET)|
+					((u32)((ADD_Plan->PLLP/2)-1)<<RCC_PLLCFGR_P_OFFSET)|((u32)ADD_Plan->PLLQ<<RCC_PLLCFGR_Q_OFFSET)|
+					((ADD_Plan->PLLSource!=RCC_PLL_SOURCE_HSI)?(1UL<<RCC_PLL_SOURCE):0);
+			*ADD_CFGR=(Local_u32HPRE<<RCC_CFGR_HPRE_OFFSET)|(Local_u32PPRE1<<RCC_CFGR_PPRE1_OFFSET)|(Local_u32PPRE2<<RCC_CFGR_PPRE2_OFFSET);
+		}
+	}
+	return Local_tenuErrorStatus;
+}
+
+/* Programs the flash wait states, the new value must be read back before the clock changes */
+static tenu_ErrorStatus RCC_SetFlashLatency(u32 Copy_u32WaitStates)
+{
+	FLASH_ACR=(FLASH_ACR&~FLASH_ACR_LATENCY_MASK)|Copy_u32WaitStates;
+	return ((FLASH_ACR&FLASH_ACR_LATENCY_MASK)==Copy_u32WaitStates)?LBTY_OK:LBTY_NOK;
+}
+
+/* Switches SYSCLK and the prescalers, the only part of a clock change run with the interrupts masked.
+ * Going up the prescalers are set first, going down SYSCLK is, so the buses never run faster than the plan. */
+static tenu_ErrorStatus RCC_SwitchSystemClock(u8 Copy_u8Source, u32 Copy_u32SysClkHz, u32 Copy_u32CFGR, u32 Copy_u32WaitStates)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	u32 Local_u32Primask=RCC_MaskInterrupts();
+	/* raise the wait states before the clock goes up */
+	if(Copy_u32WaitStates>(FLASH_ACR&FLASH_ACR_LATENCY_MASK))
+	{
+		Local_tenuErrorStatus=RCC_SetFlashLatency(Copy_u32WaitStates);
+	}
+	if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		if(Copy_u32SysClkHz<RCC_SYSCLKHz)
+		{
+			RCC_CFGR=(RCC_CFGR&~RCC_CFGR_SW_MASK)|Copy_u8Source;
+			Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CFGR,RCC_CFGR_SWS_MASK,(u32)Copy_u8Source<<RCC_CFGR_SWS_OFFSET);
+			if(Local_tenuErrorStatus==LBTY_OK)
+			{
+				RCC_CFGR=(RCC_CFGR&~RCC_CFGR_PRESCALERS_MASK)|Copy_u32CFGR;
+			}
+		}
+		else
+		{
+			RCC_CFGR=(RCC_CFGR&~RCC_CFGR_PRESCALERS_MASK)|Copy_u32CFGR;
+			RCC_CFGR=(RCC_CFGR&~RCC_CFGR_SW_MASK)|Copy_u8Source;
+			Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CFGR,RCC_CFGR_SWS_MASK,(u32)Copy_u8Source<<RCC_CFGR_SWS_OFFSET);
+		}
+		if(Local_tenuErrorStatus!=LBTY_OK)
+		{
+			RCC_CFGR=(RCC_CFGR&~RCC_CFGR_SW_MASK)|RCC_SYSTEM_CLOCK_HSI;
+		}
+		else
+		{
+			/* lower the wait states once the clock went down */
+			RCC_SetFlashLatency(Copy_u32WaitStates);
+		}
+	}
+	RCC_ComputeFrequencies();
+	RCC_RestoreInterrupts(Local_u32Primask);
+	return Local_tenuErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_ConfigureSystemClock(const RCC_ClockPlan_tstr * ADD_Plan)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	u32 Local_u32HCLK=0;
+	u32 Local_u32PLLCFGR=0;
+	u32 Local_u32CFGR=0;
+	u32 Local_u32WaitStates=0;
+	u8 Local_u8UseHSE;
+	u8 Local_u8KeepPLL;
+	if(ADD_Plan==NULL)
+	{
+		Local_tenuErrorStatus = LBTY_ErrorNullPointer;
+	}
+	else
+	{
+		Local_tenuErrorStatus=RCC_CheckPlan(ADD_Plan,&Local_u32HCLK,&Local_u32PLLCFGR,&Local_u32CFGR);
+	}
+	if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		Local_u32WaitStates=(Local_u32HCLK-1)/RCC_FLASH_WS_HZ;
+		Local_u8UseHSE=(ADD_Plan->SystemClock!=RCC_SYSTEM_CLOCK_HSI)&&(ADD_Plan->PLLSource!=RCC_PLL_SOURCE_HSI);
+		/* the PLL already runs locked with the settings of the plan (e.g. 84 MHz to 42 MHz through AHB /2),
+		 * only the prescalers and SW change */
+		Local_u8KeepPLL=(ADD_Plan->SystemClock==RCC_SYSTEM_CLOCK_PLL)&&
+				((RCC_CR&((1UL<<RCC_PLL_ENABLE_MASK)|(1UL<<PLL_RDY)))==((1UL<<RCC_PLL_ENABLE_MASK)|(1UL<<PLL_RDY)))&&
+				((RCC_PLLCFGR&RCC_PLLCFGR_FIELDS_MASK)==Local_u32PLLCFGR)&&
+				(!Local_u8UseHSE||(((RCC_CR>>RCC_CR_HSEBYP)&ONE)==(ADD_Plan->PLLSource==RCC_PLL_SOURCE_HSE_BYPASS)));
+		/* HSI is the fallback of a failed switch, it must be running */
+		RCC_CR|=RCC_HSI_ENABLE_MASK;
+		Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CR,1UL<<HSI_RDY,1UL<<HSI_RDY);
+		if((Local_tenuErrorStatus==LBTY_OK)&&!Local_u8KeepPLL&&(ADD_Plan->SystemClock!=RCC_SYSTEM_CLOCK_HSI))
+		{
+			/* move to HSI so the PLL and HSE can be changed, the current wait states are enough for 16 MHz */
+			if((RCC_CFGR&RCC_CFGR_SWS_MASK)!=(RCC_SYSTEM_CLOCK_HSI<<RCC_CFGR_SWS_OFFSET))
+			{
+				Local_tenuErrorStatus=RCC_SwitchSystemClock(RCC_SYSTEM_CLOCK_HSI,RCC_HSI_HZ,RCC_CFGR&RCC_CFGR_PRESCALERS_MASK,
+						FLASH_ACR&FLASH_ACR_LATENCY_MASK);
+				MRCC_UpdateClockFrequencies();
+			}
+			/* the oscillators are started and the PLL locks with the interrupts enabled, the system runs from HSI */
+			if((Local_tenuErrorStatus==LBTY_OK)&&Local_u8UseHSE)
+			{
+				/* HSEBYP can only be changed while HSE is off */
+				if(((RCC_CR>>RCC_CR_HSEBYP)&ONE)!=(ADD_Plan->PLLSource==RCC_PLL_SOURCE_HSE_BYPASS))
+				{
+					RCC_CR&=~(1UL<<RCC_HSE_ENABLE_MASK);
+					Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CR,1UL<<HSE_RDY,0);
+					if(ADD_Plan->PLLSource==RCC_PLL_SOURCE_HSE_BYPASS)
+					{
+						RCC_CR|=(1UL<<RCC_CR_HSEBYP);
+					}
+					else
+					{
+						RCC_CR&=~(1UL<<RCC_CR_HSEBYP);
+					}
+				}
+				RCC_CR|=(1UL<<RCC_HSE_ENABLE_MASK);
+				if(Local_tenuErrorStatus==LBTY_OK)
+				{
+					Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CR,1UL<<HSE_RDY,1UL<<HSE_RDY);
+				}
+			}
+			if((Local_tenuErrorStatus==LBTY_OK)&&(ADD_Plan->SystemClock==RCC_SYSTEM_CLOCK_PLL))
+			{
+				/* the PLL is not used by SYSCLK anymore, it can be stopped and reprogrammed */
+				RCC_CR&=~(1UL<<RCC_PLL_ENABLE_MASK);
+				Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CR,1UL<<PLL_RDY,0);
+				if(Local_tenuErrorStatus==LBTY_OK)
+				{
+					RCC_PLLCFGR=(RCC_PLLCFGR&~RCC_PLLCFGR_FIELDS_MASK)|Local_u32PLLCFGR;
+					RCC_CR|=(1UL<<RCC_PLL_ENABLE_MASK);
+					Local_tenuErrorStatus=RCC_WaitFlag(&RCC_CR,1UL<<PLL_RDY,1UL<<PLL_RDY);
+				}
+			}
+		}
+		if(Local_tenuErrorStatus==LBTY_OK)
+		{
+			Local_tenuErrorStatus=RCC_SwitchSystemClock(ADD_Plan->SystemClock,Local_u32HCLK*ADD_Plan->AHBDiv,Local_u32CFGR,Local_u32WaitStates);
+		}
+		if(Local_tenuErrorStatus==LBTY_OK)
+		{
+			/* stop the PLL and HSE if the plan doesn't use them */
+			if(ADD_Plan->SystemClock!=RCC_SYSTEM_CLOCK_PLL)
+			{
+				RCC_CR&=~(1UL<<RCC_PLL_ENABLE_MASK);
+			}
+			if(!Local_u8UseHSE)
+			{
+				RCC_CR&=~(1UL<<RCC_HSE_ENABLE_MASK);
+			}
+			/* the caches can only be reset while they are disabled */
+			if(!((FLASH_ACR>>FLASH_ACR_ICEN)&ONE))
+			{
+				FLASH_ACR|=(1UL<<FLASH_ACR_ICRST);
+				FLASH_ACR&=~(1UL<<FLASH_ACR_ICRST);
+			}
+			if(!((FLASH_ACR>>FLASH_ACR_DCEN)&ONE))
+			{
+				FLASH_ACR|=(1UL<<FLASH_ACR_DCRST);
+				FLASH_ACR&=~(1UL<<FLASH_ACR_DCRST);
+			}
+			FLASH_ACR|=(1UL<<FLASH_ACR_PRFTEN)|(1UL<<FLASH_ACR_ICEN)|(1UL<<FLASH_ACR_DCEN);
+		}
+		/* even on a failure the system may have moved to HSI, the drivers follow the clock actually running */
+		MRCC_UpdateClockFrequencies();
+	}
+	return Local_tenuErrorStatus;
+}
+
+/* Reads the clock tree back from the registers into the cached frequencies */
+static void RCC_ComputeFrequencies(void)
+{
+	u32 Local_u32SourceHz;
+	u32 Local_u32Field;
+	u32 Local_u32PLLCFGR=RCC_PLLCFGR;
+	u32 Local_u32CFGR=RCC_CFGR;
+	switch((Local_u32CFGR&RCC_CFGR_SWS_MASK)>>RCC_CFGR_SWS_OFFSET)
+	{
+	case RCC_SYSTEM_CLOCK_HSE:
+		RCC_SYSCLKHz=RCC_HSE_HZ;
+		break;
+	case RCC_SYSTEM_CLOCK_PLL:
+		Local_u32SourceHz=((Local_u32PLLCFGR>>RCC_PLL_SOURCE)&ONE)?RCC_HSE_HZ:RCC_HSI_HZ;
+		RCC_SYSCLKHz=(u32)(((u64)Local_u32SourceHz*((Local_u32PLLCFGR>>RCC_PLLCFGR_N_OFFSET)&0x1FF))/
+				((Local_u32PLLCFGR&RCC_PLLM_MAX)*((((Local_u32PLLCFGR>>RCC_PLLCFGR_P_OFFSET)&0x03)+1)*2)));
+		break;
+	default:
+		RCC_SYSCLKHz=RCC_HSI_HZ;
+		break;
+	}
+	Local_u32Field=(Local_u32CFGR>>RCC_CFGR_HPRE_OFFSET)&0x0F;
+	RCC_HCLKHz=(Local_u32Field<8)?RCC_SYSCLKHz:(RCC_SYSCLKHz/RCC_AHBDividers[Local_u32Field-8]);
+	Local_u32Field=(Local_u32CFGR>>RCC_CFGR_PPRE1_OFFSET)&0x07;
+	RCC_PCLK1Hz=(Local_u32Field<4)?RCC_HCLKHz:(RCC_HCLKHz/RCC_APBDividers[Local_u32Field-4]);
+	Local_u32Field=(Local_u32CFGR>>RCC_CFGR_PPRE2_OFFSET)&0x07;
+	RCC_PCLK2Hz=(Local_u32Field<4)?RCC_HCLKHz:(RCC_HCLKHz/RCC_APBDividers[Local_u32Field-4]);
+	SystemCoreClock=RCC_HCLKHz;
+}
+
+void MRCC_UpdateClockFrequencies(void)
+{
+	u8 Local_u8Index;
+	u32 Local_u32Primask=RCC_MaskInterrupts();
+	RCC_ComputeFrequencies();
+	for(Local_u8Index=0;Local_u8Index<RCC_ClockSubscribersNum;Local_u8Index++)
+	{
+		RCC_ClockSubscribers[Local_u8Index]();
+	}
+	RCC_RestoreInterrupts(Local_u32Primask);
+}
+
+tenu_ErrorStatus MRCC_GetPlanHCLKHz(const RCC_ClockPlan_tstr * ADD_Plan, u32 *ADD_HCLKHz)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	u32 Local_u32PLLCFGR;
+	u32 Local_u32CFGR;
+	if((ADD_Plan==NULL)||(ADD_HCLKHz==NULL))
+	{
+		Local_tenuErrorStatus = LBTY_ErrorNullPointer;
+	}
+	else
+	{
+		Local_tenuErrorStatus=RCC_CheckPlan(ADD_Plan,ADD_HCLKHz,&Local_u32PLLCFGR,&Local_u32CFGR);
+	}
+	return Local_tenuErrorStatus;
+}
+
+u32 MRCC_GetSYSCLKHz(void)
+{
+	return RCC_SYSCLKHz;
+}
+
+u32 MRCC_GetHCLKHz(void)
+{
+	return RCC_HCLKHz;
+}
+
+u32 MRCC_GetPCLK1Hz(void)
+{
+	return RCC_PCLK1Hz;
+}
+
+u32 MRCC_GetPCLK2Hz(void)
+{
+	return RCC_PCLK2Hz;
+}
+
+tenu_ErrorStatus MRCC_SubscribeClockChange(RCC_ClockCb_t Copy_Callback)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	u8 Local_u8Index;
+	if(Copy_Callback==NULL)
+	{
+		Local_tenuErrorStatus = LBTY_ErrorNullPointer;
+	}
+	else
+	{
+		for(Local_u8Index=0;(Local_u8Index<RCC_ClockSubscribersNum)&&(RCC_ClockSubscribers[Local_u8Index]!=Copy_Callback);Local_u8Index++);
+		if(Local_u8Index<RCC_ClockSubscribersNum)
+		{
+			/* already registered */
+		}
+		else if(RCC_ClockSubscribersNum==RCC_CLOCK_SUBSCRIBERS)
+		{
+			Local_tenuErrorStatus = LBTY_NOK;
+		}
+		else
+		{
+			RCC_ClockSubscribers[RCC_ClockSubscribersNum]=Copy_Callback;
+			RCC_ClockSubscribersNum++;
+		}
+	}
+	return Local_tenuErrorStatus;
+}
+
+/* Gets the enable register of a bus */
+static volatile u32 * RCC_GetEnableRegister(u8 Copy_u8BusId)
+{
+	volatile u32 * Local_pu32Reg;
+	switch(Copy_u8BusId)
+	{
+	case RCC_AHB1 : Local_pu32Reg=&RCC_AHB1ENR; break;
+	case RCC_AHB2 : Local_pu32Reg=&RCC_AHB2ENR; break;
+	case RCC_APB1 : Local_pu32Reg=&RCC_APB1ENR; break;
+	default       : Local_pu32Reg=&RCC_APB2ENR; break;
+	}
+	return Local_pu32Reg;
+}
+
+/* Checks that the bus is gated and that the mask is one peripheral of it */
+static tenu_ErrorStatus RCC_CheckGatedClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	if((Copy_u8BusId<RCC_AHB1)||(Copy_u8BusId>RCC_APB2)||
+	   (Copy_u32Peripheral==0)||((Copy_u32Peripheral&(Copy_u32Peripheral-1))!=0)||
+	   ((Copy_u32Peripheral&RCC_BusClocksMasks[Copy_u8BusId-RCC_AHB1])==0))
+	{
+		Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+	}
+	return Local_tenuErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_AcquireClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = RCC_CheckGatedClock(Copy_u8BusId,Copy_u32Peripheral);
+	u8 * Local_pu8Refs;
+	u32 Local_u32Primask;
+	if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		Local_pu8Refs=&RCC_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)];
+		Local_u32Primask=RCC_MaskInterrupts();
+		if(*Local_pu8Refs==RCC_REFS_MAX)
+		{
+			Local_tenuErrorStatus = LBTY_NOK;
+		}
+		else
+		{
+			if(*Local_pu8Refs==0)
+			{
+				*RCC_GetEnableRegister(Copy_u8BusId)|=Copy_u32Peripheral;
+			}
+			(*Local_pu8Refs)++;
+		}
+		RCC_RestoreInterrupts(Local_u32Primask);
+	}
+	return Local_tenuErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_ReleaseClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = RCC_CheckGatedClock(Copy_u8BusId,Copy_u32Peripheral);
+	u8 * Local_pu8Refs;
+	u32 Local_u32Primask;
+	if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		Local_pu8Refs=&RCC_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)];
+		Local_u32Primask=RCC_MaskInterrupts();
+		if(*Local_pu8Refs==0)
+		{
+			Local_tenuErrorStatus = LBTY_NOK;
+		}
+		else
+		{
+			(*Local_pu8Refs)--;
+			if(*Local_pu8Refs==0)
+			{
+				*RCC_GetEnableRegister(Copy_u8BusId)&=~Copy_u32Peripheral;
+			}
+		}
+		RCC_RestoreInterrupts(Local_u32Primask);
+	}
+	return Local_tenuErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_GetLiveClocks(u8 Copy_u8BusId,u32 *ADD_Clocks)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = LBTY_OK;
+	if(ADD_Clocks==NULL)
+	{
+		Local_tenuErrorStatus = LBTY_ErrorNullPointer;
+	}
+	else if((Copy_u8BusId<RCC_AHB1)||(Copy_u8BusId>RCC_APB2))
+	{
+		Local_tenuErrorStatus = LBTY_ErrorInvalidInput;
+	}
+	else
+	{
+		*ADD_Clocks=*RCC_GetEnableRegister(Copy_u8BusId)&RCC_BusClocksMasks[Copy_u8BusId-RCC_AHB1];
+	}
+	return Local_tenuErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_GetClockRefs(u8 Copy_u8BusId,u32 Copy_u32Peripheral,u8 *ADD_Refs)
+{
+	tenu_ErrorStatus Local_tenuErrorStatus = RCC_CheckGatedClock(Copy_u8BusId,Copy_u32Peripheral);
+	if(ADD_Refs==NULL)
+	{
+		Local_tenuErrorStatus = LBTY_ErrorNullPointer;
+	}
+	else if(Local_tenuErrorStatus==LBTY_OK)
+	{
+		*ADD_Refs=RCC_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)];
+	}
+	return Local_tenuErrorStatus;
+}
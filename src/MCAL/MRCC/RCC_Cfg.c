@@ -11,3 +11,21 @@
 
 
 
+
+#include "STD_TYPES.h"
+#include "MRCC/RCC.h"
+
+const RCC_ClockPlan_tstr RCC_ClockPlans[_RCC_PLAN_NUM]={
+	/* reset clock, 16 MHz HSI, PLL unused */
+	[RCC_PLAN_HSI_16MHZ]={.SystemClock=RCC_SYSTEM_CLOCK_HSI,.PLLSource=RCC_PLL_SOURCE_HSI,.PLLM=16,.PLLN=192,.PLLP=2,.PLLQ=4,
+			.AHBDiv=1,.APB1Div=1,.APB2Div=1},
+	/* same PLL as the 84 MHz plan so the two switch by prescalers only, 84 MHz SYSCLK, AHB /2=42 MHz HCLK, PCLK1 42 MHz */
+	[RCC_PLAN_HSI_PLL_42MHZ]={.SystemClock=RCC_SYSTEM_CLOCK_PLL,.PLLSource=RCC_PLL_SOURCE_HSI,.PLLM=8,.PLLN=168,.PLLP=4,.PLLQ=7,
+			.AHBDiv=2,.APB1Div=1,.APB2Div=1},
+	/* 16 MHz/8=2 MHz, x168=336 MHz VCO, /4=84 MHz SYSCLK, /7=48 MHz, PCLK1 42 MHz */
+	[RCC_PLAN_HSI_PLL_84MHZ]={.SystemClock=RCC_SYSTEM_CLOCK_PLL,.PLLSource=RCC_PLL_SOURCE_HSI,.PLLM=8,.PLLN=168,.PLLP=4,.PLLQ=7,
+			.AHBDiv=1,.APB1Div=2,.APB2Div=1},
+	/* 25 MHz/25=1 MHz, x336=336 MHz VCO, /4=84 MHz SYSCLK, /7=48 MHz, PCLK1 42 MHz */
+	[RCC_PLAN_HSE_PLL_84MHZ]={.SystemClock=RCC_SYSTEM_CLOCK_PLL,.PLLSource=RCC_PLL_SOURCE_HSE,.PLLM=25,.PLLN=336,.PLLP=4,.PLLQ=7,
+			.AHBDiv=1,.APB1Div=2,.APB2Div=1},
+};
@@ -4,12 +4,15 @@
 /********************************************************************************************************/
 #include "STD_TYPES.h"  // Include standard types header file
 #include "MUSART/USART.h"  // Include USART module header file
+#include "Bit_Band.h"  // Atomic single bit access for CR1/SR and the busy flags
+#include "MRCC/RCC.h"  // Bus clocks of the channels and their changes
+#include "MNVIC/MNVIC.h"  // Handler statistics
 
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
 
-// External Interrupt State Structure
+// External Interrupt State Structure, holds the enable of each interrupt as configured in USART_Init
 typedef struct {
     USART_enu_Enable Transmit;      // Transmission Enable
     USART_enu_Enable TX_DR_Empty;  // Transmitter Data Register Empty
@@ -17,12 +20,10 @@ typedef struct {
 } Interrupt_State;
 
 // Definition of USART register bits and values
-#define F_CLK                16000000   // System clock frequency
 #define USART_NUMBERS        3          // Number of USART channels in use
 #define OVERSAMPLING_BIT     15         // Bit position for oversampling control
 #define WORDLENGTH_BIT       12         // Bit position for word length control
 #define MANTISSA_BIT         4          // Bit position for mantissa in baud rate calculation
-#define FRACTION_MSK         0x0F       // Mask for extracting fraction bits in baud rate calculation
 #define USART_ENABLE_BIT     13         // Bit position for USART enable control
 #define PARITY_CONTROL_BIT   10         // Bit position for parity control
 #define PARITY_SELECTION_BIT 9         // Bit position for parity selection
@@ -31,6 +32,7 @@ typedef struct {
 #define RX_DATA_NOT_EMPTY_BIT 5         // Bit position for receiver data not empty interrupt enable
 #define TX_ENABLE_BIT        3          // Bit position for transmitter enable control
 #define RX_ENABLE_BIT        2          // Bit position for receiver enable control
+#define BUSY_FLAG_BIT        0          // Bit of the busy flags holding USART_BUSY/USART_IDLE
 #define USART_1              0          // USART channel 1 index
 #define USART_2              1          // USART channel 2 index
 #define USART_6              2          // USART channel 6 index
@@ -39,7 +41,7 @@ typedef struct {
 /************************************************VALIDATIONS*************************************************/
 #define IS_VALID_CONTROL(MODE)          ((MODE) == (USART_Enable)||(MODE) == (USART_Disable))
 
-#define IS_VALID_BAUDRATE(BR)            ((BR) < 1000000U)
+#define IS_VALID_BAUDRATE(BR)            ((BR) != 0U && (BR) < 1000000U)
 
 #define IS_VALID_STOP_BIT(SB)            ((SB)==USART_1StopBit||(SB)==USART_2StopBit)
 
@@ -80,7 +82,7 @@ typedef struct {
 static CallBack USART_pvCallBackFunc[16] = {NULL};
 
 // Array to store flags indicating the busy state of USART channels during transmission
-static u8 Uart_prvTX_BuzyFlag[USART_NUMBERS];
+static volatile u8 Uart_prvTX_BuzyFlag[USART_NUMBERS];
 
 // Array to store the index of the current byte being transmitted for each USART channel
 static u8 Uart_prvTX_BufferIndex[USART_NUMBERS];
@@ -95,7 +97,7 @@ static u8 *Uart_prvTX_BufferSend[USART_NUMBERS];
 static Interrupt_State USART_Interrupt;
 
 // Array to store flags indicating the busy state of USART channels during reception
-static u8 Uart_prvRx_BuzyFlag[USART_NUMBERS];
+static volatile u8 Uart_prvRx_BuzyFlag[USART_NUMBERS];
 
 // Array to store the index of the current byte being received for each USART channel
 static u8 Uart_prvRx_BufferIndex[USART_NUMBERS];
@@ -106,6 +108,10 @@ static u8 Uart_prvRx_BufferSize[USART_NUMBERS];
 // Array to store pointers to the data buffer being received for each USART channel
 u8 *Uart_prvRx_BufferReceive[USART_NUMBERS];
 
+// Baud rate settings of each initialized channel, BRR is derived again from them when the clock changes
+static u16 Uart_prvBaudRate[USART_NUMBERS];
+static u8 Uart_prvOversampling[USART_NUMBERS];
+
 /********************************************************************************************************/
 /*****************************************Static Functions Prototype*************************************/
 /********************************************************************************************************/
@@ -113,6 +119,19 @@ u8 *Uart_prvRx_BufferReceive[USART_NUMBERS];
 // Function prototype for determining USART channel index
 static USART_enuErrorStatus USART_InputUsart(void *USART_channel, u8 *Channel_idx);
 
+// Function prototype for computing BRR from the bus clock of a channel
+static u16 USART_ComputeBRR(u32 Copy_ClockHz, u16 Copy_BaudRate, u8 Copy_Oversampling);
+
+// Clock change subscriber, programs BRR of every initialized channel for the new bus clocks
+static void USART_ClockChanged(void);
+
+// Instances of the channels, indexed like the state arrays
+static void * const Uart_prvInstances[USART_NUMBERS]={USART1,USART2,USART6};
+
+// Bus and enable bit of the clock of each channel, indexed like the state arrays
+static const u8 Uart_prvClockBus[USART_NUMBERS]={RCC_APB2,RCC_APB1,RCC_APB2};
+static const u32 Uart_prvClockMask[USART_NUMBERS]={RCC_APB2_USART1,RCC_APB1_USART2,RCC_APB2_USART6};
+
 
 /********************************************************************************************************/
 /*********************************************APIs Implementation****************************************/
@@ -121,9 +140,7 @@ static USART_enuErrorStatus USART_InputUsart(void *USART_channel, u8 *Channel_id
 USART_enuErrorStatus USART_Init(const USART_strCfg_t* ConfigPtr)
 {
     USART_enuErrorStatus Local_ErrorStatus = USART_OK;
-    u32 Local_TempValue=0;
-	u16	Local_TempMantissa=0;
-	u16 Local_TempFraction=0;
+    u8 Local_ChannelIdx=0;
 
     if (ConfigPtr==NULL)
     {
@@ -174,35 +191,22 @@ USART_enuErrorStatus USART_Init(const USART_strCfg_t* ConfigPtr)
 
 	else
 	{
-		Local_TempValue=((u64)F_CLK*1000)/(ConfigPtr->BaudRate*(8*(2-ConfigPtr->Oversampling)));
-		Local_TempFraction=(Local_TempValue%1000)*(8*(2-ConfigPtr->Oversampling));
-		if(Local_TempFraction % 1000 >= 500)
-		{
-			Local_TempFraction = (Local_TempFraction/1000) + 1 ;
-		}
-		else
-		{
-			Local_TempFraction/=1000;
-		}
-		Local_TempFraction/=1000;
-		Local_TempMantissa=Local_TempValue/1000;
-		if((Local_TempFraction>0xf)&&(ConfigPtr->Oversampling==OVERSAMPLING_16))
-		{
-			Local_TempFraction=0;
-			Local_TempMantissa++;
-		}
-		else if ((Local_TempFraction>0x7)&&(ConfigPtr->Oversampling==OVERSAMPLING_8))
-		{
-			Local_TempMantissa++;
-			Local_TempFraction=0;
-		}
-		else
-		{
-        	/*Do Nothing*/
-		}
-		//0x4E2
-
-		((USART_t*)(ConfigPtr->pUartInstance))->BRR=(Local_TempMantissa<<MANTISSA_BIT)|(Local_TempFraction&FRACTION_MSK);
+		USART_InputUsart(ConfigPtr->pUartInstance,&Local_ChannelIdx);
+	}
+	/* One clock reference per initialized channel, a second USART_Init only reconfigures it */
+	if((Local_ErrorStatus==USART_OK)&&(Uart_prvBaudRate[Local_ChannelIdx]==0)&&
+	   (MRCC_AcquireClock(Uart_prvClockBus[Local_ChannelIdx],Uart_prvClockMask[Local_ChannelIdx])!=LBTY_OK))
+	{
+		Local_ErrorStatus = USART_ClockError;
+	}
+	if(Local_ErrorStatus==USART_OK)
+	{
+		Uart_prvBaudRate[Local_ChannelIdx]=ConfigPtr->BaudRate;
+		Uart_prvOversampling[Local_ChannelIdx]=ConfigPtr->Oversampling;
+		/* USART2 is on APB1, USART1 and USART6 on APB2 */
+		((USART_t*)(ConfigPtr->pUartInstance))->BRR=USART_ComputeBRR((Local_ChannelIdx==USART_2)?MRCC_GetPCLK1Hz():MRCC_GetPCLK2Hz(),
+				ConfigPtr->BaudRate,ConfigPtr->Oversampling);
+		MRCC_SubscribeClockChange(USART_ClockChanged);
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1=0;
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1|=ConfigPtr->Oversampling<<OVERSAMPLING_BIT;
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1|=ConfigPtr->Word_bits<<WORDLENGTH_BIT;
@@ -218,9 +222,9 @@ USART_enuErrorStatus USART_Init(const USART_strCfg_t* ConfigPtr)
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1|=ConfigPtr->ReceiverControl<<RX_ENABLE_BIT;
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1|=ConfigPtr->TransmitterControl<<TX_ENABLE_BIT;
 		
-		USART_Interrupt.Transmit = ConfigPtr->TXCE_Enable << TRANSMIT_COMPLETE_BIT;
-		USART_Interrupt.TX_DR_Empty = ConfigPtr->TXE_Enable << TX_DATA_EMPTY_BIT;
-		USART_Interrupt.RX_DR_Empty = ConfigPtr->RXNE_Enable << RX_DATA_NOT_EMPTY_BIT;
+		USART_Interrupt.Transmit = ConfigPtr->TXCE_Enable;
+		USART_Interrupt.TX_DR_Empty = ConfigPtr->TXE_Enable;
+		USART_Interrupt.RX_DR_Empty = ConfigPtr->RXNE_Enable;
 
 		
 		((USART_t*)(ConfigPtr->pUartInstance))->CR1|=ConfigPtr->UartEnable<<USART_ENABLE_BIT;
@@ -233,6 +237,36 @@ USART_enuErrorStatus USART_Init(const USART_strCfg_t* ConfigPtr)
 
 }
 /****************************************************************************************************/
+USART_enuErrorStatus USART_DeInit(void* Channel)
+{
+	USART_enuErrorStatus Local_ErrorStatus = USART_OK;
+	u8 Local_ChannelIdx=0;
+	if(Channel==NULL)
+	{
+		Local_ErrorStatus=USART_NullConfPointer;
+	}
+	else if(!(IS_VALID_USART(Channel)))
+	{
+		Local_ErrorStatus = USART_UsartSelectError;
+	}
+	else
+	{
+		USART_InputUsart(Channel,&Local_ChannelIdx);
+		if(Uart_prvBaudRate[Local_ChannelIdx]==0)
+		{
+			/* not set up by USART_Init, there is no reference to give back */
+			Local_ErrorStatus = USART_ClockError;
+		}
+		else
+		{
+			((USART_t*)Channel)->CR1=0;
+			Uart_prvBaudRate[Local_ChannelIdx]=0; // USART_ClockChanged skips the channel from now on
+			MRCC_ReleaseClock(Uart_prvClockBus[Local_ChannelIdx],Uart_prvClockMask[Local_ChannelIdx]);
+		}
+	}
+	return Local_ErrorStatus;
+}
+/****************************************************************************************************/
 USART_enuErrorStatus USART_SendBytesynchronous(void* Channel, u8 Copy_Data)
 {
 	USART_enuErrorStatus Local_ErrorStatus = USART_OK;
@@ -346,10 +380,13 @@ USART_enuErrorStatus USART_SendByteAsynchronous(void* Channel, u8 Copy_Data)
 		else
 		{
 			((USART_t*)Channel)->DR=Copy_Data;
-			Uart_prvTX_BuzyFlag[Local_ChannelIdx] = USART_BUSY;
+			BITBAND_SET_BIT(Uart_prvTX_BuzyFlag[Local_ChannelIdx],BUSY_FLAG_BIT);
 			Uart_prvTX_BufferIndex[Local_ChannelIdx] = 1;
 			Uart_prvTX_BufferSize[Local_ChannelIdx] = 1;
-			((USART_t*)Channel)->CR1 |= USART_Interrupt.Transmit;
+			if(USART_Interrupt.Transmit==USART_Enable)
+			{
+				BITBAND_SET_BIT(((USART_t*)Channel)->CR1,TRANSMIT_COMPLETE_BIT);
+			}
 		}
 		
 	}
@@ -377,11 +414,14 @@ USART_enuErrorStatus USART_ReceiveBufferAsynchronous(USART_RXBuffer * ReceiveBuf
 		}
 		else
 		{
-			Uart_prvRx_BuzyFlag[Local_ChannelIdx] = USART_BUSY;
+			BITBAND_SET_BIT(Uart_prvRx_BuzyFlag[Local_ChannelIdx],BUSY_FLAG_BIT);
 			Uart_prvRx_BufferReceive[Local_ChannelIdx]= (u8 *)&(ReceiveBuffer->Data);
 			Uart_prvRx_BufferIndex[Local_ChannelIdx] = ReceiveBuffer->Index;
 			Uart_prvRx_BufferSize[Local_ChannelIdx] = ReceiveBuffer->Size;
-			((USART_t*)ReceiveBuffer->Channel)->CR1 |= USART_Interrupt.RX_DR_Empty;
+			if(USART_Interrupt.RX_DR_Empty==USART_Enable)
+			{
+				BITBAND_SET_BIT(((USART_t*)ReceiveBuffer->Channel)->CR1,RX_DATA_NOT_EMPTY_BIT);
+			}
 		}
 
 	}
@@ -412,10 +452,13 @@ USART_enuErrorStatus USART_SendBufferZeroCopy(USART_TXBuffer* Copy_ConfigBuffer)
 	{
 	
 		((USART_t*)Copy_ConfigBuffer->Channel)->DR=Copy_ConfigBuffer->Data[0];
-		Uart_prvTX_BuzyFlag[Local_ChannelIdx] = USART_BUSY;
+		BITBAND_SET_BIT(Uart_prvTX_BuzyFlag[Local_ChannelIdx],BUSY_FLAG_BIT);
 		Uart_prvTX_BufferIndex[Local_ChannelIdx] = 1;
 		Uart_prvTX_BufferSize[Local_ChannelIdx] = Copy_ConfigBuffer->Size;
-		((USART_t*)Copy_ConfigBuffer->Channel)->CR1 |= USART_Interrupt.Transmit;
+		if(USART_Interrupt.Transmit==USART_Enable)
+		{
+			BITBAND_SET_BIT(((USART_t*)Copy_ConfigBuffer->Channel)->CR1,TRANSMIT_COMPLETE_BIT);
+		}
 		
 
 	}
@@ -463,18 +506,45 @@ USART_enuErrorStatus USART_InputUsart(void * USART_channel,u8 * Channel_idx)
 	return Loc_ErrorStatus;	
 
 }
+/****************************************************************************************************/
+static u16 USART_ComputeBRR(u32 Copy_ClockHz, u16 Copy_BaudRate, u8 Copy_Oversampling)
+{
+	/* USARTDIV in 1/16 (or 1/8 with OVERSAMPLING_8) steps is the bus clock over the baud rate, rounded */
+	u32 Local_Div=(Copy_ClockHz+(Copy_BaudRate/2))/Copy_BaudRate;
+	if(Copy_Oversampling==OVERSAMPLING_8)
+	{
+		/* the fraction has 3 bits, bit 3 of BRR must stay clear */
+		Local_Div=((Local_Div>>3)<<MANTISSA_BIT)|(Local_Div&0x07UL);
+	}
+	return (u16)Local_Div;
+}
+/****************************************************************************************************/
+static void USART_ClockChanged(void)
+{
+	u8 Local_ChannelIdx;
+	for(Local_ChannelIdx=0;Local_ChannelIdx<USART_NUMBERS;Local_ChannelIdx++)
+	{
+		if(Uart_prvBaudRate[Local_ChannelIdx]!=0)
+		{
+			((USART_t*)Uart_prvInstances[Local_ChannelIdx])->BRR=USART_ComputeBRR(
+					(Local_ChannelIdx==USART_2)?MRCC_GetPCLK1Hz():MRCC_GetPCLK2Hz(),
+					Uart_prvBaudRate[Local_ChannelIdx],Uart_prvOversampling[Local_ChannelIdx]);
+		}
+	}
+}
 /***********************Handler Function******************************/
 
 void USART1_IRQHandler(void)
 {
+	NVIC_ISR_ENTER(NVIC_IRQ_USART1);
 	if(Uart_prvRx_BuzyFlag[USART_1] == USART_BUSY && (((((USART_t*)USART1)->SR >> RX_DATA_NOT_EMPTY_BIT) & 0x01)))
 	{
 		Uart_prvRx_BufferReceive[USART_1][Uart_prvRx_BufferIndex[USART_1]] = ((USART_t*)USART1)->DR;
 		Uart_prvRx_BufferIndex[USART_1]++;
 		if(Uart_prvRx_BufferSize[USART_1] == Uart_prvRx_BufferIndex[USART_1])
 		{
-			((USART_t*)USART1)->CR1 &= ~(1 << RX_DATA_NOT_EMPTY_BIT);
-			Uart_prvRx_BuzyFlag[USART_1] = USART_IDLE;
+			BITBAND_CLR_BIT(((USART_t*)USART1)->CR1,RX_DATA_NOT_EMPTY_BIT);
+			BITBAND_CLR_BIT(Uart_prvRx_BuzyFlag[USART_1],BUSY_FLAG_BIT);
 			Uart_prvRx_BufferSize[USART_1] = 0;
 			if(USART_pvCallBackFunc[UART1_RECEIVE])
 			{
@@ -492,11 +562,11 @@ void USART1_IRQHandler(void)
 		if(Uart_prvTX_BufferIndex[USART_1] == Uart_prvTX_BufferSize[USART_1])
 		{
 			/*clear Buzy Tx flag*/
-			Uart_prvTX_BuzyFlag[USART_1] = USART_IDLE;
+			BITBAND_CLR_BIT(Uart_prvTX_BuzyFlag[USART_1],BUSY_FLAG_BIT);
 			/*clear Tx Buffer Size*/
 			Uart_prvTX_BufferSize[USART_1] = 0;
 			/*Disable tc interrupt*/
-			((USART_t*)USART1)->CR1 &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			BITBAND_CLR_BIT(((USART_t*)USART1)->CR1,TRANSMIT_COMPLETE_BIT);
 			if(USART_pvCallBackFunc[UART1_SEND])
 			{
 				USART_pvCallBackFunc[UART1_SEND]();
@@ -505,7 +575,8 @@ void USART1_IRQHandler(void)
 		}/*end of if*/
 		else
 		{
-			((USART_t*)USART1)->SR &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			/* SR is rc_w0, writing 0 to TC alone leaves RXNE and the other flags as they are */
+			((USART_t*)USART1)->SR=~(1UL<<TRANSMIT_COMPLETE_BIT);
 			((USART_t*)USART1)->DR = Uart_prvTX_BufferSend[USART_1][Uart_prvTX_BufferIndex[USART_1]];
 			Uart_prvTX_BufferIndex[USART_1]++;
 		}/*end of else*/
@@ -513,12 +584,14 @@ void USART1_IRQHandler(void)
 
 
 	
+	NVIC_ISR_EXIT(NVIC_IRQ_USART1);
 }/*end of function USART1_IRQHandler*/
 
 
 
 void USART2_IRQHandler(void)
 {
+	NVIC_ISR_ENTER(NVIC_IRQ_USART2);
 
 	if(Uart_prvRx_BuzyFlag[USART_2] == USART_BUSY && ((((USART_t*)USART2)->SR >> RX_DATA_NOT_EMPTY_BIT) & 0x01))
 	{
@@ -526,8 +599,8 @@ void USART2_IRQHandler(void)
 		Uart_prvRx_BufferIndex[USART_2]++;
 		if(Uart_prvRx_BufferSize[USART_2] == Uart_prvRx_BufferIndex[USART_2])
 		{
-			((USART_t*)USART2)->CR1 &= ~(1 << RX_DATA_NOT_EMPTY_BIT);
-			Uart_prvRx_BuzyFlag[USART_2] = USART_IDLE;
+			BITBAND_CLR_BIT(((USART_t*)USART2)->CR1,RX_DATA_NOT_EMPTY_BIT);
+			BITBAND_CLR_BIT(Uart_prvRx_BuzyFlag[USART_2],BUSY_FLAG_BIT);
 			Uart_prvRx_BufferSize[USART_2] = 0;
 			if(USART_pvCallBackFunc[UART2_RECEIVE])
 			{
@@ -545,10 +618,10 @@ void USART2_IRQHandler(void)
 		if(Uart_prvTX_BufferIndex[USART_2] == Uart_prvTX_BufferSize[USART_2])
 		{
 			/*clear Buzy Tx flag*/
-			Uart_prvTX_BuzyFlag[USART_2] = USART_IDLE;
+			BITBAND_CLR_BIT(Uart_prvTX_BuzyFlag[USART_2],BUSY_FLAG_BIT);
 			/*clear Tx Buffer Size*/
 			Uart_prvTX_BufferSize[USART_2] = 0;
-			((USART_t*)USART2)->CR1 &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			BITBAND_CLR_BIT(((USART_t*)USART2)->CR1,TRANSMIT_COMPLETE_BIT);
 			if(USART_pvCallBackFunc[UART2_SEND])
 			{
 				USART_pvCallBackFunc[UART2_SEND]();
@@ -556,7 +629,8 @@ void USART2_IRQHandler(void)
 		}/*end of if*/
 		else
 		{
-			((USART_t*)USART2)->SR &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			/* SR is rc_w0, writing 0 to TC alone leaves RXNE and the other flags as they are */
+			((USART_t*)USART2)->SR=~(1UL<<TRANSMIT_COMPLETE_BIT);
 			((USART_t*)USART2)->DR = Uart_prvTX_BufferSend[USART_2][Uart_prvTX_BufferIndex[USART_2]];
 			Uart_prvTX_BufferIndex[USART_2]++;
 		}/*end of else*/
@@ -565,10 +639,12 @@ void USART2_IRQHandler(void)
 	
 
 	
+	NVIC_ISR_EXIT(NVIC_IRQ_USART2);
 }/*end of function USART2_IRQHandler*/
 
 void USART6_IRQHandler(void)
 {
+	NVIC_ISR_ENTER(NVIC_IRQ_USART6);
 
 	if(Uart_prvRx_BuzyFlag[USART_6] == USART_BUSY && ((((USART_t*)USART6)->SR >> RX_DATA_NOT_EMPTY_BIT) & 0x01))
 	{
@@ -576,8 +652,8 @@ void USART6_IRQHandler(void)
 		Uart_prvRx_BufferIndex[USART_6]++;
 		if(Uart_prvRx_BufferSize[USART_6] == Uart_prvRx_BufferIndex[USART_6])
 		{
-			((USART_t*)USART6)->SR &= ~(1 << RX_DATA_NOT_EMPTY_BIT);
-			Uart_prvRx_BuzyFlag[USART_6] = USART_IDLE;
+			BITBAND_CLR_BIT(((USART_t*)USART6)->CR1,RX_DATA_NOT_EMPTY_BIT);
+			BITBAND_CLR_BIT(Uart_prvRx_BuzyFlag[USART_6],BUSY_FLAG_BIT);
 			Uart_prvRx_BufferSize[USART_6] = 0;
 		if(USART_pvCallBackFunc[UART6_RECEIVE])
 		{
@@ -593,10 +669,10 @@ void USART6_IRQHandler(void)
 		if(Uart_prvTX_BufferIndex[USART_6] == Uart_prvTX_BufferSize[USART_6])
 		{
 			/*clear Buzy Tx flag*/
-			Uart_prvTX_BuzyFlag[USART_6] = USART_IDLE;
+			BITBAND_CLR_BIT(Uart_prvTX_BuzyFlag[USART_6],BUSY_FLAG_BIT);
 			/*clear Tx Buffer Size*/
 			Uart_prvTX_BufferSize[USART_6] = 0;
-			((USART_t*)USART6)->CR1 &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			BITBAND_CLR_BIT(((USART_t*)USART6)->CR1,TRANSMIT_COMPLETE_BIT);
 			if(USART_pvCallBackFunc[UART6_SEND])
 			{
 				USART_pvCallBackFunc[UART6_SEND]();
@@ -605,10 +681,12 @@ void USART6_IRQHandler(void)
 		}/*end of if*/
 		else
 		{
-			((USART_t*)USART6)->SR &= ~(1 << TRANSMIT_COMPLETE_BIT);
+			/* SR is rc_w0, writing 0 to TC alone leaves RXNE and the other flags as they are */
+			((USART_t*)USART6)->SR=~(1UL<<TRANSMIT_COMPLETE_BIT);
 			((USART_t*)USART6)->DR = Uart_prvTX_BufferSend[USART_6][Uart_prvTX_BufferIndex[USART_6]];
 			Uart_prvTX_BufferIndex[USART_6]++;
 		}/*end of else*/
 	}/*end of if*/		
 
+	NVIC_ISR_EXIT(NVIC_IRQ_USART6);
 }/*nd of function USART2_IRQHandler*/
\ No newline at end of file
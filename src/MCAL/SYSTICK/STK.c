@@ -3,6 +3,8 @@
 /********************************************************************************************************/
 #include "STD_TYPES.h"
 #include "STK/STK.h"
+#include "MRCC/RCC.h"
+#include "MNVIC/MNVIC.h"
 
 
 /********************************************************************************************************/
@@ -19,8 +21,18 @@
 #define STK_AHB_DIV_8_ENABLE                  0x0
 #define STK_AHB_ENABLE                        0x4
 
-#define STK_MAX_PREELOAD_VALUE                167777215
-#define STK_MAX_TIME_MS                       (STK_MAX_PREELOAD_VALUE*(u32)1000)/STK_CLOCK_SOURCE
+#define STK_MAX_PREELOAD_VALUE                0x00FFFFFFUL
+/*Shortest period kept by a clock change, LOAD 0 would stop the interrupts and mark the timer as not set*/
+#define STK_MIN_RESCALED_TICKS                2
+/*Shortest rest of the current period after a clock change, long enough to see the reload before LOAD is written again*/
+#define STK_MIN_REMAINING_TICKS               64
+#if STK_CLOCK_SOURCE==STK_AHB
+#define STK_CLOCK_DIVIDER                     1
+#elif STK_CLOCK_SOURCE==STK_AHB_DIV_8
+#define STK_CLOCK_DIVIDER                     8
+#else
+#error "invalid option"
+#endif
 
 /********************************************************************************************************/
 /************************************************Types***************************************************/
@@ -34,7 +46,7 @@ typedef struct {
 }STK_t;
 
 
-static u32 Clock_source ;
+static u32 Clock_source ;   /* SysTick clock in Hz, HCLK or HCLK/8 */
 
 /********************************************************************************************************/
 /************************************************Variables***********************************************/
@@ -47,6 +59,8 @@ u8 STK_Periodic = 0;              /*Flag to indicate whether the interval is per
 /*****************************************Static Functions Prototype*************************************/
 /********************************************************************************************************/
 static STK_CBF_t CallBack;   /*Pointer to a function to be called back during the interval*/
+static tenu_ErrorStatus STK_MsToLoad(u32 Copy_MSTime, u32 *ADD_Load);
+static void STK_ClockChanged(void);
 
 
 /********************************************************************************************************/
@@ -58,26 +72,26 @@ void MSTK_Init (void){
 	STK->STK_CTRL=STK_CLR_REG;         /*Clear control register*/
     #if STK_CLOCK_SOURCE==STK_AHB
 	     STK->STK_CTRL=STK_AHB_ENABLE;   /*Set the clock source to AHB*/
-	     Clock_source=STK_AHB;
     #elif STK_CLOCK_SOURCE==STK_AHB_DIV_8
 	     STK->STK_CTRL=STK_AHB_DIV_8_ENABLE;  /*Set the clock source to AHB/8*/
-	     Clock_source=STK_AHB_DIV_8 ;
-
     #else
          #error "invalid option"
 #endif
+	Clock_source=MRCC_GetHCLKHz()/STK_CLOCK_DIVIDER;
+	MRCC_SubscribeClockChange(STK_ClockChanged);   /*keep the programmed period when HCLK changes*/
 
 }
 /*********************************************MSTK_SetTimerMS Implementation****************************************/
 tenu_ErrorStatus MSTK_SetTimerMS (u32 Copy_MSTime){
 	tenu_ErrorStatus Local_EroorStatus=LBTY_OK;
-	if(Copy_MSTime>STK_MAX_TIME_MS)
+	u32 Local_Load;
+	if(STK_MsToLoad(Copy_MSTime,&Local_Load)!=LBTY_OK)
 	{
 		Local_EroorStatus=LBTY_ErrorInvalidInput;
 	}
 	else
 	{
-		STK->STK_LOAD=((Copy_MSTime*Clock_source)/1000UL)-1;
+		STK->STK_LOAD=Local_Load;
 	}
 
 	return Local_EroorStatus;
@@ -120,13 +134,14 @@ tenu_ErrorStatus MSTK_SetSTKCallBack(STK_CBF_t Fptr){
 
 tenu_ErrorStatus MSTK_SetBusyWaitMS(u32 Copy_MSTime){
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
-	if(Copy_MSTime>STK_MAX_TIME_MS)
+	u32 Local_Load;
+	if(STK_MsToLoad(Copy_MSTime,&Local_Load)!=LBTY_OK)
 	{
 		Local_ErrorStatus=LBTY_ErrorInvalidInput;
 	}
 	else
 	{
-		STK->STK_LOAD=((Copy_MSTime*Clock_source)/1000UL)-1;       /*Load the number of ticks (converted from microseconds to milliseconds)*/
+		STK->STK_LOAD=Local_Load;       /*Load the number of ticks (converted from microseconds to milliseconds)*/
 		STK->STK_CTRL|=(1<<STK_ENABLE_BIT);  /*Enable the timer*/
 		while(((STK->STK_CTRL>>STK_COUNT_FLAG_BIT)&0X01)==0); /*Wait until the count flag is set*/
 		STK->STK_CTRL&=(~(1<<STK_ENABLE_BIT));                /*Disable the timer*/
@@ -140,18 +155,19 @@ tenu_ErrorStatus MSTK_SetBusyWaitMS(u32 Copy_MSTime){
 
 tenu_ErrorStatus MSTK_SetIntervalSingleMS(u32 Copy_MSTime, STK_CBF_t Fptr){
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_Load;
 	if(Fptr==NULL)
 	{
 		Local_ErrorStatus=LBTY_ErrorNullPointer;
 	}
-	else if(Copy_MSTime>STK_MAX_TIME_MS)
+	else if(STK_MsToLoad(Copy_MSTime,&Local_Load)!=LBTY_OK)
 	{
 		Local_ErrorStatus=LBTY_ErrorInvalidInput;
 	}
 	else
 	{
 		STK_Periodic=0;                     /*Set the interval as single*/
-		STK->STK_LOAD=((Copy_MSTime*Clock_source)/1000UL)-1;      /*Load the number of ticks (converted to microseconds)*/
+		STK->STK_LOAD=Local_Load;      /*Load the number of ticks (converted to microseconds)*/
 		CallBack=Fptr;                      /*Set the callback function*/
 		STK->STK_CTRL|=(1<<STK_ENABLE_BIT); /*Enable the timer*/
 		STK->STK_CTRL|=(1<<STK_TICKINT_BIT);/*Enable the SysTick interrupt*/
@@ -164,18 +180,19 @@ tenu_ErrorStatus MSTK_SetIntervalSingleMS(u32 Copy_MSTime, STK_CBF_t Fptr){
 
 tenu_ErrorStatus MSTK_SetIntervalPeriodicMS(u32 Copy_MSTime, STK_CBF_t Fptr ){
 	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u32 Local_Load;
 	if(Fptr==NULL)
 	{
 		Local_ErrorStatus=LBTY_ErrorNullPointer;
 	}
-	else if(Copy_MSTime>STK_MAX_TIME_MS)
+	else if(STK_MsToLoad(Copy_MSTime,&Local_Load)!=LBTY_OK)
 	{
 		Local_ErrorStatus=LBTY_ErrorInvalidInput;
 	}
 	else
 	{
 		STK_Periodic=1;                     /*Set the interval as periodic*/
-		STK->STK_LOAD=((Copy_MSTime*Clock_source)/1000)-1;      /*Load the number of ticks (converted to microseconds)*/
+		STK->STK_LOAD=Local_Load;      /*Load the number of ticks (converted to microseconds)*/
 		CallBack=Fptr;                      /*Set the callback function*/
 		STK->STK_CTRL|=(1<<STK_ENABLE_BIT); /*Enable the timer*/
 		STK->STK_CTRL|=(1<<STK_TICKINT_BIT);/*Enable the SysTick interrupt*/
@@ -225,6 +242,80 @@ tenu_ErrorStatus  MSTK_GetRemainingTimeMS(u32 *ADD_RemainingTime){
 
 }
 
+/*********************************************MSTK_GetCounterValue Implementation*********************************/
+u32 MSTK_GetCounterValue(void){
+	return STK->STK_VAL;
+}
+/*********************************************MSTK_GetReloadValue Implementation*********************************/
+u32 MSTK_GetReloadValue(void){
+	return STK->STK_LOAD;
+}
+/*********************************************Static Functions Implementation***************************************/
+/*Converts a time in ms to a LOAD value at the current clock, LBTY_NOK if it does not fit the 24 bits*/
+static tenu_ErrorStatus STK_MsToLoad(u32 Copy_MSTime, u32 *ADD_Load)
+{
+	tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+	u64 Local_Ticks=((u64)Copy_MSTime*Clock_source)/1000UL;
+	if((Local_Ticks==0)||(Local_Ticks>(STK_MAX_PREELOAD_VALUE+1)))
+	{
+		Local_ErrorStatus=LBTY_NOK;
+	}
+	else
+	{
+		*ADD_Load=(u32)Local_Ticks-1;
+	}
+	return Local_ErrorStatus;
+}
+/*Clock change subscriber, scales LOAD so that the programmed time stays the same.
+ *VAL can't be written with a value (any write clears it), so the rest of the current period is run as a
+ *period of its own: LOAD gets the rest scaled to the new clock, VAL is cleared so the counter reloads it on
+ *the next SysTick clock, then LOAD gets the new full period for the reload at the end of that short one.*/
+static void STK_ClockChanged(void)
+{
+	u32 Local_OldClock=Clock_source;
+	u32 Local_Primask;
+	u64 Local_Ticks;
+	u64 Local_Remaining;
+	Clock_source=MRCC_GetHCLKHz()/STK_CLOCK_DIVIDER;
+	if((Local_OldClock!=Clock_source)&&(STK->STK_LOAD!=STK_CLR_REG))
+	{
+		Local_Ticks=(((u64)STK->STK_LOAD+1)*Clock_source)/Local_OldClock;
+		if(Local_Ticks>(STK_MAX_PREELOAD_VALUE+1))
+		{
+			Local_Ticks=STK_MAX_PREELOAD_VALUE+1;
+		}
+		else if(Local_Ticks<STK_MIN_RESCALED_TICKS)
+		{
+			/*a tiny period rounds to 0 ticks on a slower clock, 0-1 would give the longest period instead*/
+			Local_Ticks=STK_MIN_RESCALED_TICKS;
+		}
+		Local_Primask=MNVIC_EnterCritical();
+		if(((STK->STK_CTRL>>STK_ENABLE_BIT)&0x01)==0)
+		{
+			STK->STK_LOAD=(u32)Local_Ticks-1;
+		}
+		else
+		{
+			/*the counter already runs on the new clock, VAL is still a count of the old one*/
+			Local_Remaining=((u64)STK->STK_VAL*Clock_source)/Local_OldClock;
+			if(Local_Remaining>Local_Ticks)
+			{
+				Local_Remaining=Local_Ticks;
+			}
+			else if(Local_Remaining<STK_MIN_REMAINING_TICKS)
+			{
+				Local_Remaining=STK_MIN_REMAINING_TICKS;
+			}
+			STK->STK_LOAD=(u32)Local_Remaining-1;
+			STK->STK_VAL=STK_CLR_REG;
+			/*VAL reads 0 until the reload, the short period is then counting down and LOAD is free again*/
+			while(STK->STK_VAL==STK_CLR_REG);
+			STK->STK_LOAD=(u32)Local_Ticks-1;
+		}
+		MNVIC_ExitCritical(Local_Primask);
+	}
+}
+
 /**
  * @brief SysTick Timer Interrupt Handler.
  *
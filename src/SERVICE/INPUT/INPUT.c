@@ -0,0 +1,259 @@
+/********************************************************************************************************/
+/************************************************Includes************************************************/
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "SERVICE/INPUT/INPUT.h"
+#include "SERVICE/SCHED/SCHED.h"
+#include "HKPD/KYD.h"
+#include "HSWITCH/SWITCH.h"
+#include "Bit_Math.h"
+#include "Atomic.h"
+
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#if (INPUT_QUEUE_SIZE&(INPUT_QUEUE_SIZE-1))!=0
+#error "INPUT_QUEUE_SIZE must be a power of 2"
+#endif
+#define INPUT_QUEUE_MASK            (INPUT_QUEUE_SIZE-1)
+
+#if INPUT_KPD==INPUT_ENABLE
+#define INPUT_KPD_KEYS              (KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS)
+#else
+#define INPUT_KPD_KEYS              0
+#endif
+#if INPUT_SWITCH==INPUT_ENABLE
+#define INPUT_SWITCH_KEYS           _NUM_SWITCH
+#else
+#define INPUT_SWITCH_KEYS           0
+#endif
+/* The keys of both sources share the timing tables, the switches come after the keypad */
+#define INPUT_KEYS_NUM              (INPUT_KPD_KEYS+INPUT_SWITCH_KEYS)
+#define INPUT_SOURCES_NUM           2
+
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    u32 Held;       // Keys pressed, from the edges
+    u32 Long;       // Held keys that already gave their long press event
+    u8 FirstKey;    // Index of the first key of the source in the timing tables
+}InputSource_tstr;
+
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+/* Single producer (INPUT_Runnable), every consumer keeps its own cursor.
+ * InputHead counts all the events ever pushed, the slot of event n is n&INPUT_QUEUE_MASK. */
+static InputEvent_tstr InputQueue[INPUT_QUEUE_SIZE];
+static volatile u32 InputHead=0;
+static u32 InputCursor[_INPUT_CONSUMER_NUM];
+static u32 InputLost[_INPUT_CONSUMER_NUM];
+
+static InputSource_tstr InputSources[INPUT_SOURCES_NUM]={
+    [INPUT_SOURCE_KPD]={.FirstKey=0},
+    [INPUT_SOURCE_SWITCH]={.FirstKey=INPUT_KPD_KEYS},
+};
+#if INPUT_KEYS_NUM>0
+static u32 InputPressMs[INPUT_KEYS_NUM];     // Time of the press of each held key
+static u32 InputNextMs[INPUT_KEYS_NUM];      // Time of the next repeat event
+#endif
+
+
+/********************************************************************************************************/
+/*****************************************Static Functions Prototype*************************************/
+/********************************************************************************************************/
+static void INPUT_Push(u8 Copy_Source, u8 Copy_Type, u8 Copy_Index, u32 Copy_TimeMs);
+static void INPUT_ProcessSource(u8 Copy_Source, u32 Copy_Press, u32 Copy_Release, u32 Copy_TimeMs);
+
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void INPUT_Init(void)
+{
+    u8 idx=0;
+    for(idx=0;idx<_INPUT_CONSUMER_NUM;idx++)
+    {
+        InputCursor[idx]=InputHead;
+        InputLost[idx]=0;
+    }
+    for(idx=0;idx<INPUT_SOURCES_NUM;idx++)
+    {
+        InputSources[idx].Held=0;
+        InputSources[idx].Long=0;
+    }
+}
+
+void INPUT_Runnable(void)
+{
+    u32 Local_TimeMs=Sched_GetTimeMs();
+#if INPUT_KPD==INPUT_ENABLE
+    u16 Local_KpdPress;
+    u16 Local_KpdRelease;
+    if(KPD_GetTransitions(&Local_KpdPress,&Local_KpdRelease)==LBTY_OK)
+    {
+        INPUT_ProcessSource(INPUT_SOURCE_KPD,Local_KpdPress,Local_KpdRelease,Local_TimeMs);
+    }
+#endif
+#if INPUT_SWITCH==INPUT_ENABLE
+    u32 Local_SwPress;
+    u32 Local_SwRelease;
+    if(HSWITCH_GetEdges(&Local_SwPress,&Local_SwRelease)==LBTY_OK)
+    {
+        INPUT_ProcessSource(INPUT_SOURCE_SWITCH,Local_SwPress,Local_SwRelease,Local_TimeMs);
+    }
+#endif
+    (void)Local_TimeMs;
+}
+
+tenu_ErrorStatus INPUT_GetEvent(u8 Copy_Consumer, InputEvent_tstr *ADD_Event)
+{
+    tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+    u32 Local_Head;
+    u32 Local_Cursor;
+    if(Copy_Consumer>=_INPUT_CONSUMER_NUM)
+    {
+        Local_ErrorStatus=LBTY_ErrorInvalidInput;
+    }
+    else if(ADD_Event==NULL)
+    {
+        Local_ErrorStatus=LBTY_ErrorNullPointer;
+    }
+    else
+    {
+        Local_Cursor=InputCursor[Copy_Consumer];
+        do
+        {
+            Local_Head=ATOMIC_LOAD_ACQUIRE(InputHead);
+            if(Local_Head==Local_Cursor)
+            {
+                Local_ErrorStatus=LBTY_NOK;
+                break;
+            }
+            /* the slot of Local_Head is being written, only the INPUT_QUEUE_SIZE-1 events before it are valid */
+            if((Local_Head-Local_Cursor)>=INPUT_QUEUE_SIZE)
+            {
+                InputLost[Copy_Consumer]+=(Local_Head-Local_Cursor)-(INPUT_QUEUE_SIZE-1);
+                Local_Cursor=Local_Head-(INPUT_QUEUE_SIZE-1);
+            }
+            *ADD_Event=InputQueue[Local_Cursor&INPUT_QUEUE_MASK];
+            ATOMIC_ACQUIRE_FENCE();
+            /* retry if the producer got to the slot while it was copied */
+        }while((ATOMIC_LOAD_RELAXED(InputHead)-Local_Cursor)>=INPUT_QUEUE_SIZE);
+        if(Local_ErrorStatus==LBTY_OK)
+        {
+            Local_Cursor++;
+        }
+        InputCursor[Copy_Consumer]=Local_Cursor;
+    }
+    return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus INPUT_GetLostEvents(u8 Copy_Consumer, u32 *ADD_Lost)
+{
+    tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+    if(Copy_Consumer>=_INPUT_CONSUMER_NUM)
+    {
+        Local_ErrorStatus=LBTY_ErrorInvalidInput;
+    }
+    else if(ADD_Lost==NULL)
+    {
+        Local_ErrorStatus=LBTY_ErrorNullPointer;
+    }
+    else
+    {
+        *ADD_Lost=InputLost[Copy_Consumer];
+        InputLost[Copy_Consumer]=0;
+    }
+    return Local_ErrorStatus;
+}
+
+
+/********************************************************************************************************/
+/*********************************************Static Functions*******************************************/
+/********************************************************************************************************/
+static void INPUT_Push(u8 Copy_Source, u8 Copy_Type, u8 Copy_Index, u32 Copy_TimeMs)
+{
+    u32 Local_Head=InputHead;
+    InputEvent_tstr * Local_pEvent=&InputQueue[Local_Head&INPUT_QUEUE_MASK];
+    u8 Local_Key=Copy_Index;
+#if INPUT_KPD==INPUT_ENABLE
+    if(Copy_Source==INPUT_SOURCE_KPD)
+    {
+        KPD_GetKeyName(Copy_Index,&Local_Key);
+    }
+#endif
+    Local_pEvent->TimeMs=Copy_TimeMs;
+    Local_pEvent->Source=Copy_Source;
+    Local_pEvent->Type=Copy_Type;
+    Local_pEvent->Index=Copy_Index;
+    Local_pEvent->Key=Local_Key;
+    /* publish the event once it is complete */
+    ATOMIC_STORE_RELEASE(InputHead,Local_Head+1);
+}
+
+/**
+ * @brief Turns the edges of a source into events and times its held keys.
+ *
+ * A key with both a press and a release edge was tapped between two runs: it gives a release then a press
+ * if it was held before, a press then a release otherwise.
+ */
+static void INPUT_ProcessSource(u8 Copy_Source, u32 Copy_Press, u32 Copy_Release, u32 Copy_TimeMs)
+{
+#if INPUT_KEYS_NUM>0
+    InputSource_tstr * Local_pSource=&InputSources[Copy_Source];
+    u32 Local_Keys=Copy_Press|Copy_Release|Local_pSource->Held;
+    u32 Local_Mask;
+    u8 Local_Key;
+    u8 Local_Slot;
+    while(Local_Keys)
+    {
+        Local_Key=GET_LOWEST_SET_BIT(Local_Keys);
+        Local_Mask=1UL<<Local_Key;
+        Local_Keys&=~Local_Mask;
+        Local_Slot=Local_pSource->FirstKey+Local_Key;
+        if((Copy_Release&Local_Mask)&&(Local_pSource->Held&Local_Mask))
+        {
+            INPUT_Push(Copy_Source,INPUT_EVENT_RELEASE,Local_Key,Copy_TimeMs);
+            Local_pSource->Held&=~Local_Mask;
+            Copy_Release&=~Local_Mask;
+        }
+        if(Copy_Press&Local_Mask)
+        {
+            INPUT_Push(Copy_Source,INPUT_EVENT_PRESS,Local_Key,Copy_TimeMs);
+            Local_pSource->Held|=Local_Mask;
+            Local_pSource->Long&=~Local_Mask;
+            InputPressMs[Local_Slot]=Copy_TimeMs;
+        }
+        if(Copy_Release&Local_Mask)
+        {
+            INPUT_Push(Copy_Source,INPUT_EVENT_RELEASE,Local_Key,Copy_TimeMs);
+            Local_pSource->Held&=~Local_Mask;
+        }
+        if(Local_pSource->Held&Local_Mask)
+        {
+            if(!(Local_pSource->Long&Local_Mask))
+            {
+                if((Copy_TimeMs-InputPressMs[Local_Slot])>=INPUT_LONG_PRESS_MS)
+                {
+                    INPUT_Push(Copy_Source,INPUT_EVENT_LONG_PRESS,Local_Key,Copy_TimeMs);
+                    Local_pSource->Long|=Local_Mask;
+                    InputNextMs[Local_Slot]=Copy_TimeMs+INPUT_REPEAT_MS;
+                }
+            }
+#if INPUT_REPEAT_MS>0
+            else if((s32)(Copy_TimeMs-InputNextMs[Local_Slot])>=0)
+            {
+                INPUT_Push(Copy_Source,INPUT_EVENT_REPEAT,Local_Key,Copy_TimeMs);
+                InputNextMs[Local_Slot]+=INPUT_REPEAT_MS;
+            }
+#endif
+        }
+    }
+#endif
+}
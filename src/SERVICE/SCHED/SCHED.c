@@ -4,6 +4,9 @@
 #include "STD_TYPES.h"
 #include "SERVICE/SCHED/SCHED.h"
 #include "HLED/LED.h"
+#if SCHED_GOVERNOR==SCHED_ENABLE
+#include "MRCC/RCC.h"
+#endif
 
 
 /********************************************************************************************************/
@@ -22,6 +25,7 @@ typedef struct
 {
     Runnable_tstr *Runnable;
     u32 RemainTimeMs;
+    u32 NextDelayMs;    // Set by Sched_SetNextDelay, replaces the periodicity once
 }RunnableInfo_tstr;
 
 RunnableInfo_tstr Runnable_array[_RUNNABLE_NUM];
@@ -31,6 +35,16 @@ RunnableInfo_tstr Runnable_array[_RUNNABLE_NUM];
 /************************************************Variables***********************************************/
 /********************************************************************************************************/
  u32 PendingTicks=0;
+/* Time since the scheduler started, updated by the tick interrupt */
+static volatile u32 SchedTimeMs=0;
+static SchedStats_tstr SchedStats;
+static u64 SchedWindowBusy=0;     // SysTick counts spent in Sched during the window
+static u32 SchedWindowTicks=0;
+static u8 SchedWindowMissed=0;    // A tick was missed during the window
+#if SCHED_GOVERNOR==SCHED_ENABLE
+extern const u8 SchedGovernorPlans[SCHED_GOV_PLANS_NUM];
+static u8 SchedLowWindows=0;      // Consecutive windows light enough for the slower plan
+#endif
 
 
 /********************************************************************************************************/
@@ -44,6 +58,27 @@ RunnableInfo_tstr Runnable_array[_RUNNABLE_NUM];
  * whether the interval is periodic or single.
  */
  void TickCb(void);
+/**
+ * @brief Reads the scheduler time and the SysTick counter of the same tick.
+ */
+static void Sched_Stamp(u32 *ADD_TimeMs, u32 *ADD_Counter);
+/**
+ * @brief Runs Sched for one pending tick and adds its busy time to the load window.
+ */
+static void Sched_RunPending(void);
+/**
+ * @brief Closes a load window when it is complete, and runs the governor on it.
+ */
+static void Sched_EndWindow(void);
+#if SCHED_GOVERNOR==SCHED_ENABLE
+/**
+ * @brief Picks the clock plan for the load of the last window and applies it.
+ *
+ * The fastest plan is taken at once for a heavy window or a missed tick, a slower one only after
+ * SCHED_GOV_DOWN_WINDOWS windows where the load scaled to its frequency stays under the target.
+ */
+static void Sched_Govern(u16 Copy_LoadPermille);
+#endif
 
 
 /********************************************************************************************************/
@@ -61,6 +96,7 @@ void Sched_Init(void)
         Runnable_array[idx].Runnable->PeriodicityMs=Runnables[idx].PeriodicityMs;
         Runnable_array[idx].Runnable->Priority=Runnables[idx].Priority;*/
         Runnable_array[idx].RemainTimeMs=Runnables[idx].FirstDelayMs;
+        Runnable_array[idx].NextDelayMs=SCHED_NO_DELAY;
 
 
     }
@@ -81,26 +117,157 @@ void Sched_Init(void)
 void TickCb(void)
 {
 	PendingTicks++;
+	SchedTimeMs+=TICK_TIME;
+}
+
+tenu_ErrorStatus Sched_SetNextDelay(u32 Copy_Runnable, u32 Copy_DelayMs)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    if(Copy_Runnable>=_RUNNABLE_NUM||Copy_DelayMs==0||Copy_DelayMs==SCHED_NO_DELAY)
+    {
+        Local_ErrorStatus=LBTY_ErrorInvalidInput;
+    }
+    else
+    {
+        Runnable_array[Copy_Runnable].NextDelayMs=Copy_DelayMs;
+    }
+    return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus Sched_GetStats(SchedStats_tstr *ADD_Stats)
+{
+    tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+    if(ADD_Stats==NULL)
+    {
+        Local_ErrorStatus=LBTY_ErrorNullPointer;
+    }
+    else
+    {
+        *ADD_Stats=SchedStats;
+    }
+    return Local_ErrorStatus;
+}
+
+static void Sched_Stamp(u32 *ADD_TimeMs, u32 *ADD_Counter)
+{
+    /* read again if the tick interrupt came in between */
+    do
+    {
+        *ADD_TimeMs=SchedTimeMs;
+        *ADD_Counter=MSTK_GetCounterValue();
+    }while(*ADD_TimeMs!=SchedTimeMs);
+}
+
+static void Sched_EndWindow(void)
+{
+    u16 Local_LoadPermille;
+    if(SchedWindowTicks>=SCHED_LOAD_WINDOW_MS)
+    {
+        Local_LoadPermille=(u16)((SchedWindowBusy*1000)/((u64)SchedWindowTicks*(MSTK_GetReloadValue()+1)));
+        if(Local_LoadPermille>1000)
+        {
+            Local_LoadPermille=1000;
+        }
+        SchedStats.LoadPermille=Local_LoadPermille;
+        if(Local_LoadPermille>SchedStats.PeakLoadPermille)
+        {
+            SchedStats.PeakLoadPermille=Local_LoadPermille;
+        }
+#if SCHED_GOVERNOR==SCHED_ENABLE
+        Sched_Govern(Local_LoadPermille);
+#endif
+        SchedWindowBusy=0;
+        SchedWindowTicks=0;
+        SchedWindowMissed=0;
+    }
+}
+
+#if SCHED_GOVERNOR==SCHED_ENABLE
+static void Sched_Govern(u16 Copy_LoadPermille)
+{
+    u8 Local_Plan=SchedStats.PlanIndex;
+    u32 Local_CurrentHz;
+    u32 Local_SlowerHz;
+    if((Copy_LoadPermille>=SCHED_GOV_UP_PERMILLE)||SchedWindowMissed)
+    {
+        Local_Plan=SCHED_GOV_PLANS_NUM-1;
+        SchedLowWindows=0;
+    }
+    else if((Local_Plan>0)&&
+            (MRCC_GetPlanHCLKHz(&RCC_ClockPlans[SchedGovernorPlans[Local_Plan]],&Local_CurrentHz)==LBTY_OK)&&
+            (MRCC_GetPlanHCLKHz(&RCC_ClockPlans[SchedGovernorPlans[Local_Plan-1]],&Local_SlowerHz)==LBTY_OK)&&
+            ((((u64)Copy_LoadPermille*Local_CurrentHz)/Local_SlowerHz)<SCHED_GOV_TARGET_PERMILLE))
+    {
+        SchedLowWindows++;
+        if(SchedLowWindows>=SCHED_GOV_DOWN_WINDOWS)
+        {
+            Local_Plan--;
+            SchedLowWindows=0;
+        }
+    }
+    else
+    {
+        SchedLowWindows=0;
+    }
+    if(Local_Plan!=SchedStats.PlanIndex)
+    {
+        /* SysTick and the USART baud rates follow through the MRCC clock subscribers */
+        if(MRCC_ConfigureSystemClock(&RCC_ClockPlans[SchedGovernorPlans[Local_Plan]])==LBTY_OK)
+        {
+            SchedStats.PlanIndex=Local_Plan;
+            SchedStats.ClockSwitches++;
+        }
+    }
+}
+#endif
+
+u32 Sched_GetTimeMs(void)
+{
+	return SchedTimeMs;
 }
 
 tenu_ErrorStatus StartSched(void)
 {
     tenu_ErrorStatus Local_ErrorStatus = LBTY_OK;
+#if SCHED_GOVERNOR==SCHED_ENABLE
+    /* start fast, the governor slows down once the load is known */
+    SchedStats.PlanIndex=SCHED_GOV_PLANS_NUM-1;
+    MRCC_ConfigureSystemClock(&RCC_ClockPlans[SchedGovernorPlans[SchedStats.PlanIndex]]);
+#endif
 	Local_ErrorStatus = MSTK_StartTimerMSPeriodic();
 	while(1)
 	{
-		// if pendingTicks is greater than one, it means
-		// that cpu load is over 100%, because two syscalls
-		// occurred when sched was already running
-		if(PendingTicks)
-		{
-			PendingTicks--;
+		Sched_RunPending();
+	}
+    return Local_ErrorStatus;
+}
 
-            Sched();
-			
+static void Sched_RunPending(void)
+{
+    u32 Local_StartMs;
+    u32 Local_StartCounter;
+    u32 Local_EndMs;
+    u32 Local_EndCounter;
+	// if pendingTicks is greater than one, it means
+	// that cpu load is over 100%, because two syscalls
+	// occurred when sched was already running
+	if(PendingTicks)
+	{
+		if(PendingTicks>1)
+		{
+			SchedStats.MissedTicks++;
+			SchedWindowMissed=1;
 		}
+		PendingTicks--;
+
+		Sched_Stamp(&Local_StartMs,&Local_StartCounter);
+        Sched();
+		Sched_Stamp(&Local_EndMs,&Local_EndCounter);
+		/* the counter goes down from LOAD to 0 once per ms */
+		SchedWindowBusy+=((u64)(Local_EndMs-Local_StartMs)*(MSTK_GetReloadValue()+1))+Local_StartCounter-Local_EndCounter;
+		SchedWindowTicks++;
+		Sched_EndWindow();
 	}
-    return Local_ErrorStatus;
 }
 
 tenu_ErrorStatus Sched(void){
@@ -112,7 +279,15 @@ tenu_ErrorStatus Sched(void){
         if(Runnable_array[idx].Runnable->CallBack&&Runnable_array[idx].RemainTimeMs==0)
         {
             Runnable_array[idx].Runnable->CallBack();
-            Runnable_array[idx].RemainTimeMs=Runnable_array[idx].Runnable->PeriodicityMs;
+            if(Runnable_array[idx].NextDelayMs!=SCHED_NO_DELAY)
+            {
+                Runnable_array[idx].RemainTimeMs=Runnable_array[idx].NextDelayMs;
+                Runnable_array[idx].NextDelayMs=SCHED_NO_DELAY;
+            }
+            else
+            {
+                Runnable_array[idx].RemainTimeMs=Runnable_array[idx].Runnable->PeriodicityMs;
+            }
 
         }
         else{
@@ -3,12 +3,15 @@
 /********************************************************************************************************/
 #include "STD_TYPES.h"
 #include "SERVICE/SCHED/SCHED.h"
+#include "MRCC/RCC.h"
 
 
 /********************************************************************************************************/
 /************************************************externs*************************************************/
 /********************************************************************************************************/
 extern void HSWITCH_Runnable(void);
+extern void KPD_Runnable(void);
+extern void INPUT_Runnable(void);
 extern void APP1_RunnableFunc(void);
 extern void APP2_RunnableFunc(void);
 extern void TrafficLights (void);
@@ -22,6 +25,8 @@ extern void TrafficLights (void);
 /********************************************************************************************************/
 Runnable_tstr Runnables[_RUNNABLE_NUM]={
     [SW_Runnable]={.PeriodicityMs=5,.FirstDelayMs=1,.CallBack=HSWITCH_Runnable,.Priority=SW_Runnable},
+    [KPDScan_Runnable]={.PeriodicityMs=5,.FirstDelayMs=2,.CallBack=KPD_Runnable,.Priority=KPDScan_Runnable},
+    [InputEvents_Runnable]={.PeriodicityMs=10,.FirstDelayMs=3,.CallBack=INPUT_Runnable,.Priority=InputEvents_Runnable},
     [APP1_Runnable]={.PeriodicityMs=50,.FirstDelayMs=5,.CallBack=APP1_RunnableFunc,.Priority=APP1_Runnable},
     [APP2_Runnable]={.PeriodicityMs=50,.FirstDelayMs=6,.CallBack=APP2_RunnableFunc,.Priority=APP2_Runnable},
 	[TrafficLight_Runnable]={.PeriodicityMs=2000,.FirstDelayMs=2,.CallBack=TrafficLights,.Priority=TrafficLight_Runnable},
@@ -30,3 +35,12 @@ Runnable_tstr Runnables[_RUNNABLE_NUM]={
 };
  
 
+
+#if SCHED_GOVERNOR==SCHED_ENABLE
+/* Clock plans of the governor, from the slowest to the fastest, the scheduler starts on the last one */
+const u8 SchedGovernorPlans[SCHED_GOV_PLANS_NUM]={
+    RCC_PLAN_HSI_16MHZ,
+    RCC_PLAN_HSI_PLL_42MHZ,
+    RCC_PLAN_HSI_PLL_84MHZ,
+};
+#endif
@@ -0,0 +1,315 @@
+/********************************************************************************************************/
+/* File             :       hd44780.c                                                                   */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Behavioral model of an HD44780 controller on the RAM GPIO ports.           */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "MGPIO/GPIO.h"
+#include "HCLCD/LCD.h"
+#include "host_mcal.h"
+#include "hd44780.h"
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define HD44780_MODELS_MAX          4
+#define HD44780_BUSY_FLAG           0x80
+#define HD44780_AC_MASK             0x7F
+#define HD44780_CG_MASK             0x3F
+#define HD44780_SECOND_LINE         0x40
+#define HD44780_LINE_END            0x28 // One past the last address of a line in 2-line mode
+#define HD44780_BLANK               ' '
+
+/* Instructions, from the highest set bit */
+#define HD44780_CMD_CLEAR           0x01
+#define HD44780_CMD_HOME            0x02
+#define HD44780_CMD_ENTRY           0x04
+#define HD44780_CMD_DISPLAY         0x08
+#define HD44780_CMD_SHIFT           0x10
+#define HD44780_CMD_FUNCTION        0x20
+#define HD44780_CMD_CGRAM           0x40
+#define HD44780_CMD_DDRAM           0x80
+#define HD44780_ENTRY_INC           0x02
+#define HD44780_DISPLAY_ON          0x04
+#define HD44780_SHIFT_DISPLAY       0x08
+#define HD44780_SHIFT_RIGHT         0x04
+#define HD44780_FUNCTION_DL         0x10
+#define HD44780_FUNCTION_N          0x08
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+static HD44780_tstr * HD44780_Models[HD44780_MODELS_MAX];
+static u8 HD44780_ModelsNum;
+static u64 HD44780_NowNs;
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static u8 HD44780_ReadLine(const LCDSCfg_tstr * Add_pPin)
+{
+    return Host_GetOutput(Add_pPin->Port,(u8)Add_pPin->Pin);
+}
+
+/* Value on the data lines, D0..D7 in 8-bit mode, D4..D7 in the low bits in 4-bit mode */
+static u8 HD44780_ReadBus(const HD44780_tstr * Add_pModel)
+{
+    u8 Local_Value=0;
+    u8 Local_Index;
+    for(Local_Index=0;Local_Index<Add_pModel->DataPins;Local_Index++)
+    {
+        Local_Value|=(u8)(HD44780_ReadLine(&Add_pModel->Cfg->LCD_data_pins[Local_Index])<<Local_Index);
+    }
+    return Local_Value;
+}
+
+static void HD44780_DriveBus(const HD44780_tstr * Add_pModel, u8 Copy_Value)
+{
+    const LCDSCfg_tstr * Local_pPin;
+    u8 Local_Index;
+    for(Local_Index=0;Local_Index<Add_pModel->DataPins;Local_Index++)
+    {
+        Local_pPin=&Add_pModel->Cfg->LCD_data_pins[Local_Index];
+        Host_DriveInputs(Local_pPin->Port,(u16)(1U<<Local_pPin->Pin),(u16)(((Copy_Value>>Local_Index)&0x01)<<Local_pPin->Pin));
+    }
+}
+
+static void HD44780_ReleaseBus(const HD44780_tstr * Add_pModel)
+{
+    u8 Local_Index;
+    for(Local_Index=0;Local_Index<Add_pModel->DataPins;Local_Index++)
+    {
+        Host_ReleaseInputs(Add_pModel->Cfg->LCD_data_pins[Local_Index].Port,(u16)(1U<<Add_pModel->Cfg->LCD_data_pins[Local_Index].Pin));
+    }
+}
+
+static void HD44780_MoveAC(HD44780_tstr * Add_pModel)
+{
+    if(Add_pModel->CGMode)
+    {
+        Add_pModel->AC=(u8)((Add_pModel->AC+(Add_pModel->Increment?1:-1))&HD44780_CG_MASK);
+    }
+    else if(Add_pModel->Increment)
+    {
+        Add_pModel->AC=(u8)((Add_pModel->AC+1)&HD44780_AC_MASK);
+        if(Add_pModel->TwoLines&&((Add_pModel->AC&~HD44780_SECOND_LINE)==HD44780_LINE_END))
+        {
+            Add_pModel->AC=(Add_pModel->AC&HD44780_SECOND_LINE)^HD44780_SECOND_LINE;
+        }
+    }
+    else
+    {
+        if(Add_pModel->TwoLines&&((Add_pModel->AC&~HD44780_SECOND_LINE)==0))
+        {
+            Add_pModel->AC=(u8)(((Add_pModel->AC&HD44780_SECOND_LINE)^HD44780_SECOND_LINE)+HD44780_LINE_END-1);
+        }
+        else
+        {
+            Add_pModel->AC=(u8)((Add_pModel->AC-1)&HD44780_AC_MASK);
+        }
+    }
+}
+
+static void HD44780_Execute(HD44780_tstr * Add_pModel, u8 Copy_Byte, u8 Copy_RS)
+{
+    u32 Local_ExecNs=HD44780_EXEC_NS;
+    if(HD44780_NowNs<Add_pModel->BusyUntilNs)
+    {
+        Add_pModel->Violations++;
+    }
+    if(Copy_RS)
+    {
+        if(Add_pModel->CGMode)
+        {
+            Add_pModel->CGRAM[Add_pModel->AC&HD44780_CG_MASK]=Copy_Byte;
+        }
+        else
+        {
+            Add_pModel->DDRAM[Add_pModel->AC&HD44780_AC_MASK]=Copy_Byte;
+        }
+        HD44780_MoveAC(Add_pModel);
+        Add_pModel->DataWrites++;
+    }
+    else
+    {
+        Add_pModel->Instructions++;
+        if(Copy_Byte&HD44780_CMD_DDRAM)
+        {
+            Add_pModel->AC=Copy_Byte&HD44780_AC_MASK;
+            Add_pModel->CGMode=0;
+        }
+        else if(Copy_Byte&HD44780_CMD_CGRAM)
+        {
+            Add_pModel->AC=Copy_Byte&HD44780_CG_MASK;
+            Add_pModel->CGMode=1;
+        }
+        else if(Copy_Byte&HD44780_CMD_FUNCTION)
+        {
+            Add_pModel->EightBit=(Copy_Byte&HD44780_FUNCTION_DL)!=0;
+            Add_pModel->TwoLines=(Copy_Byte&HD44780_FUNCTION_N)!=0;
+            Add_pModel->NibblePending=0;
+        }
+        else if(Copy_Byte&HD44780_CMD_SHIFT)
+        {
+            if((Copy_Byte&HD44780_SHIFT_DISPLAY)==0)
+            {
+                u8 Local_Increment=Add_pModel->Increment;
+                Add_pModel->Increment=(Copy_Byte&HD44780_SHIFT_RIGHT)!=0;
+                HD44780_MoveAC(Add_pModel);
+                Add_pModel->Increment=Local_Increment;
+            }
+        }
+        else if(Copy_Byte&HD44780_CMD_DISPLAY)
+        {
+            Add_pModel->DisplayOn=(Copy_Byte&HD44780_DISPLAY_ON)!=0;
+        }
+        else if(Copy_Byte&HD44780_CMD_ENTRY)
+        {
+            Add_pModel->Increment=(Copy_Byte&HD44780_ENTRY_INC)!=0;
+        }
+        else if(Copy_Byte&HD44780_CMD_HOME)
+        {
+            Add_pModel->AC=0;
+            Add_pModel->CGMode=0;
+            Local_ExecNs=HD44780_CLEAR_NS;
+        }
+        else if(Copy_Byte&HD44780_CMD_CLEAR)
+        {
+            memset(Add_pModel->DDRAM,HD44780_BLANK,sizeof(Add_pModel->DDRAM));
+            Add_pModel->AC=0;
+            Add_pModel->CGMode=0;
+            Add_pModel->Increment=1;
+            Local_ExecNs=HD44780_CLEAR_NS;
+        }
+    }
+    Add_pModel->BusyUntilNs=HD44780_NowNs+Local_ExecNs;
+}
+
+/* E rising edge, a read puts BF and AC on the bus until E falls */
+static void HD44780_RisingEdge(HD44780_tstr * Add_pModel)
+{
+    u8 Local_Value;
+    if(HD44780_NowNs<Add_pModel->LastRiseNs+HD44780_E_CYCLE_NS)
+    {
+        HD44780_NowNs=Add_pModel->LastRiseNs+HD44780_E_CYCLE_NS;
+    }
+    Add_pModel->LastRiseNs=HD44780_NowNs;
+    if(HD44780_ReadLine(&Add_pModel->Cfg->R_W_pin))
+    {
+        Local_Value=Add_pModel->AC&HD44780_AC_MASK;
+        if(HD44780_NowNs<Add_pModel->BusyUntilNs)
+        {
+            Local_Value|=HD44780_BUSY_FLAG;
+            if(!Add_pModel->ReadLowNibble)
+            {
+                Add_pModel->BusyReads++;
+            }
+        }
+        if(Add_pModel->DataPins==4)
+        {
+            Local_Value=Add_pModel->ReadLowNibble?(Local_Value&0x0F):(Local_Value>>4);
+        }
+        HD44780_DriveBus(Add_pModel,Local_Value);
+    }
+}
+
+/* E falling edge, a write is latched from the bus */
+static void HD44780_FallingEdge(HD44780_tstr * Add_pModel)
+{
+    u8 Local_Bus;
+    u8 Local_RS=HD44780_ReadLine(&Add_pModel->Cfg->R_S_pin);
+    if(HD44780_ReadLine(&Add_pModel->Cfg->R_W_pin))
+    {
+        HD44780_ReleaseBus(Add_pModel);
+        if(Add_pModel->DataPins==4)
+        {
+            Add_pModel->ReadLowNibble^=1;
+        }
+    }
+    else
+    {
+        Local_Bus=HD44780_ReadBus(Add_pModel);
+        if(Add_pModel->DataPins==8)
+        {
+            HD44780_Execute(Add_pModel,Local_Bus,Local_RS);
+        }
+        else if(Add_pModel->EightBit)
+        {
+            /* 4 wires on an interface still in 8-bit mode, D0..D3 read low */
+            HD44780_Execute(Add_pModel,(u8)(Local_Bus<<4),Local_RS);
+        }
+        else if(!Add_pModel->NibblePending)
+        {
+            Add_pModel->HighNibble=Local_Bus;
+            Add_pModel->NibblePending=1;
+        }
+        else
+        {
+            Add_pModel->NibblePending=0;
+            HD44780_Execute(Add_pModel,(u8)((Add_pModel->HighNibble<<4)|Local_Bus),Local_RS);
+        }
+    }
+}
+
+static void HD44780_OnStore(void* Copy_Port)
+{
+    HD44780_tstr * Local_pModel;
+    u8 Local_Index;
+    u8 Local_E;
+    for(Local_Index=0;Local_Index<HD44780_ModelsNum;Local_Index++)
+    {
+        Local_pModel=HD44780_Models[Local_Index];
+        if(Local_pModel->Cfg->E_pin.Port!=Copy_Port)
+        {
+            continue;
+        }
+        Local_E=HD44780_ReadLine(&Local_pModel->Cfg->E_pin);
+        if(Local_E&&!Local_pModel->LastE)
+        {
+            HD44780_RisingEdge(Local_pModel);
+        }
+        else if(!Local_E&&Local_pModel->LastE)
+        {
+            HD44780_FallingEdge(Local_pModel);
+        }
+        Local_pModel->LastE=Local_E;
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void HD44780_Attach(HD44780_tstr * Add_pModel, const LCD_cfg_t * Add_pCfg)
+{
+    memset(Add_pModel,0,sizeof(*Add_pModel));
+    memset(Add_pModel->DDRAM,HD44780_BLANK,sizeof(Add_pModel->DDRAM));
+    Add_pModel->Cfg=Add_pCfg;
+    Add_pModel->DataPins=(HLCD_MODE==HLCD_MODE_4_BIT)?4:8; // LCD_data_pins keeps 8 entries in 4-bit mode
+    Add_pModel->EightBit=1;
+    Add_pModel->Increment=1;
+    Add_pModel->LastE=HD44780_ReadLine(&Add_pCfg->E_pin);
+    if(HD44780_ModelsNum<HD44780_MODELS_MAX)
+    {
+        HD44780_Models[HD44780_ModelsNum++]=Add_pModel;
+    }
+    Host_SetStoreHook(HD44780_OnStore);
+}
+
+void HD44780_DetachAll(void)
+{
+    HD44780_ModelsNum=0;
+    HD44780_NowNs=0;
+    Host_SetStoreHook(NULL);
+}
+
+void HD44780_AdvanceNs(u32 Copy_Ns)
+{
+    HD44780_NowNs+=Copy_Ns;
+}
+
+void HD44780_GetLine(const HD44780_tstr * Add_pModel, u8 Copy_Line, char * Add_pLine)
+{
+    memcpy(Add_pLine,&Add_pModel->DDRAM[Copy_Line?HD44780_SECOND_LINE:0],HD44780_COLUMNS);
+    Add_pLine[HD44780_COLUMNS]='\0';
+}
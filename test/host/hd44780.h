@@ -0,0 +1,67 @@
+/********************************************************************************************************/
+/* File             :       hd44780.h                                                                   */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Behavioral model of an HD44780 controller wired to the pins of an           */
+/*                          LCD_cfg_t. It decodes RS/RW/E and the data lines on every GPIO store into   */
+/*                          DDRAM/CGRAM writes and instructions, answers busy flag reads and counts the */
+/*                          bytes latched while the controller was still busy.                          */
+/********************************************************************************************************/
+#ifndef TEST_HOST_HD44780_H_
+#define TEST_HOST_HD44780_H_
+
+#include "STD_TYPES.h"
+#include "HCLCD/LCD.h"
+
+#define HD44780_DDRAM_SIZE          0x80
+#define HD44780_CGRAM_SIZE          0x40
+#define HD44780_COLUMNS             16
+#define HD44780_LINES               2
+/* Execution times of the datasheet at 270 kHz */
+#define HD44780_EXEC_NS             37000UL
+#define HD44780_CLEAR_NS            1520000UL
+/* Rise to rise time of E, the model clock moves at least this much on every rising edge */
+#define HD44780_E_CYCLE_NS          1000UL
+
+typedef struct
+{
+    const LCD_cfg_t * Cfg;
+    u8  DataPins;           // 8 or 4, from HLCD_MODE
+    u8  DDRAM[HD44780_DDRAM_SIZE];
+    u8  CGRAM[HD44780_CGRAM_SIZE];
+    u8  AC;                 // Address counter
+    u8  CGMode;             // AC points to CGRAM
+    u8  Increment;          // Entry mode I/D
+    u8  EightBit;           // Function set DL, the controller powers up in 8-bit mode
+    u8  TwoLines;           // Function set N
+    u8  DisplayOn;
+    u8  HighNibble;         // 4-bit mode: first nibble of the byte being received
+    u8  NibblePending;      // 4-bit mode: the high nibble is in, waiting for the low one
+    u8  ReadLowNibble;      // 4-bit mode: the next read gives the low nibble
+    u8  LastE;              // E level at the previous store
+    u64 LastRiseNs;
+    u64 BusyUntilNs;
+    u32 Instructions;       // Instructions executed
+    u32 DataWrites;         // DDRAM and CGRAM bytes written
+    u32 BusyReads;          // Busy flag reads that found the controller busy
+    u32 Violations;         // Bytes latched while the controller was busy
+}HD44780_tstr;
+
+/**
+ * @brief Resets the model to its power-on state, wires it to Add_pCfg and starts watching the GPIO stores.
+ */
+void HD44780_Attach(HD44780_tstr * Add_pModel, const LCD_cfg_t * Add_pCfg);
+/**
+ * @brief Detaches every model, the GPIO stores are no longer decoded.
+ */
+void HD44780_DetachAll(void);
+/**
+ * @brief Moves the clock of every attached model, e.g. by the period of CLCD_TASK between two calls.
+ */
+void HD44780_AdvanceNs(u32 Copy_Ns);
+/**
+ * @brief Copies the 16 character codes shown on a line followed by a NUL, CGRAM characters keep their
+ * code (0 to 7), compare them with memcmp.
+ */
+void HD44780_GetLine(const HD44780_tstr * Add_pModel, u8 Copy_Line, char * Add_pLine);
+
+#endif /* TEST_HOST_HD44780_H_ */
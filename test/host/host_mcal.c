@@ -0,0 +1,291 @@
+/********************************************************************************************************/
+/* File             :       host_mcal.c                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Port logic behind the RAM GPIO registers and the MRCC API of the drivers,  */
+/*                          host_trap.c runs the port logic after every store of a driver.              */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "Bit_Math.h"
+#include "MGPIO/GPIO.h"
+#include "MRCC/RCC.h"
+#include "host_mcal.h"
+#include "host_trap.h"
+#include <stddef.h>
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define HOST_PORTS_NUM          GPIO_PORTS_NUM
+#define HOST_PORT_STEP          0x400
+#define HOST_RESET_HZ           16000000UL
+#define HOST_BUSES_NUM          4
+#define HOST_BUS_BITS           32
+#define HOST_SUBSCRIBERS        8
+#define HOST_MODER_OUTPUT       1
+#define HOST_PUPDR_PULL_UP      1
+#define HOST_EXTI_LINES         16
+#define HOST_EXTICR_LINES       4       // Lines per EXTICR register
+#define HOST_EXTICR_FIELD_MASK  0x0F
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+/* Ports A..H, SYSCFG and EXTI, laid out by GPIO_Reg.h */
+u32 GPIO_HostRegs[GPIO_HOST_REGS_SIZE/4] __attribute__((aligned(HOST_TRAP_PAGE_SIZE)));
+u32 Host_GpioStores;
+
+static Host_StoreHook_t Host_StoreHook;
+static u16 Host_DrivenMask[HOST_PORTS_NUM];
+static u16 Host_DrivenLevels[HOST_PORTS_NUM];
+static u32 Host_HCLKHz=HOST_RESET_HZ;
+static u32 Host_PCLK1Hz=HOST_RESET_HZ;
+static u32 Host_PCLK2Hz=HOST_RESET_HZ;
+static u8 Host_ClockRefs[HOST_BUSES_NUM][HOST_BUS_BITS];
+static RCC_ClockCb_t Host_Subscribers[HOST_SUBSCRIBERS];
+static u8 Host_SubscribersNum;
+
+extern void EXTI0_IRQHandler(void);
+extern void EXTI1_IRQHandler(void);
+extern void EXTI2_IRQHandler(void);
+extern void EXTI3_IRQHandler(void);
+extern void EXTI4_IRQHandler(void);
+extern void EXTI9_5_IRQHandler(void);
+extern void EXTI15_10_IRQHandler(void);
+static void (* const Host_EXTIHandlers[HOST_EXTI_LINES])(void)=
+{
+    EXTI0_IRQHandler,EXTI1_IRQHandler,EXTI2_IRQHandler,EXTI3_IRQHandler,EXTI4_IRQHandler,
+    EXTI9_5_IRQHandler,EXTI9_5_IRQHandler,EXTI9_5_IRQHandler,EXTI9_5_IRQHandler,EXTI9_5_IRQHandler,
+    EXTI15_10_IRQHandler,EXTI15_10_IRQHandler,EXTI15_10_IRQHandler,EXTI15_10_IRQHandler,EXTI15_10_IRQHandler,EXTI15_10_IRQHandler
+};
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static u8 Host_PortIndex(void* Copy_Port)
+{
+    return (u8)(((u32)Copy_Port-GPIOA_BASE_ADD)/HOST_PORT_STEP);
+}
+
+/* Pins whose 2 bit field of REG holds VALUE */
+static u16 Host_PinsWithField(u32 Copy_Reg, u32 Copy_Value)
+{
+    u16 Local_Mask=0;
+    u8 Local_Pin;
+    for(Local_Pin=0;Local_Pin<16;Local_Pin++)
+    {
+        if(((Copy_Reg>>(Local_Pin*2))&GPIO_CLEAR_MASK)==Copy_Value)
+        {
+            Local_Mask|=(u16)(1U<<Local_Pin);
+        }
+    }
+    return Local_Mask;
+}
+
+/* Outputs read back their ODR level, inputs the level driven by the test or their pull-up */
+static void Host_UpdateIDR(void* Copy_Port)
+{
+    GPIO_Reg * Local_pPort=(GPIO_Reg *)Copy_Port;
+    u8 Local_Index=Host_PortIndex(Copy_Port);
+    u16 Local_Outputs=Host_PinsWithField(Local_pPort->MODER,HOST_MODER_OUTPUT);
+    u16 Local_PullUps=Host_PinsWithField(Local_pPort->PUPDR,HOST_PUPDR_PULL_UP);
+    u16 Local_Inputs=(u16)((Host_DrivenLevels[Local_Index]&Host_DrivenMask[Local_Index])|(Local_PullUps&~Host_DrivenMask[Local_Index]));
+    Local_pPort->IDR=(Local_pPort->ODR&Local_Outputs)|(Local_Inputs&~Local_Outputs);
+}
+
+/* Edges of the input pins of a port raise the EXTI lines routed to it, the handler runs at once like an
+   interrupt with nothing masked, PR is write 1 to clear on the chip so it is cleared here after the handler */
+static void Host_RaiseEXTI(void* Copy_Port, u16 Copy_OldIDR)
+{
+    u8 Local_PortIndex=Host_PortIndex(Copy_Port);
+    u16 Local_NewIDR=(u16)((GPIO_Reg *)Copy_Port)->IDR;
+    u16 Local_Rising=(u16)(Local_NewIDR&~Copy_OldIDR);
+    u16 Local_Falling=(u16)(Copy_OldIDR&~Local_NewIDR);
+    u32 Local_Route;
+    u8 Local_Line;
+    for(Local_Line=0;Local_Line<HOST_EXTI_LINES;Local_Line++)
+    {
+        Local_Route=(SYSCFG->EXTICR[Local_Line/HOST_EXTICR_LINES]>>((Local_Line%HOST_EXTICR_LINES)*4))&HOST_EXTICR_FIELD_MASK;
+        if((Local_Route!=Local_PortIndex)||(((EXTI->IMR>>Local_Line)&0x01)==0))
+        {
+            continue;
+        }
+        if((((Local_Rising&EXTI->RTSR)|(Local_Falling&EXTI->FTSR))>>Local_Line)&0x01)
+        {
+            EXTI->PR|=(1UL<<Local_Line);
+            Host_CallDriver(Host_EXTIHandlers[Local_Line]);
+            EXTI->PR&=~(1UL<<Local_Line);
+        }
+    }
+}
+
+/* A BSRR store moves ODR, set wins over reset like on the real port */
+static void Host_PortStore(void* Copy_Port)
+{
+    GPIO_Reg * Local_pPort=(GPIO_Reg *)Copy_Port;
+    u32 Local_Bsrr=Local_pPort->BSRR;
+    Local_pPort->ODR=((Local_pPort->ODR&~(Local_Bsrr>>GPIO_BSRR_RESET_OFFSET))|Local_Bsrr)&GPIO_PIN_MASK;
+    Local_pPort->BSRR=0;
+    Host_GpioStores++;
+    Host_UpdateIDR(Copy_Port);
+    if(Host_StoreHook!=NULL)
+    {
+        Host_StoreHook(Copy_Port);
+    }
+}
+
+/* Any other store to a port (MODER, PUPDR, ODR ...) can change what IDR reads */
+static void Host_PortConfig(void* Copy_Port)
+{
+    u16 Local_OldIDR=(u16)((GPIO_Reg *)Copy_Port)->IDR;
+    Host_UpdateIDR(Copy_Port);
+    Host_RaiseEXTI(Copy_Port,Local_OldIDR);
+}
+
+/* A store to a port runs its logic, SYSCFG and EXTI have none */
+static void Host_OnStore(u32 Copy_Offset)
+{
+    void * Local_pPort=(void *)(GPIOA_BASE_ADD+((Copy_Offset/HOST_PORT_STEP)*HOST_PORT_STEP));
+    if(Copy_Offset<(HOST_PORTS_NUM*HOST_PORT_STEP))
+    {
+        if((Copy_Offset%HOST_PORT_STEP)==offsetof(GPIO_Reg,BSRR))
+        {
+            Host_PortStore(Local_pPort);
+        }
+        else
+        {
+            Host_PortConfig(Local_pPort);
+        }
+    }
+}
+
+/* Before main, so the stores of every driver go through the port logic */
+static void __attribute__((constructor)) Host_TrapPorts(void)
+{
+    Host_TrapRegion(GPIO_HostRegs,sizeof(GPIO_HostRegs),Host_OnStore);
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void Host_Reset(void)
+{
+    Host_Unlock();
+    memset(GPIO_HostRegs,0,sizeof(GPIO_HostRegs));
+    Host_Lock();
+    memset(Host_DrivenMask,0,sizeof(Host_DrivenMask));
+    memset(Host_DrivenLevels,0,sizeof(Host_DrivenLevels));
+    memset(Host_ClockRefs,0,sizeof(Host_ClockRefs));
+    Host_GpioStores=0;
+    Host_StoreHook=NULL;
+    Host_SubscribersNum=0;
+    Host_HCLKHz=HOST_RESET_HZ;
+    Host_PCLK1Hz=HOST_RESET_HZ;
+    Host_PCLK2Hz=HOST_RESET_HZ;
+}
+
+void Host_SetStoreHook(Host_StoreHook_t Copy_Hook)
+{
+    Host_StoreHook=Copy_Hook;
+}
+
+void Host_DriveInputs(void* Copy_Port, u16 Copy_PinMask, u16 Copy_Levels)
+{
+    u8 Local_Index=Host_PortIndex(Copy_Port);
+    Host_DrivenMask[Local_Index]|=Copy_PinMask;
+    Host_DrivenLevels[Local_Index]=(u16)((Host_DrivenLevels[Local_Index]&~Copy_PinMask)|(Copy_Levels&Copy_PinMask));
+    Host_Unlock();
+    Host_PortConfig(Copy_Port);
+    Host_Lock();
+}
+
+void Host_ReleaseInputs(void* Copy_Port, u16 Copy_PinMask)
+{
+    Host_DrivenMask[Host_PortIndex(Copy_Port)]&=(u16)~Copy_PinMask;
+    Host_Unlock();
+    Host_PortConfig(Copy_Port);
+    Host_Lock();
+}
+
+u8 Host_GetOutput(void* Copy_Port, u8 Copy_Pin)
+{
+    return (u8)((((GPIO_Reg *)Copy_Port)->ODR>>Copy_Pin)&0x01);
+}
+
+void Host_SetClockHz(u32 Copy_HCLKHz, u32 Copy_PCLK1Hz, u32 Copy_PCLK2Hz)
+{
+    u8 Local_Index;
+    Host_HCLKHz=Copy_HCLKHz;
+    Host_PCLK1Hz=Copy_PCLK1Hz;
+    Host_PCLK2Hz=Copy_PCLK2Hz;
+    for(Local_Index=0;Local_Index<Host_SubscribersNum;Local_Index++)
+    {
+        Host_Subscribers[Local_Index]();
+    }
+}
+
+u8 Host_GetClockRefs(u8 Copy_u8BusId, u32 Copy_u32Peripheral)
+{
+    return Host_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)];
+}
+
+/*********************************************MRCC seen by the drivers***********************************/
+u32 MRCC_GetHCLKHz(void)
+{
+    return Host_HCLKHz;
+}
+
+u32 MRCC_GetPCLK1Hz(void)
+{
+    return Host_PCLK1Hz;
+}
+
+u32 MRCC_GetPCLK2Hz(void)
+{
+    return Host_PCLK2Hz;
+}
+
+tenu_ErrorStatus MRCC_SubscribeClockChange(RCC_ClockCb_t Copy_Callback)
+{
+    tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+    u8 Local_Index;
+    for(Local_Index=0;(Local_Index<Host_SubscribersNum)&&(Host_Subscribers[Local_Index]!=Copy_Callback);Local_Index++);
+    if(Copy_Callback==NULL)
+    {
+        Local_ErrorStatus=LBTY_ErrorNullPointer;
+    }
+    else if(Local_Index<Host_SubscribersNum)
+    {
+        /* already registered */
+    }
+    else if(Host_SubscribersNum==HOST_SUBSCRIBERS)
+    {
+        Local_ErrorStatus=LBTY_NOK;
+    }
+    else
+    {
+        Host_Subscribers[Host_SubscribersNum++]=Copy_Callback;
+    }
+    return Local_ErrorStatus;
+}
+
+tenu_ErrorStatus MRCC_AcquireClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral)
+{
+    Host_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)]++;
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus MRCC_ReleaseClock(u8 Copy_u8BusId,u32 Copy_u32Peripheral)
+{
+    tenu_ErrorStatus Local_ErrorStatus=LBTY_OK;
+    u8 * Local_pRefs=&Host_ClockRefs[Copy_u8BusId-RCC_AHB1][GET_LOWEST_SET_BIT(Copy_u32Peripheral)];
+    if(*Local_pRefs==0)
+    {
+        Local_ErrorStatus=LBTY_NOK;
+    }
+    else
+    {
+        (*Local_pRefs)--;
+    }
+    return Local_ErrorStatus;
+}
@@ -0,0 +1,53 @@
+/********************************************************************************************************/
+/* File             :       host_mcal.h                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       RAM backed GPIO ports and a controllable MRCC for the host tests.          */
+/*                          The drivers are built unchanged, GPIO_Reg.h maps the ports on GPIO_HostRegs */
+/*                          and host_mcal.c traps every store to them to run the port logic.            */
+/********************************************************************************************************/
+#ifndef TEST_HOST_HOST_MCAL_H_
+#define TEST_HOST_HOST_MCAL_H_
+
+#include "STD_TYPES.h"
+#include "MGPIO/GPIO.h"
+
+/* Called after each BSRR store once ODR and IDR are up to date, e.g. by the HD44780 model */
+typedef void (*Host_StoreHook_t)(void* Copy_Port);
+
+/* Stores to BSRR since the last Host_Reset */
+extern u32 Host_GpioStores;
+
+/**
+ * @brief Clears the ports, the input levels, the store count, the clock references and the subscribers,
+ * HCLK goes back to the 16 MHz of the reset.
+ */
+void Host_Reset(void);
+/**
+ * @brief Registers the function run after every BSRR store, NULL to remove it.
+ */
+void Host_SetStoreHook(Host_StoreHook_t Copy_Hook);
+/**
+ * @brief Drives the input pins of Copy_PinMask to the levels of Copy_Levels, the other pins keep theirs.
+ *
+ * An input pin nobody drives reads its pull-up. IDR is updated at once and the edges run the handler
+ * of the EXTI lines routed to the port, like an interrupt taken right away.
+ */
+void Host_DriveInputs(void* Copy_Port, u16 Copy_PinMask, u16 Copy_Levels);
+/**
+ * @brief Gives the pins back to their pull resistor (or 0 without pull).
+ */
+void Host_ReleaseInputs(void* Copy_Port, u16 Copy_PinMask);
+/**
+ * @brief Output level of a pin, read from ODR.
+ */
+u8 Host_GetOutput(void* Copy_Port, u8 Copy_Pin);
+/**
+ * @brief Changes the HCLK, PCLK1 and PCLK2 given by MRCC and runs the clock change subscribers.
+ */
+void Host_SetClockHz(u32 Copy_HCLKHz, u32 Copy_PCLK1Hz, u32 Copy_PCLK2Hz);
+/**
+ * @brief References held on a peripheral clock through MRCC_AcquireClock.
+ */
+u8 Host_GetClockRefs(u8 Copy_u8BusId, u32 Copy_u32Peripheral);
+
+#endif /* TEST_HOST_HOST_MCAL_H_ */
@@ -0,0 +1,91 @@
+/********************************************************************************************************/
+/* File             :       host_rcc.c                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Oscillators, PLL and clock switch behind the RAM RCC registers,            */
+/*                          host_trap.c runs them after every store of the driver.                      */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "MRCC/RCC.h"
+#include "host_rcc.h"
+#include "host_trap.h"
+#include <stdint.h>
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define HOST_RCC_HSION          (1UL<<0)
+#define HOST_RCC_HSEON          (1UL<<16)
+#define HOST_RCC_PLLON          (1UL<<24)
+#define HOST_RCC_READY_SHIFT    1       // Each ready flag is the bit above its enable bit
+#define HOST_RCC_CR_RESET       0x00000083UL
+#define HOST_RCC_SW_MASK        0x03
+#define HOST_RCC_SWS_OFFSET     2
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+/* RCC and the flash interface, laid out by RCC_Private.h */
+u32 RCC_HostRegs[RCC_HOST_REGS_SIZE/4] __attribute__((aligned(HOST_TRAP_PAGE_SIZE)));
+/* CMSIS core clock, set by MRCC_UpdateClockFrequencies */
+uint32_t SystemCoreClock;
+u32 Host_RccPllStarts;
+
+static u32 Host_RccStalled;
+static u8 Host_RccPllOn;
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+/* The driver sees u32 registers, the chip 32-bit ones */
+static volatile uint32_t * Host_RccReg32(u32 Copy_Offset)
+{
+    return (volatile uint32_t *)((u8 *)RCC_HostRegs+Copy_Offset);
+}
+
+/* The oscillators and the PLL are ready as soon as they are on, the switch is done as soon as it is asked */
+static void Host_OnStore(u32 Copy_Offset)
+{
+    volatile uint32_t * Local_pCR=Host_RccReg32(HOST_RCC_CR);
+    volatile uint32_t * Local_pCFGR=Host_RccReg32(HOST_RCC_CFGR);
+    u32 Local_Enabled=*Local_pCR&(HOST_RCC_HSION|HOST_RCC_HSEON|HOST_RCC_PLLON);
+    u32 Local_Ready=(Local_Enabled<<HOST_RCC_READY_SHIFT)&~Host_RccStalled;
+    (void)Copy_Offset;
+    *Local_pCR=(*Local_pCR&~(HOST_RCC_HSIRDY|HOST_RCC_HSERDY|HOST_RCC_PLLRDY))|Local_Ready;
+    if((Local_Enabled&HOST_RCC_PLLON)&&!Host_RccPllOn)
+    {
+        Host_RccPllStarts++;
+    }
+    Host_RccPllOn=(Local_Enabled&HOST_RCC_PLLON)!=0;
+    *Local_pCFGR=(*Local_pCFGR&~(HOST_RCC_SW_MASK<<HOST_RCC_SWS_OFFSET))|((*Local_pCFGR&HOST_RCC_SW_MASK)<<HOST_RCC_SWS_OFFSET);
+}
+
+/* Before main, so every store of the driver goes through the model */
+static void __attribute__((constructor)) Host_TrapRcc(void)
+{
+    Host_TrapRegion(RCC_HostRegs,sizeof(RCC_HostRegs),Host_OnStore);
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void Host_RccReset(void)
+{
+    Host_Unlock();
+    memset(RCC_HostRegs,0,sizeof(RCC_HostRegs));
+    *Host_RccReg32(HOST_RCC_CR)=HOST_RCC_CR_RESET;
+    Host_Lock();
+    Host_RccStalled=0;
+    Host_RccPllOn=0;
+    Host_RccPllStarts=0;
+}
+
+void Host_RccStall(u32 Copy_Mask)
+{
+    Host_RccStalled=Copy_Mask;
+}
+
+u32 Host_RccReg(u32 Copy_Offset)
+{
+    return *Host_RccReg32(Copy_Offset);
+}
@@ -0,0 +1,44 @@
+/********************************************************************************************************/
+/* File             :       host_rcc.h                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       RAM backed RCC and flash interface for the test of the real MRCC driver.    */
+/*                          RCC_Private.h maps the registers on RCC_HostRegs, the oscillators, the PLL  */
+/*                          and the clock switch answer every store of the driver at once.              */
+/********************************************************************************************************/
+#ifndef TEST_HOST_HOST_RCC_H_
+#define TEST_HOST_HOST_RCC_H_
+
+#include "STD_TYPES.h"
+
+/* Offsets of the registers read by the tests, the flash interface follows RCC_Private.h */
+#define HOST_RCC_CR             0x00
+#define HOST_RCC_PLLCFGR        0x04
+#define HOST_RCC_CFGR           0x08
+#define HOST_RCC_AHB1ENR        0x30
+#define HOST_RCC_AHB2ENR        0x34
+#define HOST_RCC_APB1ENR        0x40
+#define HOST_RCC_APB2ENR        0x44
+#define HOST_FLASH_ACR          0x400
+
+/* Ready flags of RCC_CR */
+#define HOST_RCC_HSIRDY         (1UL<<1)
+#define HOST_RCC_HSERDY         (1UL<<17)
+#define HOST_RCC_PLLRDY         (1UL<<25)
+
+/* PLL starts since the last Host_RccReset */
+extern u32 Host_RccPllStarts;
+
+/**
+ * @brief Puts the registers back to their reset values, HSI on and selected, no wait state.
+ */
+void Host_RccReset(void);
+/**
+ * @brief Ready flags of Copy_Mask never rise, like an oscillator that doesn't start or a PLL that doesn't lock.
+ */
+void Host_RccStall(u32 Copy_Mask);
+/**
+ * @brief 32-bit register of RCC or of the flash interface at Copy_Offset, as the chip reads it.
+ */
+u32 Host_RccReg(u32 Copy_Offset);
+
+#endif /* TEST_HOST_HOST_RCC_H_ */
@@ -0,0 +1,148 @@
+/********************************************************************************************************/
+/* File             :       host_trap.c                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Store interposer of the RAM register blocks: SIGSEGV on the store of a      */
+/*                          driver, the x86-64 trap flag runs that one instruction, SIGTRAP runs the    */
+/*                          model of the block.                                                         */
+/********************************************************************************************************/
+#define _GNU_SOURCE
+#include "STD_TYPES.h"
+#include "host_trap.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "the register interposer single steps the stores with the x86-64 trap flag, build the harness on x86-64 Linux"
+#endif
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define HOST_TRAP_REGIONS       2       // GPIO and RCC
+#define HOST_TRAP_FLAG          0x100   // EFLAGS.TF, one instruction then SIGTRAP
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    u8 * Base;
+    u32 Size;                       // Rounded up to a page
+    Host_TrapCallBack_t OnStore;
+}Host_TrapRegion_tstr;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+static Host_TrapRegion_tstr Host_Regions[HOST_TRAP_REGIONS];
+static u8 Host_RegionsNum;
+static u32 Host_Unlocked;                       // Nesting of the harness sections that write the registers
+static Host_TrapRegion_tstr * volatile Host_StoreRegion;  // Block stored by the faulting instruction
+static u8 * volatile Host_StoreAddress;
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void Host_Protect(int Copy_Protection)
+{
+    u8 idx;
+    for(idx=0;idx<Host_RegionsNum;idx++)
+    {
+        if(mprotect(Host_Regions[idx].Base,Host_Regions[idx].Size,Copy_Protection)!=0)
+        {
+            abort();
+        }
+    }
+}
+
+/* A driver stored to a read-only block, let the instruction run alone with the blocks writable */
+static void Host_OnStore(int Copy_Signal, siginfo_t * Add_pInfo, void * Add_pContext)
+{
+    u8 * Local_pAddress=(u8 *)Add_pInfo->si_addr;
+    u8 idx;
+    (void)Copy_Signal;
+    for(idx=0;(idx<Host_RegionsNum)&&
+        ((Local_pAddress<Host_Regions[idx].Base)||(Local_pAddress>=(Host_Regions[idx].Base+Host_Regions[idx].Size)));idx++);
+    if(idx==Host_RegionsNum)
+    {
+        /* a real fault, crash on it with the default action */
+        signal(SIGSEGV,SIG_DFL);
+        return;
+    }
+    Host_StoreRegion=&Host_Regions[idx];
+    Host_StoreAddress=Local_pAddress;
+    Host_Protect(PROT_READ|PROT_WRITE);
+    ((ucontext_t *)Add_pContext)->uc_mcontext.gregs[REG_EFL]|=HOST_TRAP_FLAG;
+}
+
+/* The store is done, the model runs as if it was part of the peripheral */
+static void Host_OnStep(int Copy_Signal, siginfo_t * Add_pInfo, void * Add_pContext)
+{
+    Host_TrapRegion_tstr * Local_pRegion=Host_StoreRegion;
+    (void)Copy_Signal;
+    (void)Add_pInfo;
+    ((ucontext_t *)Add_pContext)->uc_mcontext.gregs[REG_EFL]&=~HOST_TRAP_FLAG;
+    Host_Unlock();
+    Local_pRegion->OnStore((u32)(Host_StoreAddress-Local_pRegion->Base));
+    Host_Lock();
+}
+
+/********************************************************************************************************/
+/*********************************************APIs Implementation****************************************/
+/********************************************************************************************************/
+void Host_TrapRegion(void* Add_Base, u32 Copy_Size, Host_TrapCallBack_t Copy_OnStore)
+{
+    struct sigaction Local_Action;
+    if((Host_RegionsNum==HOST_TRAP_REGIONS)||((u32)Add_Base%HOST_TRAP_PAGE_SIZE))
+    {
+        abort();
+    }
+    if(Host_RegionsNum==0)
+    {
+        memset(&Local_Action,0,sizeof(Local_Action));
+        /* a handler run by a model may store to a block again */
+        Local_Action.sa_flags=SA_SIGINFO|SA_NODEFER;
+        Local_Action.sa_sigaction=Host_OnStore;
+        sigaction(SIGSEGV,&Local_Action,NULL);
+        Local_Action.sa_sigaction=Host_OnStep;
+        sigaction(SIGTRAP,&Local_Action,NULL);
+    }
+    Host_Regions[Host_RegionsNum].Base=(u8 *)Add_Base;
+    Host_Regions[Host_RegionsNum].Size=(Copy_Size+HOST_TRAP_PAGE_SIZE-1)&~(HOST_TRAP_PAGE_SIZE-1);
+    Host_Regions[Host_RegionsNum].OnStore=Copy_OnStore;
+    Host_RegionsNum++;
+    if(Host_Unlocked==0)
+    {
+        Host_Protect(PROT_READ);
+    }
+}
+
+void Host_Unlock(void)
+{
+    if(Host_Unlocked++==0)
+    {
+        Host_Protect(PROT_READ|PROT_WRITE);
+    }
+}
+
+void Host_Lock(void)
+{
+    if(--Host_Unlocked==0)
+    {
+        Host_Protect(PROT_READ);
+    }
+}
+
+void Host_CallDriver(void (*Copy_Function)(void))
+{
+    u32 Local_Unlocked=Host_Unlocked;
+    Host_Unlocked=1;
+    Host_Lock();
+    Copy_Function();
+    Host_Unlocked=0;
+    Host_Unlock();
+    Host_Unlocked=Local_Unlocked;
+}
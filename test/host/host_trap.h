@@ -0,0 +1,36 @@
+/********************************************************************************************************/
+/* File             :       host_trap.h                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Runs the logic of a peripheral model after every store of a driver to its   */
+/*                          RAM registers. The register blocks are kept read-only, a store faults, is   */
+/*                          single stepped with the blocks writable and the model is called after it.   */
+/********************************************************************************************************/
+#ifndef TEST_HOST_HOST_TRAP_H_
+#define TEST_HOST_HOST_TRAP_H_
+
+#include "STD_TYPES.h"
+
+/* Alignment of a register block */
+#define HOST_TRAP_PAGE_SIZE     4096
+
+/* Called after a store of a driver, with the offset of the register in its block */
+typedef void (*Host_TrapCallBack_t)(u32 Copy_Offset);
+
+/**
+ * @brief Makes a block of registers read-only and calls Copy_OnStore after every store to it.
+ *
+ * The block must start on a page, a block that doesn't end on one makes the rest of its last page
+ * trap too. The model runs with every block writable, like Host_Unlock.
+ */
+void Host_TrapRegion(void* Add_Base, u32 Copy_Size, Host_TrapCallBack_t Copy_OnStore);
+/**
+ * @brief Makes the blocks writable for the harness, the sections nest, Host_Lock ends one.
+ */
+void Host_Unlock(void);
+void Host_Lock(void);
+/**
+ * @brief Runs driver code with the blocks read-only again, e.g. an interrupt handler called by a model.
+ */
+void Host_CallDriver(void (*Copy_Function)(void));
+
+#endif /* TEST_HOST_HOST_TRAP_H_ */
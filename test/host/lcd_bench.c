@@ -0,0 +1,141 @@
+/********************************************************************************************************/
+/* File             :       lcd_bench.c                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Runs CLCD_TASK against the HD44780 model and reports the ticks per frame,  */
+/*                          the GPIO stores per character and the screen the model ends up showing.    */
+/*                          Fails on a wrong screen or on a byte latched while the LCD was busy.       */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "HCLCD/LCD.h"
+#include "MRCC/RCC.h"
+#include "host_mcal.h"
+#include "hd44780.h"
+#include <stdio.h>
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define BENCH_TICK_NS           1000000UL   // CLCD_TASK runs every 1 ms
+#define BENCH_MAX_TICKS         2000
+#define BENCH_LINE_1            "Temp:   23.5 C  "
+#define BENCH_LINE_2            "Hum:    41 %    "
+#define BENCH_DIGIT_LINE_1      "Temp:   23.6 C  "
+
+#if HLCD_MODE == HLCD_MODE_8_BIT
+#define BENCH_MODE_NAME         "8-bit"
+#else
+#define BENCH_MODE_NAME         "4-bit"
+#endif
+#if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+#define BENCH_TIMING_NAME       "busy flag"
+#else
+#define BENCH_TIMING_NAME       "fixed ticks"
+#endif
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern void CLCD_TASK(void);
+extern LCD_cfg_t HLCD[_LCD_NUM];
+static HD44780_tstr Bench_Model;
+static u32 Bench_Ticks;
+static u8 Bench_Failed;
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void Bench_Tick(void)
+{
+    HD44780_AdvanceNs(BENCH_TICK_NS);
+    CLCD_TASK();
+    Bench_Ticks++;
+}
+
+static u8 Bench_ScreenIs(const char * Add_pLine1, const char * Add_pLine2)
+{
+    char Local_Line[HD44780_COLUMNS+1];
+    u8 Local_Match;
+    HD44780_GetLine(&Bench_Model,0,Local_Line);
+    Local_Match=(memcmp(Local_Line,Add_pLine1,HD44780_COLUMNS)==0);
+    HD44780_GetLine(&Bench_Model,1,Local_Line);
+    return Local_Match&&(memcmp(Local_Line,Add_pLine2,HD44780_COLUMNS)==0);
+}
+
+/* Ticks until the queue is empty and the model shows the two lines */
+static void Bench_Frame(const char * Add_pName, const char * Add_pLine1, const char * Add_pLine2)
+{
+    u32 Local_Start=Bench_Ticks;
+    u32 Local_Stores=Host_GpioStores;
+    u32 Local_Chars=Bench_Model.DataWrites;
+    u32 Local_Commands=Bench_Model.Instructions;
+    char Local_Line1[HD44780_COLUMNS+1];
+    char Local_Line2[HD44780_COLUMNS+1];
+    while(((CLCD_GetFreeSlots(LCD_MAIN)!=LCD_BUFFERSIZE)||!Bench_ScreenIs(Add_pLine1,Add_pLine2))&&(Bench_Ticks-Local_Start<BENCH_MAX_TICKS))
+    {
+        Bench_Tick();
+    }
+    Local_Stores=Host_GpioStores-Local_Stores;
+    Local_Chars=Bench_Model.DataWrites-Local_Chars;
+    Local_Commands=Bench_Model.Instructions-Local_Commands;
+    printf("  %-22s %5lu ticks  %4lu chars  %3lu commands  %6.2f GPIO writes/char\n",Add_pName,
+           Bench_Ticks-Local_Start,Local_Chars,Local_Commands,(Local_Chars==0)?0.0:(double)Local_Stores/Local_Chars);
+    if(!Bench_ScreenIs(Add_pLine1,Add_pLine2))
+    {
+        HD44780_GetLine(&Bench_Model,0,Local_Line1);
+        HD44780_GetLine(&Bench_Model,1,Local_Line2);
+        printf("  FAIL: %s shows |%s|%s|\n",Add_pName,Local_Line1,Local_Line2);
+        Bench_Failed=1;
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    char Local_Line[HD44780_COLUMNS+1];
+    u8 Local_Line_Index;
+    CLCD_Stats_tstr Local_Stats;
+
+    Host_Reset();
+    HD44780_Attach(&Bench_Model,&HLCD[LCD_MAIN]);
+    CLCD_InitAsynch();
+    printf("HD44780 %s, %s, %lu Hz HCLK\n",BENCH_MODE_NAME,BENCH_TIMING_NAME,MRCC_GetHCLKHz());
+
+    /* Queued requests, taken while the init sequence runs, the queued API counts the columns from 1 */
+    CLCD_GoToXYAsynch(LCD_MAIN,0,1);
+    CLCD_WriteStringAsynch(LCD_MAIN,BENCH_LINE_1,HD44780_COLUMNS);
+    CLCD_GoToXYAsynch(LCD_MAIN,1,1);
+    CLCD_WriteStringAsynch(LCD_MAIN,BENCH_LINE_2,HD44780_COLUMNS);
+    Bench_Frame("init + queued frame",BENCH_LINE_1,BENCH_LINE_2);
+
+    /* Same screen through the shadow frame, from a cleared display */
+    CLCD_ClearScreenAsynch(LCD_MAIN);
+    CLCD_FrameWriteString(LCD_MAIN,0,0,BENCH_LINE_1,HD44780_COLUMNS);
+    CLCD_FrameWriteString(LCD_MAIN,1,0,BENCH_LINE_2,HD44780_COLUMNS);
+    Bench_Frame("clear + shadow frame",BENCH_LINE_1,BENCH_LINE_2);
+
+    /* One digit changes, only that cell is pushed */
+    CLCD_FrameWriteFormatted(LCD_MAIN,0,8,236,4,1,HLCD_PAD_SPACE);
+    Bench_Frame("one digit update",BENCH_DIGIT_LINE_1,BENCH_LINE_2);
+
+    printf("  busy reads %lu, bytes latched while busy %lu\n",Bench_Model.BusyReads,Bench_Model.Violations);
+    if(CLCD_GetStats(LCD_MAIN,&Local_Stats)==LBTY_OK)
+    {
+        printf("  driver stats: %lu ticks, %lu active, %lu GPIO writes, %lu data, %lu commands, %lu busy polls\n",
+               Local_Stats.Ticks,Local_Stats.ActiveTicks,Local_Stats.GPIOWrites,Local_Stats.DataBytes,Local_Stats.CommandBytes,Local_Stats.BusyPolls);
+    }
+    for(Local_Line_Index=0;Local_Line_Index<HD44780_LINES;Local_Line_Index++)
+    {
+        HD44780_GetLine(&Bench_Model,Local_Line_Index,Local_Line);
+        printf("  |%s|\n",Local_Line);
+    }
+    if(Bench_Model.Violations!=0)
+    {
+        printf("  FAIL: bytes latched while the LCD was busy\n");
+        Bench_Failed=1;
+    }
+    HD44780_DetachAll();
+    return Bench_Failed;
+}
@@ -0,0 +1,298 @@
+/********************************************************************************************************/
+/* File             :       test_input.c                                                                */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Event queue of the INPUT service, the keypad, the switches and the          */
+/*                          scheduler time are stubs of this file that the tests drive directly.        */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "SERVICE/INPUT/INPUT.h"
+#include "SERVICE/SCHED/SCHED.h"
+#include "HKPD/KYD.h"
+#include "HSWITCH/SWITCH.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define INPUTTEST_KEY_NAME(BIT)     ((u8)('A'+(BIT)))   // Name the KPD_GetKeyName stub gives to a key bit
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+static u32 InputTest_TimeMs;
+static u16 InputTest_KpdPress;
+static u16 InputTest_KpdRelease;
+static u32 InputTest_SwPress;
+static u32 InputTest_SwRelease;
+
+/********************************************************************************************************/
+/*********************************************Stubs******************************************************/
+/********************************************************************************************************/
+u32 Sched_GetTimeMs(void)
+{
+    return InputTest_TimeMs;
+}
+
+tenu_ErrorStatus KPD_GetTransitions(u16 *Copy_pu16Pressed, u16 *Copy_pu16Released)
+{
+    *Copy_pu16Pressed=InputTest_KpdPress;
+    *Copy_pu16Released=InputTest_KpdRelease;
+    InputTest_KpdPress=0;
+    InputTest_KpdRelease=0;
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus KPD_GetKeyName(u8 Copy_u8KeyBit, u8 *Copy_pu8Key)
+{
+    *Copy_pu8Key=INPUTTEST_KEY_NAME(Copy_u8KeyBit);
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus HSWITCH_GetEdges(u32 *ADD_PressMask, u32 *ADD_ReleaseMask)
+{
+    *ADD_PressMask=InputTest_SwPress;
+    *ADD_ReleaseMask=InputTest_SwRelease;
+    InputTest_SwPress=0;
+    InputTest_SwRelease=0;
+    return LBTY_OK;
+}
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+/* Edges of the keypad seen by the next run, at the given time */
+static void InputTest_Kpd(u32 Copy_TimeMs, u16 Copy_Press, u16 Copy_Release)
+{
+    InputTest_TimeMs=Copy_TimeMs;
+    InputTest_KpdPress=Copy_Press;
+    InputTest_KpdRelease=Copy_Release;
+    INPUT_Runnable();
+}
+
+static void InputTest_AssertEvent(u8 Copy_Consumer, u8 Copy_Source, u8 Copy_Type, u8 Copy_Index, u32 Copy_TimeMs)
+{
+    InputEvent_tstr Local_Event;
+    assert(INPUT_GetEvent(Copy_Consumer,&Local_Event)==LBTY_OK);
+    assert(Local_Event.Source==Copy_Source);
+    assert(Local_Event.Type==Copy_Type);
+    assert(Local_Event.Index==Copy_Index);
+    assert(Local_Event.TimeMs==Copy_TimeMs);
+    if(Copy_Source==INPUT_SOURCE_KPD)
+    {
+        assert(Local_Event.Key==INPUTTEST_KEY_NAME(Copy_Index));
+    }
+    else
+    {
+        assert(Local_Event.Key==Copy_Index);
+    }
+}
+
+static void InputTest_AssertEmpty(u8 Copy_Consumer)
+{
+    InputEvent_tstr Local_Event;
+    assert(INPUT_GetEvent(Copy_Consumer,&Local_Event)==LBTY_NOK);
+}
+
+static u32 InputTest_Lost(u8 Copy_Consumer)
+{
+    u32 Local_Lost=0xFFFFFFFFUL;
+    assert(INPUT_GetLostEvents(Copy_Consumer,&Local_Lost)==LBTY_OK);
+    return Local_Lost;
+}
+
+/* Every consumer starts at the head with nothing lost, whatever the earlier tests left in the queue */
+static void InputTest_Init(void)
+{
+    u8 Local_Consumer;
+    InputTest_TimeMs=0;
+    INPUT_Init();
+    for(Local_Consumer=0;Local_Consumer<_INPUT_CONSUMER_NUM;Local_Consumer++)
+    {
+        InputTest_AssertEmpty(Local_Consumer);
+        assert(InputTest_Lost(Local_Consumer)==0);
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* Each consumer reads every event once through its own cursor */
+static void Test_Cursors(void)
+{
+    InputTest_Init();
+    InputTest_Kpd(10,1U<<3,0);
+    InputTest_Kpd(20,0,1U<<3);
+    InputTest_TimeMs=30;
+    InputTest_SwPress=1UL<<SWITCH_02;
+    INPUT_Runnable();
+
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,3,10);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,3,20);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_SWITCH,INPUT_EVENT_PRESS,SWITCH_02,30);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+
+    /* The others still have all of them */
+    InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,3,10);
+    InputTest_AssertEvent(INPUT_CONSUMER_SENDER,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,3,10);
+    InputTest_AssertEvent(INPUT_CONSUMER_SENDER,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,3,20);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,3,20);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_SWITCH,INPUT_EVENT_PRESS,SWITCH_02,30);
+    InputTest_AssertEvent(INPUT_CONSUMER_SENDER,INPUT_SOURCE_SWITCH,INPUT_EVENT_PRESS,SWITCH_02,30);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP2);
+    InputTest_AssertEmpty(INPUT_CONSUMER_SENDER);
+}
+
+/* A consumer more than INPUT_QUEUE_SIZE-1 events behind skips to the oldest valid event and counts the rest */
+static void Test_LostEvents(void)
+{
+    u32 Local_Run;
+    u32 Local_Runs=INPUT_QUEUE_SIZE;    // 2 events per run
+    InputTest_Init();
+    for(Local_Run=0;Local_Run<Local_Runs;Local_Run++)
+    {
+        InputTest_Kpd(Local_Run,1U<<(Local_Run%16),1U<<(Local_Run%16));
+        /* APP1 keeps up */
+        InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,Local_Run%16,Local_Run);
+        InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,Local_Run%16,Local_Run);
+    }
+    assert(InputTest_Lost(INPUT_CONSUMER_APP1)==0);
+
+    /* APP2 is 2*INPUT_QUEUE_SIZE behind, the first valid event is the release of run INPUT_QUEUE_SIZE/2 */
+    InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,(Local_Runs/2)%16,Local_Runs/2);
+    assert(InputTest_Lost(INPUT_CONSUMER_APP2)==2*Local_Runs-(INPUT_QUEUE_SIZE-1));
+    assert(InputTest_Lost(INPUT_CONSUMER_APP2)==0);
+    for(Local_Run=Local_Runs/2+1;Local_Run<Local_Runs;Local_Run++)
+    {
+        InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,Local_Run%16,Local_Run);
+        InputTest_AssertEvent(INPUT_CONSUMER_APP2,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,Local_Run%16,Local_Run);
+    }
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP2);
+    assert(InputTest_Lost(INPUT_CONSUMER_APP2)==0);
+
+    /* Exactly INPUT_QUEUE_SIZE-1 behind loses nothing */
+    InputTest_Init();
+    for(Local_Run=0;Local_Run<INPUT_QUEUE_SIZE-1;Local_Run++)
+    {
+        InputTest_Kpd(200+Local_Run,(Local_Run&1)?0:(1U<<6),(Local_Run&1)?(1U<<6):0);
+    }
+    for(Local_Run=0;Local_Run<INPUT_QUEUE_SIZE-1;Local_Run++)
+    {
+        InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,(Local_Run&1)?INPUT_EVENT_RELEASE:INPUT_EVENT_PRESS,6,200+Local_Run);
+    }
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    assert(InputTest_Lost(INPUT_CONSUMER_APP1)==0);
+}
+
+/* Both edges of a key in one run: press then release for a tap, release then press for a key already held */
+static void Test_Taps(void)
+{
+    InputTest_Init();
+    InputTest_Kpd(10,1U<<2,1U<<2);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,2,10);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,2,10);
+
+    InputTest_Kpd(20,1U<<2,0);
+    InputTest_Kpd(30,1U<<2,1U<<2);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,2,20);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,2,30);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,2,30);
+    InputTest_Kpd(40,0,1U<<2);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,2,40);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+}
+
+/* A held key gives one long press after INPUT_LONG_PRESS_MS then a repeat every INPUT_REPEAT_MS */
+static void Test_LongPressRepeat(void)
+{
+    u32 Local_TimeMs;
+    u8 Local_Repeats=0;
+    InputTest_Init();
+    InputTest_Kpd(1000,1U<<9,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,9,1000);
+    InputTest_Kpd(1000+INPUT_LONG_PRESS_MS-1,0,0);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    InputTest_Kpd(1000+INPUT_LONG_PRESS_MS,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_LONG_PRESS,9,1000+INPUT_LONG_PRESS_MS);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+
+    /* Runs every 10 ms for 3 repeat periods */
+    for(Local_TimeMs=1000+INPUT_LONG_PRESS_MS+10;Local_TimeMs<=1000+INPUT_LONG_PRESS_MS+3*INPUT_REPEAT_MS;Local_TimeMs+=10)
+    {
+        InputTest_Kpd(Local_TimeMs,0,0);
+        if(((Local_TimeMs-1000-INPUT_LONG_PRESS_MS)%INPUT_REPEAT_MS)==0)
+        {
+            InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_REPEAT,9,Local_TimeMs);
+            Local_Repeats++;
+        }
+        InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    }
+    assert(Local_Repeats==3);
+
+    /* A late run gives one repeat, the next one stays on the period */
+    Local_TimeMs=1000+INPUT_LONG_PRESS_MS+4*INPUT_REPEAT_MS+INPUT_REPEAT_MS/2;
+    InputTest_Kpd(Local_TimeMs,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_REPEAT,9,Local_TimeMs);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    Local_TimeMs=1000+INPUT_LONG_PRESS_MS+5*INPUT_REPEAT_MS;
+    InputTest_Kpd(Local_TimeMs-1,0,0);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    InputTest_Kpd(Local_TimeMs,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_REPEAT,9,Local_TimeMs);
+
+    /* Released then pressed again, the long press timing restarts */
+    InputTest_Kpd(5000,0,1U<<9);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,9,5000);
+    InputTest_Kpd(5000+INPUT_LONG_PRESS_MS,0,0);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    InputTest_Kpd(6000,1U<<9,0);
+    InputTest_Kpd(6000+INPUT_LONG_PRESS_MS-1,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,9,6000);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+    InputTest_Kpd(6000+INPUT_LONG_PRESS_MS,0,1U<<9);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,9,6000+INPUT_LONG_PRESS_MS);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+}
+
+/* The switches are timed in their own slots, after the keypad keys */
+static void Test_SwitchLongPress(void)
+{
+    InputTest_Init();
+    InputTest_TimeMs=0;
+    InputTest_SwPress=1UL<<SWITCH_01;
+    InputTest_KpdPress=1U<<0;
+    INPUT_Runnable();
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_PRESS,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_SWITCH,INPUT_EVENT_PRESS,SWITCH_01,0);
+    InputTest_Kpd(100,0,1U<<0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_KPD,INPUT_EVENT_RELEASE,0,100);
+    InputTest_Kpd(INPUT_LONG_PRESS_MS,0,0);
+    InputTest_AssertEvent(INPUT_CONSUMER_APP1,INPUT_SOURCE_SWITCH,INPUT_EVENT_LONG_PRESS,SWITCH_01,INPUT_LONG_PRESS_MS);
+    InputTest_AssertEmpty(INPUT_CONSUMER_APP1);
+}
+
+static void Test_InvalidArguments(void)
+{
+    InputEvent_tstr Local_Event;
+    u32 Local_Lost;
+    InputTest_Init();
+    assert(INPUT_GetEvent(_INPUT_CONSUMER_NUM,&Local_Event)==LBTY_ErrorInvalidInput);
+    assert(INPUT_GetEvent(INPUT_CONSUMER_APP1,NULL)==LBTY_ErrorNullPointer);
+    assert(INPUT_GetLostEvents(_INPUT_CONSUMER_NUM,&Local_Lost)==LBTY_ErrorInvalidInput);
+    assert(INPUT_GetLostEvents(INPUT_CONSUMER_APP1,NULL)==LBTY_ErrorNullPointer);
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_Cursors();
+    Test_LostEvents();
+    Test_Taps();
+    Test_LongPressRepeat();
+    Test_SwitchLongPress();
+    Test_InvalidArguments();
+    printf("test_input: OK\n");
+    return 0;
+}
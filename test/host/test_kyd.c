@@ -0,0 +1,214 @@
+/********************************************************************************************************/
+/* File             :       test_kyd.c                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Keypad scan and debouncer of HKPD against a key matrix model, built in both */
+/*                          KPD_INPUT_MODE variants of the Makefile.                                    */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "HKPD/KYD.h"
+#include "MGPIO/GPIO.h"
+#include "host_mcal.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define KPDTEST_SAMPLES         4       // Scans at the new level before a key toggles
+#define KPDTEST_KEY(COL,ROW)    (1U<<(((COL)*KPD_NUMBER_OF_ROWS)+(ROW)))
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern void KPD_Runnable(void);
+extern tstr_KPDPinConfiguration KPD_Conf;
+static u16 KpdTest_Held;    // Keys closed on the matrix, same bits as KPD_GetPressedKeys
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+/* A closed key pulls its row low while its column is driven low, the other rows read their pull-up */
+static void KpdTest_UpdateRows(void)
+{
+    u8 Local_Col;
+    u8 Local_Row;
+    u8 Local_Low;
+    for(Local_Row=0;Local_Row<KPD_NUMBER_OF_ROWS;Local_Row++)
+    {
+        Local_Low=0;
+        for(Local_Col=0;Local_Col<KPD_NUMBER_OF_COLUMNS;Local_Col++)
+        {
+            if((KpdTest_Held&KPDTEST_KEY(Local_Col,Local_Row))&&
+               (Host_GetOutput(KPD_Conf.ColPortNumber[Local_Col],KPD_Conf.ColPinNumber[Local_Col])==GPIO_Low))
+            {
+                Local_Low=1;
+            }
+        }
+        if(Local_Low)
+        {
+            Host_DriveInputs(KPD_Conf.RowPortNumber[Local_Row],(u16)(1U<<KPD_Conf.RowPinNumber[Local_Row]),0);
+        }
+        else
+        {
+            Host_ReleaseInputs(KPD_Conf.RowPortNumber[Local_Row],(u16)(1U<<KPD_Conf.RowPinNumber[Local_Row]));
+        }
+    }
+}
+
+static void KpdTest_OnStore(void* Copy_Port)
+{
+    (void)Copy_Port;
+    KpdTest_UpdateRows();
+}
+
+static void KpdTest_Hold(u16 Copy_Keys)
+{
+    KpdTest_Held=Copy_Keys;
+    KpdTest_UpdateRows();
+}
+
+static void KpdTest_Run(u8 Copy_Scans)
+{
+    while(Copy_Scans--)
+    {
+        KPD_Runnable();
+    }
+}
+
+static void KpdTest_AssertTransitions(u16 Copy_Pressed, u16 Copy_Released)
+{
+    u16 Local_Pressed;
+    u16 Local_Released;
+    assert(KPD_GetTransitions(&Local_Pressed,&Local_Released)==LBTY_OK);
+    assert(Local_Pressed==Copy_Pressed);
+    assert(Local_Released==Copy_Released);
+}
+
+static u16 KpdTest_Pressed(void)
+{
+    u16 Local_Keys;
+    assert(KPD_GetPressedKeys(&Local_Keys)==LBTY_OK);
+    return Local_Keys;
+}
+
+static void KpdTest_Init(void)
+{
+    Host_Reset();
+    KpdTest_Held=0;
+    Host_SetStoreHook(KpdTest_OnStore);
+    assert(KPD_INIT()==LBTY_OK);
+    KpdTest_Run(2*KPDTEST_SAMPLES);
+    KpdTest_AssertTransitions(0,0);
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* Every key is debounced on its own, keys held together are all reported */
+static void Test_Rollover(void)
+{
+    u16 Local_Keys=KPDTEST_KEY(0,0)|KPDTEST_KEY(2,3)|KPDTEST_KEY(3,1);
+    KpdTest_Init();
+    KpdTest_Hold(Local_Keys);
+    KpdTest_Run(KPDTEST_SAMPLES-1);
+    assert(KpdTest_Pressed()==0);
+    KpdTest_Run(1);
+    assert(KpdTest_Pressed()==Local_Keys);
+    KpdTest_AssertTransitions(Local_Keys,0);
+    KpdTest_AssertTransitions(0,0);
+
+    /* One of them is released, the others stay down */
+    KpdTest_Hold(Local_Keys&~KPDTEST_KEY(2,3));
+    KpdTest_Run(KPDTEST_SAMPLES);
+    assert(KpdTest_Pressed()==(Local_Keys&~KPDTEST_KEY(2,3)));
+    KpdTest_AssertTransitions(0,KPDTEST_KEY(2,3));
+
+    KpdTest_Hold(0);
+    KpdTest_Run(KPDTEST_SAMPLES);
+    assert(KpdTest_Pressed()==0);
+    KpdTest_AssertTransitions(0,KPDTEST_KEY(0,0)|KPDTEST_KEY(3,1));
+}
+
+/* A bounce restarts the count of the key, short glitches are never reported */
+static void Test_Bounce(void)
+{
+    KpdTest_Init();
+    KpdTest_Hold(KPDTEST_KEY(1,2));
+    KpdTest_Run(KPDTEST_SAMPLES-1);
+    KpdTest_Hold(0);
+    KpdTest_Run(1);
+    KpdTest_Hold(KPDTEST_KEY(1,2));
+    KpdTest_Run(KPDTEST_SAMPLES-1);
+    assert(KpdTest_Pressed()==0);
+    KpdTest_Run(1);
+    assert(KpdTest_Pressed()==KPDTEST_KEY(1,2));
+    KpdTest_AssertTransitions(KPDTEST_KEY(1,2),0);
+
+    KpdTest_Hold(0);
+    KpdTest_Run(KPDTEST_SAMPLES-1);
+    KpdTest_Hold(KPDTEST_KEY(1,2));
+    KpdTest_Run(3*KPDTEST_SAMPLES);
+    KpdTest_AssertTransitions(0,0);
+}
+
+/* KPD_GetPressedKey gives the first key in scan order once per change */
+static void Test_PressedKeyName(void)
+{
+    u8 Local_Key;
+    u8 Local_Name;
+    KpdTest_Init();
+    assert(KPD_GetPressedKey(&Local_Key)==LBTY_OK);
+    assert(Local_Key==0);
+    KpdTest_Hold(KPDTEST_KEY(1,3)|KPDTEST_KEY(3,0));
+    KpdTest_Run(KPDTEST_SAMPLES);
+    assert(KPD_GetKeyName(1*KPD_NUMBER_OF_ROWS+3,&Local_Name)==LBTY_OK);
+    assert(KPD_GetPressedKey(&Local_Key)==LBTY_OK);
+    assert(Local_Key==Local_Name);
+    assert(KPD_GetPressedKey(&Local_Key)==LBTY_OK);
+    assert(Local_Key==0);
+
+    assert(KPD_GetKeyName(KPD_NUMBER_OF_ROWS*KPD_NUMBER_OF_COLUMNS,&Local_Name)==LBTY_ErrorInvalidInput);
+    assert(KPD_GetKeyName(0,NULL)==LBTY_ErrorNullPointer);
+    assert(KPD_GetPressedKey(NULL)==LBTY_ErrorNullPointer);
+    assert(KPD_GetPressedKeys(NULL)==LBTY_ErrorNullPointer);
+    assert(KPD_GetTransitions(NULL,NULL)==LBTY_ErrorNullPointer);
+}
+
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+/* Idle, the runnable doesn't touch the columns, a row edge wakes the scan until every key is released */
+static void Test_EXTISleep(void)
+{
+    u32 Local_Stores;
+    KpdTest_Init();
+    Local_Stores=Host_GpioStores;
+    KpdTest_Run(3*KPDTEST_SAMPLES);
+    assert(Host_GpioStores==Local_Stores);
+
+    KpdTest_Hold(KPDTEST_KEY(2,1));
+    KpdTest_Run(KPDTEST_SAMPLES);
+    assert(Host_GpioStores!=Local_Stores);
+    KpdTest_AssertTransitions(KPDTEST_KEY(2,1),0);
+    KpdTest_Hold(0);
+    KpdTest_Run(KPDTEST_SAMPLES);
+    KpdTest_AssertTransitions(0,KPDTEST_KEY(2,1));
+
+    Local_Stores=Host_GpioStores;
+    KpdTest_Run(3*KPDTEST_SAMPLES);
+    assert(Host_GpioStores==Local_Stores);
+}
+#endif
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_Rollover();
+    Test_Bounce();
+    Test_PressedKeyName();
+#if KPD_INPUT_MODE==KPD_MODE_EXTI
+    Test_EXTISleep();
+#endif
+    printf("test_kyd: OK\n");
+    return 0;
+}
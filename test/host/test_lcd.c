@@ -0,0 +1,307 @@
+/********************************************************************************************************/
+/* File             :       test_lcd.c                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       CLCD tests, checked on the screen and the bus traffic of the HD44780 model. */
+/*                          Built once per LCD variant of the Makefile.                                 */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "HCLCD/LCD.h"
+#include "host_mcal.h"
+#include "hd44780.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define LCDTEST_TICK_NS         1000000UL   // CLCD_TASK runs every 1 ms
+#define LCDTEST_INIT_TICKS      40          // Power on wait and init sequence of every mode
+#define LCDTEST_IDLE_TICKS      4           // Ticks without bus traffic before the driver is taken as idle
+#define LCDTEST_MAX_TICKS       2000
+#define LCDTEST_BLANK_LINE      "                "
+
+/********************************************************************************************************/
+/************************************************Types***************************************************/
+/********************************************************************************************************/
+typedef struct
+{
+    s32 Number;
+    u8 Width;
+    u8 Decimals;
+    u8 Pad;
+    const char * Text;
+}LcdTest_Format_tstr;
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern void CLCD_TASK(void);
+extern LCD_cfg_t HLCD[_LCD_NUM];
+static HD44780_tstr LcdTest_Model;
+static const LcdTest_Format_tstr LcdTest_Formats[]=
+{
+    {INT32_MIN,  0, 0, HLCD_PAD_SPACE, "-2147483648"},
+    {INT32_MAX,  0, 0, HLCD_PAD_SPACE, "2147483647"},
+    {0,          0, 0, HLCD_PAD_SPACE, "0"},
+    {1234,       0, 2, HLCD_PAD_SPACE, "12.34"},
+    {5,          0, 3, HLCD_PAD_SPACE, "0.005"},
+    {-5,         0, 2, HLCD_PAD_SPACE, "-0.05"},
+    {INT32_MIN,  0, 9, HLCD_PAD_SPACE, "-2.147483648"},
+    {42,         6, 0, HLCD_PAD_SPACE, "    42"},
+    {42,         6, 0, HLCD_PAD_ZERO,  "000042"},
+    {-42,        6, 0, HLCD_PAD_SPACE, "   -42"},
+    {-42,        6, 0, HLCD_PAD_ZERO,  "-00042"},
+    {-123,       7, 2, HLCD_PAD_SPACE, "  -1.23"},
+    {-123,       7, 2, HLCD_PAD_ZERO,  "-001.23"},
+    {123456,     3, 0, HLCD_PAD_ZERO,  "123456"},
+    {INT32_MIN, 16, 0, HLCD_PAD_SPACE, "     -2147483648"},
+};
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void LcdTest_Tick(void)
+{
+    HD44780_AdvanceNs(LCDTEST_TICK_NS);
+    CLCD_TASK();
+}
+
+/* Runs CLCD_TASK until the queue is empty and the bus stays quiet, returns the ticks it took */
+static u32 LcdTest_Settle(void)
+{
+    u32 Local_Ticks=0;
+    u32 Local_Quiet=0;
+    u32 Local_Stores;
+    while((Local_Quiet<LCDTEST_IDLE_TICKS)&&(Local_Ticks<LCDTEST_MAX_TICKS))
+    {
+        Local_Stores=Host_GpioStores;
+        LcdTest_Tick();
+        Local_Ticks++;
+        Local_Quiet=((Host_GpioStores==Local_Stores)&&(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE))?(Local_Quiet+1):0;
+    }
+    assert(Local_Ticks<LCDTEST_MAX_TICKS);
+    return Local_Ticks-LCDTEST_IDLE_TICKS;
+}
+
+static void LcdTest_Init(void)
+{
+    u8 Local_Tick;
+    HD44780_DetachAll();
+    Host_Reset();
+    HD44780_Attach(&LcdTest_Model,&HLCD[LCD_MAIN]);
+    CLCD_InitAsynch();
+    for(Local_Tick=0;Local_Tick<LCDTEST_INIT_TICKS;Local_Tick++)
+    {
+        LcdTest_Tick();
+    }
+    assert(LcdTest_Model.DisplayOn&&LcdTest_Model.TwoLines&&(LcdTest_Model.EightBit==(HLCD_MODE==HLCD_MODE_8_BIT)));
+}
+
+static void LcdTest_AssertLine(u8 Copy_Line, const char * Add_pExpected)
+{
+    char Local_Line[HD44780_COLUMNS+1];
+    HD44780_GetLine(&LcdTest_Model,Copy_Line,Local_Line);
+    if(memcmp(Local_Line,Add_pExpected,HD44780_COLUMNS)!=0)
+    {
+        printf("line %u: |%s| expected |%.16s|\n",Copy_Line,Local_Line,Add_pExpected);
+        assert(0);
+    }
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* A screen where one digit changed costs one character and at most one address command */
+static void Test_FrameDirtyCells(void)
+{
+    u32 Local_Chars;
+    u32 Local_Commands;
+    u32 Local_Stores;
+    LcdTest_Init();
+    assert(CLCD_FrameWriteString(LCD_MAIN,0,0,"Speed  120 km/h ",16)==LBTY_OK);
+    assert(CLCD_FrameWriteString(LCD_MAIN,1,0,"Trip   42.7 km  ",16)==LBTY_OK);
+    LcdTest_Settle();
+    LcdTest_AssertLine(0,"Speed  120 km/h ");
+    LcdTest_AssertLine(1,"Trip   42.7 km  ");
+
+    /* One digit */
+    Local_Chars=LcdTest_Model.DataWrites;
+    Local_Commands=LcdTest_Model.Instructions;
+    assert(CLCD_FrameWriteString(LCD_MAIN,0,7,"121",3)==LBTY_OK);
+    LcdTest_Settle();
+    assert(LcdTest_Model.DataWrites-Local_Chars==1);
+    assert(LcdTest_Model.Instructions-Local_Commands<=1);
+    LcdTest_AssertLine(0,"Speed  121 km/h ");
+
+    /* Same characters again, nothing goes on the bus */
+    Local_Stores=Host_GpioStores;
+    assert(CLCD_FrameWriteString(LCD_MAIN,1,0,"Trip   42.7 km  ",16)==LBTY_OK);
+    LcdTest_Settle();
+    assert(Host_GpioStores==Local_Stores);
+
+    /* Consecutive dirty cells share one address command, a clean cell between them costs another one */
+    Local_Chars=LcdTest_Model.DataWrites;
+    Local_Commands=LcdTest_Model.Instructions;
+    assert(CLCD_FrameWriteString(LCD_MAIN,1,7,"38.1",4)==LBTY_OK);
+    LcdTest_Settle();
+    assert(LcdTest_Model.DataWrites-Local_Chars==3);
+    assert(LcdTest_Model.Instructions-Local_Commands==2);
+    LcdTest_AssertLine(1,"Trip   38.1 km  ");
+
+    /* Clearing the frame only pushes the non blank cells */
+    Local_Chars=LcdTest_Model.DataWrites;
+    CLCD_FrameClear(LCD_MAIN);
+    LcdTest_Settle();
+    assert(LcdTest_Model.DataWrites-Local_Chars==22);
+    LcdTest_AssertLine(0,LCDTEST_BLANK_LINE);
+    LcdTest_AssertLine(1,LCDTEST_BLANK_LINE);
+
+    assert(CLCD_FrameWriteString(LCD_MAIN,2,0,"x",1)==LBTY_ErrorInvalidInput);
+    assert(CLCD_FrameWriteString(LCD_MAIN,0,16,"x",1)==LBTY_ErrorInvalidInput);
+    assert(CLCD_FrameWriteString(LCD_MAIN,0,0,NULL,1)==LBTY_ErrorNullPointer);
+    assert(LcdTest_Model.Violations==0);
+}
+
+/* Consecutive writes share one slot up to LCD_BURST_SIZE, a full ring refuses requests until it drains */
+static void Test_RingCoalescing(void)
+{
+    const char * Local_pText="0123456789ABCDEF";
+    u8 Local_Index;
+    u8 Local_Queued=0;
+    LcdTest_Init();
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+    for(Local_Index=0;Local_Index<16;Local_Index+=2)
+    {
+        assert(CLCD_WriteStringAsynch(LCD_MAIN,(char *)&Local_pText[Local_Index],2)==LBTY_OK);
+    }
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE-2);
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,1,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"xy",2)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"z",1)==LBTY_OK);
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE-4);
+    LcdTest_Settle();
+    LcdTest_AssertLine(0,"0123456789ABCDEF");
+    LcdTest_AssertLine(1,"xyz             ");
+
+    /* A write longer than the burst room of the last slot takes a slot of its own */
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,1,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"0123456789",10)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"abcdef",6)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"!",1)==LBTY_OK);
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE-3);
+    LcdTest_Settle();
+    LcdTest_AssertLine(1,"0123456789abcdef");
+
+    /* Back-pressure, then the ring wraps around */
+    while(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK)
+    {
+        Local_Queued++;
+    }
+    assert(Local_Queued==LCD_BUFFERSIZE);
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==0);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"lost",4)==LBTY_Busy);
+    LcdTest_Settle();
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE);
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"wrapped",7)==LBTY_OK);
+    LcdTest_Settle();
+    LcdTest_AssertLine(0,"wrapped789ABCDEF");
+    assert(LcdTest_Model.Violations==0);
+}
+
+#if HLCD_TIMING == HLCD_TIMING_FIXED_TICKS
+/* Both nibbles of a 4-bit byte go out in the same phase, a byte costs two ticks in either mode:
+   1+2+1 ticks for the position and 1+16*2+1 for the characters, the last slot is freed in a quiet tick */
+static void Test_TicksPerByte(void)
+{
+    LcdTest_Init();
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"two ticks a byte",16)==LBTY_OK);
+    assert(LcdTest_Settle()==38);
+    LcdTest_AssertLine(0,"two ticks a byte");
+    assert(LcdTest_Model.Violations==0);
+}
+#endif
+
+#if HLCD_TIMING == HLCD_TIMING_BUSY_FLAG
+/* The clear keeps the controller busy for 1.52 ms, the driver polls instead of latching over it,
+   and once ready a byte goes out every tick instead of every other tick */
+static void Test_BusyFlagPacing(void)
+{
+    u32 Local_Ticks;
+    u32 Local_Bytes;
+    u32 Local_BusyReads;
+    LcdTest_Init();
+    Local_BusyReads=LcdTest_Model.BusyReads;
+    Local_Bytes=LcdTest_Model.DataWrites+LcdTest_Model.Instructions;
+    assert(CLCD_ClearScreenAsynch(LCD_MAIN)==LBTY_OK);
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"Busy flag timing",16)==LBTY_OK);
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,1,1)==LBTY_OK);
+    assert(CLCD_WriteStringAsynch(LCD_MAIN,"no fixed delays ",16)==LBTY_OK);
+    Local_Ticks=LcdTest_Settle();
+    Local_Bytes=LcdTest_Model.DataWrites+LcdTest_Model.Instructions-Local_Bytes;
+    LcdTest_AssertLine(0,"Busy flag timing");
+    LcdTest_AssertLine(1,"no fixed delays ");
+    assert(Local_Bytes==35);
+    assert(LcdTest_Model.BusyReads>Local_BusyReads);
+    assert(Local_Ticks<2*Local_Bytes);
+    assert(LcdTest_Model.Violations==0);
+}
+#endif
+
+/* Every row of LcdTest_Formats through the queue and through the shadow frame */
+static void Test_FormatNumber(void)
+{
+    char Local_Expected[HD44780_COLUMNS+1];
+    u8 Local_Index;
+    LcdTest_Init();
+    for(Local_Index=0;Local_Index<sizeof(LcdTest_Formats)/sizeof(LcdTest_Formats[0]);Local_Index++)
+    {
+        const LcdTest_Format_tstr * Local_pFormat=&LcdTest_Formats[Local_Index];
+        snprintf(Local_Expected,sizeof(Local_Expected),"%-16s",Local_pFormat->Text);
+        assert(CLCD_ClearScreenAsynch(LCD_MAIN)==LBTY_OK);
+        assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+        assert(CLCD_WriteFormattedAsynch(LCD_MAIN,Local_pFormat->Number,Local_pFormat->Width,Local_pFormat->Decimals,Local_pFormat->Pad)==LBTY_OK);
+        CLCD_FrameClear(LCD_MAIN);
+        assert(CLCD_FrameWriteFormatted(LCD_MAIN,1,0,Local_pFormat->Number,Local_pFormat->Width,Local_pFormat->Decimals,Local_pFormat->Pad)==LBTY_OK);
+        LcdTest_Settle();
+        LcdTest_AssertLine(0,Local_Expected);
+        LcdTest_AssertLine(1,Local_Expected);
+    }
+
+    assert(CLCD_ClearScreenAsynch(LCD_MAIN)==LBTY_OK);
+    assert(CLCD_GoToXYAsynch(LCD_MAIN,0,1)==LBTY_OK);
+    assert(CLCD_WriteNumberAsynch(LCD_MAIN,-7)==LBTY_OK);
+    CLCD_FrameClear(LCD_MAIN);
+    LcdTest_Settle();
+    LcdTest_AssertLine(0,"-7              ");
+
+    assert(CLCD_WriteFormattedAsynch(LCD_MAIN,1,0,10,HLCD_PAD_SPACE)==LBTY_ErrorInvalidInput);
+    assert(CLCD_WriteFormattedAsynch(LCD_MAIN,1,0,0,HLCD_PAD_ZERO+1)==LBTY_ErrorInvalidInput);
+    assert(CLCD_WriteFormattedAsynch(LCD_MAIN,1,LCD_BURST_SIZE+1,0,HLCD_PAD_SPACE)==LBTY_ErrorInvalidInput);
+    assert(CLCD_WriteFormattedAsynch(_LCD_NUM,1,0,0,HLCD_PAD_SPACE)==LBTY_ErrorInvalidInput);
+    assert(CLCD_FrameWriteFormatted(LCD_MAIN,0,0,1,HLCD_FRAME_COLUMNS+1,0,HLCD_PAD_SPACE)==LBTY_ErrorInvalidInput);
+    assert(CLCD_GetFreeSlots(LCD_MAIN)==LCD_BUFFERSIZE);
+    assert(LcdTest_Model.Violations==0);
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_FrameDirtyCells();
+    Test_RingCoalescing();
+    Test_FormatNumber();
+#if HLCD_TIMING == HLCD_TIMING_FIXED_TICKS
+    Test_TicksPerByte();
+#else
+    Test_BusyFlagPacing();
+#endif
+    HD44780_DetachAll();
+    printf("test_lcd: OK\n");
+    return 0;
+}
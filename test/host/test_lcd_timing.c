@@ -0,0 +1,76 @@
+/********************************************************************************************************/
+/* File             :       test_lcd_timing.c                                                           */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Enable timing of CLCD, LCD.c is built into the test to reach the busy loop  */
+/*                          counts it derives from HCLK.                                                */
+/********************************************************************************************************/
+#include "../../src/HAL/HCLCD/LCD.c"
+#include "host_mcal.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define LCDTIMING_MHZ           1000000UL
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+/* Loops of the busy loop to wait at least Copy_Ns at Copy_HclkHz */
+static u32 LcdTiming_Loops(u32 Copy_Ns, u32 Copy_HclkHz)
+{
+    u64 Local_Cycles=((u64)Copy_Ns*Copy_HclkHz+999999999ULL)/1000000000ULL;
+    return (u32)((Local_Cycles+HLCD_DELAY_LOOP_CYCLES-1)/HLCD_DELAY_LOOP_CYCLES);
+}
+
+static void LcdTiming_AssertLoops(u32 Copy_HclkHz)
+{
+    assert(CLCD_PulseLoops==LcdTiming_Loops(HLCD_E_PULSE_NS,Copy_HclkHz));
+    assert(CLCD_LowLoops==LcdTiming_Loops(HLCD_E_CYCLE_NS-HLCD_E_PULSE_NS,Copy_HclkHz));
+    /* Never shorter than asked */
+    assert((u64)CLCD_PulseLoops*HLCD_DELAY_LOOP_CYCLES*1000000000ULL>=(u64)HLCD_E_PULSE_NS*Copy_HclkHz);
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* The loop counts follow HCLK through the MRCC clock change notification */
+static void Test_ClockChange(void)
+{
+    Host_Reset();
+    CLCD_InitAsynch();
+    LcdTiming_AssertLoops(16*LCDTIMING_MHZ);
+    assert(CLCD_PulseLoops==2);
+
+    Host_SetClockHz(84*LCDTIMING_MHZ,42*LCDTIMING_MHZ,84*LCDTIMING_MHZ);
+    LcdTiming_AssertLoops(84*LCDTIMING_MHZ);
+    assert(CLCD_PulseLoops==11);
+
+    Host_SetClockHz(100*LCDTIMING_MHZ,50*LCDTIMING_MHZ,100*LCDTIMING_MHZ);
+    LcdTiming_AssertLoops(100*LCDTIMING_MHZ);
+
+    /* Slow clock, the wait rounds up to one loop */
+    Host_SetClockHz(LCDTIMING_MHZ,LCDTIMING_MHZ,LCDTIMING_MHZ);
+    LcdTiming_AssertLoops(LCDTIMING_MHZ);
+    assert(CLCD_PulseLoops==1);
+
+    /* A second init subscribes only once and keeps up with the clock */
+    CLCD_InitAsynch();
+    Host_SetClockHz(84*LCDTIMING_MHZ,42*LCDTIMING_MHZ,84*LCDTIMING_MHZ);
+    LcdTiming_AssertLoops(84*LCDTIMING_MHZ);
+
+    assert(CLCD_NsToLoops(0,84*LCDTIMING_MHZ)==0);
+    assert(CLCD_NsToLoops(1,16*LCDTIMING_MHZ)==1);
+    assert(CLCD_NsToLoops(1000000000UL,100*LCDTIMING_MHZ)==100*LCDTIMING_MHZ/HLCD_DELAY_LOOP_CYCLES);
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_ClockChange();
+    printf("test_lcd_timing: OK\n");
+    return 0;
+}
@@ -0,0 +1,297 @@
+/********************************************************************************************************/
+/* File             :       test_led.c                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Software PWM of HLED on the RAM GPIO ports: duties, edges per period and    */
+/*                          the table swap at the start of a period, and the pattern sequencer.         */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "HLED/LED.h"
+#include "MGPIO/GPIO.h"
+#include "host_mcal.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern const LEDSCfg_tstr LEDS[_LED_NUM];
+static u32 LedTest_Wakes;   // Calls of the sequencer wake callback
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static u8 LedTest_IsOn(u32 Copy_Led)
+{
+    return Host_GetOutput(LEDS[Copy_Led].Port,LEDS[Copy_Led].Pin)^LEDS[Copy_Led].Connection;
+}
+
+/* Runs one PWM period and counts the steps each LED was on, the LEDs are sampled after every tick */
+static void LedTest_Period(u16 Copy_OnSteps[_LED_NUM])
+{
+    u16 Local_Step;
+    u8 idx;
+    for(idx=0;idx<_LED_NUM;idx++)
+    {
+        Copy_OnSteps[idx]=0;
+    }
+    for(Local_Step=0;Local_Step<LED_PWM_STEPS;Local_Step++)
+    {
+        HLED_PwmTick();
+        for(idx=0;idx<_LED_NUM;idx++)
+        {
+            Copy_OnSteps[idx]+=LedTest_IsOn(idx);
+        }
+    }
+}
+
+static void LedTest_AssertPeriod(const u16 Copy_Expected[_LED_NUM])
+{
+    u16 Local_OnSteps[_LED_NUM];
+    u8 idx;
+    LedTest_Period(Local_OnSteps);
+    for(idx=0;idx<_LED_NUM;idx++)
+    {
+        assert(Local_OnSteps[idx]==Copy_Expected[idx]);
+    }
+}
+
+/* Every LED off and out of the PWM, the ticks stay aligned on the periods from one test to the next */
+static void LedTest_Init(void)
+{
+    u16 Local_OnSteps[_LED_NUM];
+    u8 idx;
+    Host_Reset();
+    assert(HLED_Init()==LBTY_OK);
+    for(idx=0;idx<_LED_NUM;idx++)
+    {
+        assert(HLED_StopBrightness(idx)==LBTY_OK);
+    }
+    assert(HLED_SetFrame(0)==LBTY_OK);
+    LedTest_Period(Local_OnSteps);
+}
+
+/* The PWM is stopped and every track of the sequencer too, without a wake callback */
+static void LedTest_SeqInit(void)
+{
+    u8 idx;
+    LedTest_Init();
+    assert(HLED_SeqSetWakeCallBack(NULL)==LBTY_OK);
+    for(idx=0;idx<LED_SEQ_TRACKS;idx++)
+    {
+        assert(HLED_SeqPlay(idx,NULL)==LBTY_OK);
+    }
+    assert(HLED_SeqUpdate(0)==LED_SEQ_IDLE);
+}
+
+static void LedTest_Wake(void)
+{
+    LedTest_Wakes++;
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* Each LED is on for its duty, the LEDs of one duty share an edge */
+static void Test_Duties(void)
+{
+    const u16 Local_Duties[_LED_NUM]={10,LED_PWM_STEPS,10,0,LED_PWM_STEPS/2};
+    u32 Local_Stores;
+    u8 idx;
+    LedTest_Init();
+    for(idx=0;idx<_LED_NUM;idx++)
+    {
+        assert(HLED_SetBrightness(idx,Local_Duties[idx])==LBTY_OK);
+    }
+    LedTest_AssertPeriod(Local_Duties);
+    /* The start of the period and 2 edges for the duties 10 and 32, all the LEDs are on GPIOB */
+    Local_Stores=Host_GpioStores;
+    LedTest_AssertPeriod(Local_Duties);
+    assert(Host_GpioStores-Local_Stores==3);
+}
+
+/* HLED_PwmEdge returns the steps to the next edge, a period adds up to LED_PWM_STEPS */
+static void Test_EdgeDelays(void)
+{
+    u16 Local_Total=0;
+    u8 Local_Calls=0;
+    LedTest_Init();
+    assert(HLED_SetBrightness(LED_GREEN,5)==LBTY_OK);
+    assert(HLED_SetBrightness(LED_RED,40)==LBTY_OK);
+    assert(HLED_SetBrightness(LED_YELLOW,5)==LBTY_OK);
+    assert(HLED_PwmEdge()==5);
+    assert(LedTest_IsOn(LED_GREEN)&&LedTest_IsOn(LED_RED)&&LedTest_IsOn(LED_YELLOW));
+    assert(HLED_PwmEdge()==35);
+    assert(!LedTest_IsOn(LED_GREEN)&&LedTest_IsOn(LED_RED)&&!LedTest_IsOn(LED_YELLOW));
+    assert(HLED_PwmEdge()==LED_PWM_STEPS-40);
+    assert(!LedTest_IsOn(LED_RED));
+
+    /* Without any edge the period is one call */
+    assert(HLED_SetBrightness(LED_GREEN,0)==LBTY_OK);
+    assert(HLED_SetBrightness(LED_RED,LED_PWM_STEPS)==LBTY_OK);
+    assert(HLED_SetBrightness(LED_YELLOW,LED_PWM_STEPS)==LBTY_OK);
+    do
+    {
+        Local_Total+=HLED_PwmEdge();
+        Local_Calls++;
+    }while(Local_Total<LED_PWM_STEPS);
+    assert(Local_Total==LED_PWM_STEPS);
+    assert(Local_Calls==1);
+    assert(!LedTest_IsOn(LED_GREEN)&&LedTest_IsOn(LED_RED));
+}
+
+/* A new table waits for the next period, the last one built before it is taken */
+static void Test_TableSwap(void)
+{
+    const u16 Local_Old[_LED_NUM]={20,0,0,0,0};
+    const u16 Local_New[_LED_NUM]={48,0,0,0,12};
+    u16 Local_Step;
+    u8 Local_Duty;
+    LedTest_Init();
+    assert(HLED_SetBrightness(LED_GREEN,20)==LBTY_OK);
+    LedTest_AssertPeriod(Local_Old);
+
+    /* Mid-period, before the edge at 20, rebuilt several times while the interrupt holds the old table */
+    for(Local_Step=0;Local_Step<10;Local_Step++)
+    {
+        HLED_PwmTick();
+    }
+    for(Local_Duty=1;Local_Duty<=48;Local_Duty++)
+    {
+        assert(HLED_SetBrightness(LED_GREEN,Local_Duty)==LBTY_OK);
+        assert(HLED_SetBrightness(LED_GREEN2,Local_Duty/4)==LBTY_OK);
+    }
+    for(;Local_Step<LED_PWM_STEPS;Local_Step++)
+    {
+        HLED_PwmTick();
+        assert(LedTest_IsOn(LED_GREEN)==(Local_Step<20));
+        assert(!LedTest_IsOn(LED_GREEN2));
+    }
+    LedTest_AssertPeriod(Local_New);
+    LedTest_AssertPeriod(Local_New);
+}
+
+/* A stopped LED keeps the level it had, the frame APIs drive it again */
+static void Test_Stop(void)
+{
+    const u16 Local_Duties[_LED_NUM]={0,30,0,0,0};
+    const u16 Local_Stopped[_LED_NUM]={0,LED_PWM_STEPS,0,0,0};
+    LedTest_Init();
+    assert(HLED_SetBrightness(LED_RED,30)==LBTY_OK);
+    LedTest_AssertPeriod(Local_Duties);
+    /* The period starts with the LED on */
+    assert(HLED_PwmEdge()==30);
+    assert(HLED_StopBrightness(LED_RED)==LBTY_OK);
+    assert(HLED_PwmEdge()==LED_PWM_STEPS-30);
+    assert(!LedTest_IsOn(LED_RED));
+    assert(HLED_SetStatus(LED_RED,LED_ON)==LBTY_OK);
+    LedTest_AssertPeriod(Local_Stopped);
+}
+
+/* A pattern plays its loops then hands its track to the next one, the last one stops the track */
+static void Test_SeqChain(void)
+{
+    const LEDSeqStep_tstr Local_BlinkSteps[]={{.Frame=LED_BIT(LED_GREEN),.DurationMs=10},{.Frame=0,.DurationMs=10}};
+    const LEDSeqStep_tstr Local_FlashSteps[]={{.Frame=LED_BIT(LED_RED),.DurationMs=5}};
+    const LEDPattern_tstr Local_Flash={.Mask=LED_BIT(LED_RED),.Steps=Local_FlashSteps,.StepsNum=1,.Loops=1,.Next=NULL};
+    const LEDPattern_tstr Local_Blink={.Mask=LED_BIT(LED_GREEN),.Steps=Local_BlinkSteps,.StepsNum=2,.Loops=2,.Next=&Local_Flash};
+    u32 Local_Now;
+    LedTest_SeqInit();
+    assert(HLED_SeqPlay(0,&Local_Blink)==LBTY_OK);
+    for(Local_Now=1000;Local_Now<1040;Local_Now+=20)
+    {
+        assert(HLED_SeqUpdate(Local_Now)==10);
+        assert(LedTest_IsOn(LED_GREEN)&&!LedTest_IsOn(LED_RED));
+        assert(HLED_SeqUpdate(Local_Now+10)==10);
+        assert(!LedTest_IsOn(LED_GREEN));
+    }
+    /* After its 2 loops the blink is followed by the flash, it only drives its own LED */
+    assert(HLED_SeqUpdate(1040)==5);
+    assert(!LedTest_IsOn(LED_GREEN)&&LedTest_IsOn(LED_RED));
+    assert(HLED_SeqUpdate(1045)==LED_SEQ_IDLE);
+    assert(LedTest_IsOn(LED_RED));
+    assert(HLED_SeqUpdate(2000)==LED_SEQ_IDLE);
+}
+
+/* A step of 0 ms is shown for 1 ms, as the first step it is over on the update that starts the pattern */
+static void Test_SeqZeroStep(void)
+{
+    const LEDSeqStep_tstr Local_Steps[]={{.Frame=LED_BIT(LED_YELLOW),.DurationMs=0},{.Frame=0,.DurationMs=10}};
+    const LEDPattern_tstr Local_Pattern={.Mask=LED_BIT(LED_YELLOW),.Steps=Local_Steps,.StepsNum=2,.Loops=0,.Next=NULL};
+    LedTest_SeqInit();
+    assert(HLED_SeqPlay(1,&Local_Pattern)==LBTY_OK);
+    assert(HLED_SeqUpdate(0)==10);
+    assert(!LedTest_IsOn(LED_YELLOW));
+    assert(HLED_SeqUpdate(10)==1);
+    assert(LedTest_IsOn(LED_YELLOW));
+    assert(HLED_SeqUpdate(11)==10);
+    assert(!LedTest_IsOn(LED_YELLOW));
+}
+
+/* A late update goes through the steps that ended, shows only the last one and keeps the deadlines */
+static void Test_SeqCatchUp(void)
+{
+    const LEDSeqStep_tstr Local_Steps[]={{.Frame=LED_BIT(LED_GREEN2),.DurationMs=10},{.Frame=0,.DurationMs=10}};
+    const LEDPattern_tstr Local_Pattern={.Mask=LED_BIT(LED_GREEN2),.Steps=Local_Steps,.StepsNum=2,.Loops=0,.Next=NULL};
+    const LEDSeqStep_tstr Local_SlowSteps[]={{.Frame=LED_BIT(LED_RED2),.DurationMs=100}};
+    const LEDPattern_tstr Local_Slow={.Mask=LED_BIT(LED_RED2),.Steps=Local_SlowSteps,.StepsNum=1,.Loops=0,.Next=NULL};
+    u32 Local_Stores;
+    LedTest_SeqInit();
+    assert(HLED_SeqPlay(0,&Local_Slow)==LBTY_OK);
+    assert(HLED_SeqPlay(2,&Local_Pattern)==LBTY_OK);
+    assert(HLED_SeqUpdate(100)==10);
+    assert(LedTest_IsOn(LED_GREEN2)&&LedTest_IsOn(LED_RED2));
+    /* The steps ending at 110, 120 and 130 are passed, the one of 130 is shown with a single store */
+    Local_Stores=Host_GpioStores;
+    assert(HLED_SeqUpdate(135)==5);
+    assert(Host_GpioStores-Local_Stores==1);
+    assert(!LedTest_IsOn(LED_GREEN2));
+    assert(HLED_SeqUpdate(140)==10);
+    assert(LedTest_IsOn(LED_GREEN2));
+}
+
+/* HLED_SeqPlay wakes the caller of HLED_SeqUpdate for every accepted track change */
+static void Test_SeqWake(void)
+{
+    const LEDSeqStep_tstr Local_Steps[]={{.Frame=LED_BIT(LED_RED),.DurationMs=10}};
+    const LEDPattern_tstr Local_Pattern={.Mask=LED_BIT(LED_RED),.Steps=Local_Steps,.StepsNum=1,.Loops=0,.Next=NULL};
+    const LEDPattern_tstr Local_Empty={.Mask=LED_BIT(LED_RED),.Steps=Local_Steps,.StepsNum=0,.Loops=0,.Next=NULL};
+    LedTest_SeqInit();
+    LedTest_Wakes=0;
+    assert(HLED_SeqSetWakeCallBack(LedTest_Wake)==LBTY_OK);
+    assert(HLED_SeqPlay(0,&Local_Pattern)==LBTY_OK);
+    assert(LedTest_Wakes==1);
+    assert(HLED_SeqPlay(0,NULL)==LBTY_OK);
+    assert(LedTest_Wakes==2);
+    assert(HLED_SeqPlay(LED_SEQ_TRACKS,&Local_Pattern)==LBTY_NOK);
+    assert(HLED_SeqPlay(0,&Local_Empty)==LBTY_NOK);
+    assert(LedTest_Wakes==2);
+    assert(HLED_SeqSetWakeCallBack(NULL)==LBTY_OK);
+    assert(HLED_SeqPlay(0,&Local_Pattern)==LBTY_OK);
+    assert(LedTest_Wakes==2);
+}
+
+static void Test_InvalidArguments(void)
+{
+    LedTest_Init();
+    assert(HLED_SetBrightness(_LED_NUM,1)==LBTY_NOK);
+    assert(HLED_SetBrightness(LED_GREEN,LED_PWM_STEPS+1)==LBTY_NOK);
+    assert(HLED_StopBrightness(_LED_NUM)==LBTY_NOK);
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_Duties();
+    Test_EdgeDelays();
+    Test_TableSwap();
+    Test_Stop();
+    Test_SeqChain();
+    Test_SeqZeroStep();
+    Test_SeqCatchUp();
+    Test_SeqWake();
+    Test_InvalidArguments();
+    printf("test_led: OK\n");
+    return 0;
+}
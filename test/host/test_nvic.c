@@ -0,0 +1,259 @@
+/********************************************************************************************************/
+/* File             :       test_nvic.c                                                                 */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Priorities set by MNVIC_Init, and the interrupt and critical section        */
+/*                          statistics of MNVIC on NVIC_HostCycles, built with NVIC_ISR_STATS enabled   */
+/*                          and disabled. NVIC.c is built into the test to read its host registers.     */
+/********************************************************************************************************/
+#include "../../src/MCAL/MNVIC/NVIC.c"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define NVICTEST_WRAP_START     0xFFFFFFF0UL    // NVIC_HostCycles 16 cycles before it wraps
+#define NVICTEST_SHPR3_PENDSV   0x00E00000UL    // PendSV at level 14, the byte below SysTick in SHPR3
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void NvicTest_Cycles(uint32_t Copy_Cycles)
+{
+    NVIC_HostCycles+=Copy_Cycles;
+}
+
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+static void NvicTest_AssertIrq(u8 Copy_Irq, u32 Copy_Count, u32 Copy_Max, u64 Copy_Total)
+{
+    NVIC_IrqStats_tstr Local_Stats;
+    assert(MNVIC_GetIrqStats(Copy_Irq,&Local_Stats)==LBTY_OK);
+    assert(Local_Stats.Count==Copy_Count);
+    assert(Local_Stats.MaxCycles==Copy_Max);
+    assert(Local_Stats.TotalCycles==Copy_Total);
+}
+
+static void NvicTest_AssertBlocked(u32 Copy_Count, u32 Copy_Max, u64 Copy_Total)
+{
+    NVIC_IrqStats_tstr Local_Stats;
+    assert(MNVIC_GetBlockedStats(&Local_Stats)==LBTY_OK);
+    assert(Local_Stats.Count==Copy_Count);
+    assert(Local_Stats.MaxCycles==Copy_Max);
+    assert(Local_Stats.TotalCycles==Copy_Total);
+}
+#endif
+
+static void NvicTest_Init(void)
+{
+    NVIC_HostCycles=0;
+    MNVIC_Init();
+    MNVIC_ResetStats();
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* All the bits are preemption bits, the interrupts of the plan get their level, the others stay at 0 */
+static void Test_Priorities(void)
+{
+    u8 idx;
+    memset((void *)&NVIC_HostRegs,0,sizeof(NVIC_HostRegs));
+    memset((void *)&SCB_HostRegs,0,sizeof(SCB_HostRegs));
+    SCB_HostRegs.SHPR[SCB_SHPR3_INDEX]=NVICTEST_SHPR3_PENDSV;
+    NvicTest_Init();
+    assert(SCB_HostRegs.AIRCR==GROUP_4_BIT_SUB_0_BIT);
+    for(idx=0;idx<NVIC_PriorityPlanNum;idx++)
+    {
+        assert(NVIC_HostRegs.IPR[NVIC_PriorityPlan[idx].InterruptID]==(NVIC_PriorityPlan[idx].Priority<<NVIC_OFFSET_4));
+    }
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_DMA1_STREAM0]==(NVIC_PRIO_DMA<<NVIC_OFFSET_4));
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_DMA2_STREAM7]==(NVIC_PRIO_DMA<<NVIC_OFFSET_4));
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_USART2]==(NVIC_PRIO_USART<<NVIC_OFFSET_4));
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_EXTI0]==(NVIC_PRIO_EXTI<<NVIC_OFFSET_4));
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_EXTI15_10]==(NVIC_PRIO_EXTI<<NVIC_OFFSET_4));
+    assert(NVIC_HostRegs.IPR[NVIC_IRQ_TIM2]==0);
+    /* SysTick is the least urgent level, the other system handlers of SHPR3 are left alone */
+    assert(SCB_HostRegs.SHPR[SCB_SHPR3_INDEX]==(((u32)NVIC_PRIO_SYSTICK<<SCB_SHPR3_SYSTICK_OFFSET)|NVICTEST_SHPR3_PENDSV));
+}
+
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+/* A handler is charged its own cycles, the whole run of the handlers preempting it is taken out */
+static void Test_Nesting(void)
+{
+    NvicTest_Init();
+    MNVIC_StatsEnter(NVIC_IRQ_EXTI0);
+    NvicTest_Cycles(100);
+    MNVIC_StatsEnter(NVIC_IRQ_USART1);
+    NvicTest_Cycles(50);
+    MNVIC_StatsEnter(NVIC_IRQ_TIM2);
+    NvicTest_Cycles(20);
+    MNVIC_StatsExit(NVIC_IRQ_TIM2);
+    NvicTest_Cycles(30);
+    MNVIC_StatsExit(NVIC_IRQ_USART1);
+    NvicTest_Cycles(10);
+    MNVIC_StatsExit(NVIC_IRQ_EXTI0);
+    NvicTest_AssertIrq(NVIC_IRQ_EXTI0,1,110,110);
+    NvicTest_AssertIrq(NVIC_IRQ_USART1,1,80,80);
+    NvicTest_AssertIrq(NVIC_IRQ_TIM2,1,20,20);
+    assert(MNVIC_GetMaxPreemptionDepth()==3);
+
+    /* Two preemptions of the same handler, then a second run alone */
+    MNVIC_StatsEnter(NVIC_IRQ_EXTI0);
+    NvicTest_Cycles(5);
+    MNVIC_StatsEnter(NVIC_IRQ_TIM2);
+    NvicTest_Cycles(40);
+    MNVIC_StatsExit(NVIC_IRQ_TIM2);
+    MNVIC_StatsEnter(NVIC_IRQ_TIM2);
+    NvicTest_Cycles(60);
+    MNVIC_StatsExit(NVIC_IRQ_TIM2);
+    NvicTest_Cycles(5);
+    MNVIC_StatsExit(NVIC_IRQ_EXTI0);
+    MNVIC_StatsEnter(NVIC_IRQ_EXTI0);
+    NvicTest_Cycles(200);
+    MNVIC_StatsExit(NVIC_IRQ_EXTI0);
+    NvicTest_AssertIrq(NVIC_IRQ_EXTI0,3,200,320);
+    NvicTest_AssertIrq(NVIC_IRQ_TIM2,3,60,120);
+    assert(MNVIC_GetMaxPreemptionDepth()==3);
+
+    MNVIC_ResetStats();
+    NvicTest_AssertIrq(NVIC_IRQ_EXTI0,0,0,0);
+    assert(MNVIC_GetMaxPreemptionDepth()==0);
+}
+
+/* Deeper than one handler per level, a handler past the limit is not measured and is charged to the one it preempted */
+static void Test_DepthLimit(void)
+{
+    u8 idx;
+    NvicTest_Init();
+    for(idx=0;idx<=NVIC_PRIO_LEVELS;idx++)
+    {
+        MNVIC_StatsEnter(NVIC_IRQ_TIM2);
+        NvicTest_Cycles(1);
+    }
+    for(idx=0;idx<=NVIC_PRIO_LEVELS;idx++)
+    {
+        MNVIC_StatsExit(NVIC_IRQ_TIM2);
+    }
+    assert(MNVIC_GetMaxPreemptionDepth()==NVIC_PRIO_LEVELS+1);
+    NvicTest_AssertIrq(NVIC_IRQ_TIM2,NVIC_PRIO_LEVELS,2,NVIC_PRIO_LEVELS+1);
+
+    /* An exit without its entry is ignored */
+    MNVIC_ResetStats();
+    MNVIC_StatsExit(NVIC_IRQ_TIM2);
+    NvicTest_AssertIrq(NVIC_IRQ_TIM2,0,0,0);
+}
+
+/* The 32-bit counter wraps like CYCCNT, a run across the wrap is measured right */
+static void Test_CounterWrap(void)
+{
+    u32 Local_Primask;
+    NvicTest_Init();
+    NVIC_HostCycles=NVICTEST_WRAP_START;
+    MNVIC_StatsEnter(NVIC_IRQ_USART1);
+    NvicTest_Cycles(0x30);
+    assert(NVIC_HostCycles==0x20);
+    MNVIC_StatsExit(NVIC_IRQ_USART1);
+    NvicTest_AssertIrq(NVIC_IRQ_USART1,1,0x30,0x30);
+
+    NVIC_HostCycles=NVICTEST_WRAP_START;
+    Local_Primask=MNVIC_EnterCritical();
+    NvicTest_Cycles(0x40);
+    MNVIC_ExitCritical(Local_Primask);
+    NvicTest_AssertBlocked(1,0x40,0x40);
+}
+
+/* Only the outermost critical section is measured, the inner ones give back a masked PRIMASK */
+static void Test_BlockedNesting(void)
+{
+    u32 Local_Outer;
+    u32 Local_Inner;
+    u32 Local_Deepest;
+    NvicTest_Init();
+    Local_Outer=MNVIC_EnterCritical();
+    assert(Local_Outer==0);
+    NvicTest_Cycles(10);
+    Local_Inner=MNVIC_EnterCritical();
+    assert(Local_Inner!=0);
+    NvicTest_Cycles(20);
+    Local_Deepest=MNVIC_EnterCritical();
+    assert(Local_Deepest!=0);
+    NvicTest_Cycles(5);
+    MNVIC_ExitCritical(Local_Deepest);
+    MNVIC_ExitCritical(Local_Inner);
+    NvicTest_AssertBlocked(0,0,0);
+    NvicTest_Cycles(15);
+    MNVIC_ExitCritical(Local_Outer);
+    NvicTest_AssertBlocked(1,50,50);
+
+    /* Unmasked again, the next section is a new outermost one */
+    Local_Outer=MNVIC_EnterCritical();
+    assert(Local_Outer==0);
+    NvicTest_Cycles(7);
+    MNVIC_ExitCritical(Local_Outer);
+    NvicTest_AssertBlocked(2,50,57);
+
+    /* A section inside a handler is both blocked time and time of the handler */
+    MNVIC_StatsEnter(NVIC_IRQ_EXTI0);
+    Local_Outer=MNVIC_EnterCritical();
+    NvicTest_Cycles(9);
+    MNVIC_ExitCritical(Local_Outer);
+    MNVIC_StatsExit(NVIC_IRQ_EXTI0);
+    NvicTest_AssertBlocked(3,50,66);
+    NvicTest_AssertIrq(NVIC_IRQ_EXTI0,1,9,9);
+
+    MNVIC_ResetStats();
+    NvicTest_AssertBlocked(0,0,0);
+}
+
+static void Test_InvalidArguments(void)
+{
+    NVIC_IrqStats_tstr Local_Stats;
+    NvicTest_Init();
+    assert(MNVIC_GetIrqStats(_NVIC_IRQ_NUM,&Local_Stats)==LBTY_ErrorInvalidInput);
+    assert(MNVIC_GetIrqStats(NVIC_IRQ_EXTI0,NULL)==LBTY_ErrorNullPointer);
+    assert(MNVIC_GetBlockedStats(NULL)==LBTY_ErrorNullPointer);
+}
+#else
+/* Without the statistics the sections still nest, nothing is measured */
+static void Test_NoStats(void)
+{
+    NVIC_IrqStats_tstr Local_Stats;
+    u32 Local_Outer;
+    u32 Local_Inner;
+    NvicTest_Init();
+    Local_Outer=MNVIC_EnterCritical();
+    Local_Inner=MNVIC_EnterCritical();
+    assert((Local_Outer==0)&&(Local_Inner!=0));
+    MNVIC_ExitCritical(Local_Inner);
+    MNVIC_ExitCritical(Local_Outer);
+    assert(MNVIC_EnterCritical()==0);
+    MNVIC_ExitCritical(0);
+
+    MNVIC_StatsEnter(NVIC_IRQ_EXTI0);
+    NvicTest_Cycles(10);
+    MNVIC_StatsExit(NVIC_IRQ_EXTI0);
+    assert(MNVIC_GetIrqStats(NVIC_IRQ_EXTI0,&Local_Stats)==LBTY_NOK);
+    assert(MNVIC_GetBlockedStats(&Local_Stats)==LBTY_NOK);
+    assert(MNVIC_GetMaxPreemptionDepth()==0);
+}
+#endif
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_Priorities();
+#if NVIC_ISR_STATS==NVIC_STATS_ENABLE
+    Test_Nesting();
+    Test_DepthLimit();
+    Test_CounterWrap();
+    Test_BlockedNesting();
+    Test_InvalidArguments();
+#else
+    Test_NoStats();
+#endif
+    printf("test_nvic: OK\n");
+    return 0;
+}
@@ -0,0 +1,255 @@
+/********************************************************************************************************/
+/* File             :       test_rcc.c                                                                  */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Clock references of MRCC_AcquireClock/MRCC_ReleaseClock, the checks of the  */
+/*                          clock plans and MRCC_ConfigureSystemClock on the RAM RCC model.            */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "MRCC/RCC.h"
+#include "host_rcc.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define RCCTEST_LATENCY_MASK    0x0F
+#define RCCTEST_ACR_CACHES      0x00000700UL    // PRFTEN, ICEN and DCEN
+#define RCCTEST_CR_HSEON        (1UL<<16)
+#define RCCTEST_CR_PLLON        (1UL<<24)
+#define RCCTEST_SWS(CFGR)       (((CFGR)>>2)&0x03)
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern uint32_t SystemCoreClock;
+static u32 RccTest_Changes;     // Calls of the clock change subscriber
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void RccTest_ClockChanged(void)
+{
+    RccTest_Changes++;
+}
+
+static u8 RccTest_Refs(u8 Copy_Bus, u32 Copy_Peripheral)
+{
+    u8 Local_Refs;
+    assert(MRCC_GetClockRefs(Copy_Bus,Copy_Peripheral,&Local_Refs)==LBTY_OK);
+    return Local_Refs;
+}
+
+/* Registers at reset and the frequencies read back from them */
+static void RccTest_Init(void)
+{
+    Host_RccReset();
+    MRCC_UpdateClockFrequencies();
+    RccTest_Changes=0;
+}
+
+static void RccTest_AssertClocks(u32 Copy_SysClkHz, u32 Copy_HCLKHz, u32 Copy_PCLK1Hz, u32 Copy_PCLK2Hz)
+{
+    assert(MRCC_GetSYSCLKHz()==Copy_SysClkHz);
+    assert(MRCC_GetHCLKHz()==Copy_HCLKHz);
+    assert(MRCC_GetPCLK1Hz()==Copy_PCLK1Hz);
+    assert(MRCC_GetPCLK2Hz()==Copy_PCLK2Hz);
+    assert(SystemCoreClock==Copy_HCLKHz);
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* The first user turns the clock on, the last one turns it off, the other bits of the bus are left alone */
+static void Test_AcquireRelease(void)
+{
+    u32 Local_Clocks;
+    RccTest_Init();
+    assert(MRCC_AcquireClock(RCC_AHB1,RCC_AHB1_GPIOA)==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_AHB1ENR)==RCC_AHB1_GPIOA);
+    assert(MRCC_AcquireClock(RCC_AHB1,RCC_AHB1_GPIOA)==LBTY_OK);
+    assert(MRCC_AcquireClock(RCC_AHB1,RCC_AHB1_DMA2)==LBTY_OK);
+    assert(RccTest_Refs(RCC_AHB1,RCC_AHB1_GPIOA)==2);
+    assert(MRCC_GetLiveClocks(RCC_AHB1,&Local_Clocks)==LBTY_OK);
+    assert(Local_Clocks==(RCC_AHB1_GPIOA|RCC_AHB1_DMA2));
+
+    assert(MRCC_ReleaseClock(RCC_AHB1,RCC_AHB1_GPIOA)==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_AHB1ENR)==(RCC_AHB1_GPIOA|RCC_AHB1_DMA2));
+    assert(MRCC_ReleaseClock(RCC_AHB1,RCC_AHB1_GPIOA)==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_AHB1ENR)==RCC_AHB1_DMA2);
+    assert(RccTest_Refs(RCC_AHB1,RCC_AHB1_GPIOA)==0);
+
+    /* A release without its acquire is refused and leaves the other users alone */
+    assert(MRCC_ReleaseClock(RCC_AHB1,RCC_AHB1_GPIOA)==LBTY_NOK);
+    assert(MRCC_ReleaseClock(RCC_AHB1,RCC_AHB1_DMA2)==LBTY_OK);
+    assert(MRCC_ReleaseClock(RCC_AHB1,RCC_AHB1_DMA2)==LBTY_NOK);
+    assert(Host_RccReg(HOST_RCC_AHB1ENR)==0);
+
+    /* Each bus has its own register */
+    assert(MRCC_AcquireClock(RCC_APB1,RCC_APB1_USART2)==LBTY_OK);
+    assert(MRCC_AcquireClock(RCC_APB2,RCC_APB2_SYSCFG)==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_APB1ENR)==RCC_APB1_USART2);
+    assert(Host_RccReg(HOST_RCC_APB2ENR)==RCC_APB2_SYSCFG);
+    assert(MRCC_ReleaseClock(RCC_APB1,RCC_APB1_USART2)==LBTY_OK);
+    assert(MRCC_ReleaseClock(RCC_APB2,RCC_APB2_SYSCFG)==LBTY_OK);
+    assert((Host_RccReg(HOST_RCC_APB1ENR)|Host_RccReg(HOST_RCC_APB2ENR))==0);
+}
+
+/* The references of a clock stop at RCC_REFS_MAX, the clock stays on until every one is released */
+static void Test_RefsCap(void)
+{
+    u16 idx;
+    RccTest_Init();
+    for(idx=0;idx<RCC_REFS_MAX;idx++)
+    {
+        assert(MRCC_AcquireClock(RCC_AHB2,RCC_AHB2_OTGFS)==LBTY_OK);
+    }
+    assert(MRCC_AcquireClock(RCC_AHB2,RCC_AHB2_OTGFS)==LBTY_NOK);
+    assert(RccTest_Refs(RCC_AHB2,RCC_AHB2_OTGFS)==RCC_REFS_MAX);
+    for(idx=1;idx<RCC_REFS_MAX;idx++)
+    {
+        assert(MRCC_ReleaseClock(RCC_AHB2,RCC_AHB2_OTGFS)==LBTY_OK);
+    }
+    assert(Host_RccReg(HOST_RCC_AHB2ENR)==RCC_AHB2_OTGFS);
+    assert(MRCC_ReleaseClock(RCC_AHB2,RCC_AHB2_OTGFS)==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_AHB2ENR)==0);
+}
+
+static void Test_InvalidClocks(void)
+{
+    u32 Local_Clocks;
+    u8 Local_Refs;
+    RccTest_Init();
+    assert(MRCC_AcquireClock(RCC_APB2+1,RCC_APB2_TIM1)==LBTY_ErrorInvalidInput);
+    assert(MRCC_AcquireClock(RCC_AHB1,RCC_AHB1_GPIOA|RCC_AHB1_GPIOB)==LBTY_ErrorInvalidInput);
+    assert(MRCC_AcquireClock(RCC_AHB1,0)==LBTY_ErrorInvalidInput);
+    /* bit 5 of AHB1ENR is reserved */
+    assert(MRCC_AcquireClock(RCC_AHB1,1UL<<5)==LBTY_ErrorInvalidInput);
+    assert(MRCC_ReleaseClock(RCC_AHB2,RCC_AHB1_GPIOA)==LBTY_ErrorInvalidInput);
+    assert(MRCC_GetLiveClocks(RCC_AHB1,NULL)==LBTY_ErrorNullPointer);
+    assert(MRCC_GetLiveClocks(0,&Local_Clocks)==LBTY_ErrorInvalidInput);
+    assert(MRCC_GetClockRefs(RCC_AHB1,RCC_AHB1_GPIOA,NULL)==LBTY_ErrorNullPointer);
+    assert(MRCC_GetClockRefs(RCC_AHB1,RCC_APB1_PWR,&Local_Refs)==LBTY_ErrorInvalidInput);
+    assert(Host_RccReg(HOST_RCC_AHB1ENR)==0);
+}
+
+/* HCLK of the plans of RCC_Cfg.c, and the limits of the chip */
+static void Test_PlanHCLK(void)
+{
+    const u32 Local_Expected[_RCC_PLAN_NUM]={16000000UL,42000000UL,84000000UL,84000000UL};
+    RCC_ClockPlan_tstr Local_Plan;
+    u32 Local_HCLKHz;
+    u8 idx;
+    for(idx=0;idx<_RCC_PLAN_NUM;idx++)
+    {
+        assert(MRCC_GetPlanHCLKHz(&RCC_ClockPlans[idx],&Local_HCLKHz)==LBTY_OK);
+        assert(Local_HCLKHz==Local_Expected[idx]);
+    }
+    /* 84 MHz with an 84 MHz PCLK1 */
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ];
+    Local_Plan.APB1Div=1;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    /* 168 MHz SYSCLK */
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ];
+    Local_Plan.PLLP=2;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    /* odd P, a VCO input of 4 MHz and a 48 MHz clock of 67 MHz */
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ];
+    Local_Plan.PLLP=3;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ];
+    Local_Plan.PLLM=4;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ];
+    Local_Plan.PLLQ=5;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    /* an AHB divider the chip doesn't have */
+    Local_Plan=RCC_ClockPlans[RCC_PLAN_HSI_16MHZ];
+    Local_Plan.AHBDiv=32;
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,&Local_HCLKHz)==LBTY_ErrorInvalidInput);
+    assert(MRCC_GetPlanHCLKHz(NULL,&Local_HCLKHz)==LBTY_ErrorNullPointer);
+    assert(MRCC_GetPlanHCLKHz(&Local_Plan,NULL)==LBTY_ErrorNullPointer);
+}
+
+/* Up to 84 MHz, down to 42 MHz on the same PLL, back to HSI: wait states, PLL and frequencies follow */
+static void Test_ConfigureSystemClock(void)
+{
+    RccTest_Init();
+    RccTest_AssertClocks(16000000UL,16000000UL,16000000UL,16000000UL);
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ])==LBTY_OK);
+    assert(RCCTEST_SWS(Host_RccReg(HOST_RCC_CFGR))==RCC_SYSTEM_CLOCK_PLL);
+    assert((Host_RccReg(HOST_FLASH_ACR)&RCCTEST_LATENCY_MASK)==2);
+    assert((Host_RccReg(HOST_FLASH_ACR)&RCCTEST_ACR_CACHES)==RCCTEST_ACR_CACHES);
+    assert(Host_RccPllStarts==1);
+    RccTest_AssertClocks(84000000UL,84000000UL,42000000UL,84000000UL);
+    assert(RccTest_Changes!=0);
+
+    /* Same PLL settings, only the prescalers and the wait states change */
+    RccTest_Changes=0;
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_42MHZ])==LBTY_OK);
+    assert(Host_RccPllStarts==1);
+    assert((Host_RccReg(HOST_FLASH_ACR)&RCCTEST_LATENCY_MASK)==1);
+    RccTest_AssertClocks(84000000UL,42000000UL,42000000UL,42000000UL);
+    assert(RccTest_Changes!=0);
+
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_16MHZ])==LBTY_OK);
+    assert(RCCTEST_SWS(Host_RccReg(HOST_RCC_CFGR))==RCC_SYSTEM_CLOCK_HSI);
+    assert((Host_RccReg(HOST_FLASH_ACR)&RCCTEST_LATENCY_MASK)==0);
+    assert((Host_RccReg(HOST_RCC_CR)&RCCTEST_CR_PLLON)==0);
+    RccTest_AssertClocks(16000000UL,16000000UL,16000000UL,16000000UL);
+}
+
+/* The HSE plan starts HSE and feeds the PLL from it, the HSI plans stop it */
+static void Test_ConfigureHSE(void)
+{
+    RccTest_Init();
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSE_PLL_84MHZ])==LBTY_OK);
+    assert(Host_RccReg(HOST_RCC_CR)&RCCTEST_CR_HSEON);
+    assert(Host_RccReg(HOST_RCC_PLLCFGR)&(1UL<<22));
+    RccTest_AssertClocks(84000000UL,84000000UL,42000000UL,84000000UL);
+
+    /* The PLL changes source, it is stopped and locked again from HSI */
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ])==LBTY_OK);
+    assert(Host_RccPllStarts==2);
+    assert((Host_RccReg(HOST_RCC_CR)&RCCTEST_CR_HSEON)==0);
+    RccTest_AssertClocks(84000000UL,84000000UL,42000000UL,84000000UL);
+}
+
+/* A PLL that doesn't lock leaves the system on HSI, the frequencies give the clock that runs */
+static void Test_ConfigureFailure(void)
+{
+    RccTest_Init();
+    Host_RccStall(HOST_RCC_PLLRDY);
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ])==LBTY_NOK);
+    assert(RCCTEST_SWS(Host_RccReg(HOST_RCC_CFGR))==RCC_SYSTEM_CLOCK_HSI);
+    assert((Host_RccReg(HOST_FLASH_ACR)&RCCTEST_LATENCY_MASK)==0);
+    RccTest_AssertClocks(16000000UL,16000000UL,16000000UL,16000000UL);
+
+    /* Running from the PLL, a HSE that doesn't start moves the system to HSI first */
+    Host_RccStall(0);
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSI_PLL_84MHZ])==LBTY_OK);
+    Host_RccStall(HOST_RCC_HSERDY);
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[RCC_PLAN_HSE_PLL_84MHZ])==LBTY_NOK);
+    assert(RCCTEST_SWS(Host_RccReg(HOST_RCC_CFGR))==RCC_SYSTEM_CLOCK_HSI);
+    /* the prescalers of the 84 MHz plan are kept, APB1 /2 */
+    RccTest_AssertClocks(16000000UL,16000000UL,8000000UL,16000000UL);
+    assert(MRCC_ConfigureSystemClock(NULL)==LBTY_ErrorNullPointer);
+}
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    assert(MRCC_SubscribeClockChange(RccTest_ClockChanged)==LBTY_OK);
+    Test_AcquireRelease();
+    Test_RefsCap();
+    Test_InvalidClocks();
+    Test_PlanHCLK();
+    Test_ConfigureSystemClock();
+    Test_ConfigureHSE();
+    Test_ConfigureFailure();
+    printf("test_rcc: OK\n");
+    return 0;
+}
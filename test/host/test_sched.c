@@ -0,0 +1,304 @@
+/********************************************************************************************************/
+/* File             :       test_sched.c                                                                */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Load windows and clock governor of SCHED, SCHED.c is built into the test.   */
+/*                          SysTick is a counter of this file that the runnables burn down, the clock   */
+/*                          plans only change its reload.                                               */
+/********************************************************************************************************/
+#include "../../src/SERVICE/SCHED/SCHED.c"
+#include "MRCC/RCC.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define SCHEDTEST_MHZ           1000000UL
+#define SCHEDTEST_SW_PERIOD_MS  5       // Period of SW_Runnable in SCHED_Config.c, the one that burns the work
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+static u32 SchedTest_HclkHz;
+static u32 SchedTest_Counter;
+static u32 SchedTest_Work;      // Cycles burnt by each run of SW_Runnable
+static u32 SchedTest_Spike;     // Cycles burnt once by the next run of KPDScan_Runnable
+static u8 SchedTest_EveryMs;    // SW_Runnable runs every tick through Sched_SetNextDelay
+static u32 SchedTest_Plans;     // Calls of MRCC_ConfigureSystemClock
+/* HCLK of each plan of RCC_Cfg.c */
+static const u32 SchedTest_PlanHz[_RCC_PLAN_NUM]={
+    [RCC_PLAN_HSI_16MHZ]=16*SCHEDTEST_MHZ,
+    [RCC_PLAN_HSI_PLL_42MHZ]=42*SCHEDTEST_MHZ,
+    [RCC_PLAN_HSI_PLL_84MHZ]=84*SCHEDTEST_MHZ,
+    [RCC_PLAN_HSE_PLL_84MHZ]=84*SCHEDTEST_MHZ,
+};
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+/* Time spent by the CPU, the counter reloads and the tick interrupt runs each time it passes 0 */
+static void SchedTest_Burn(u32 Copy_Cycles)
+{
+    while(Copy_Cycles>SchedTest_Counter)
+    {
+        Copy_Cycles-=SchedTest_Counter+1;
+        SchedTest_Counter=MSTK_GetReloadValue();
+        TickCb();
+    }
+    SchedTest_Counter-=Copy_Cycles;
+}
+
+/* Runs the scheduler loop for Copy_Runs ticks, waiting for the next tick when none is pending */
+static void SchedTest_Run(u32 Copy_Runs)
+{
+    while(Copy_Runs--)
+    {
+        if(PendingTicks==0)
+        {
+            SchedTest_Counter=MSTK_GetReloadValue();
+            TickCb();
+        }
+        Sched_RunPending();
+    }
+}
+
+static SchedStats_tstr SchedTest_Stats(void)
+{
+    SchedStats_tstr Local_Stats;
+    assert(Sched_GetStats(&Local_Stats)==LBTY_OK);
+    return Local_Stats;
+}
+
+/* Fresh scheduler started on its first plan, like StartSched */
+static void SchedTest_Init(u32 Copy_Work)
+{
+    PendingTicks=0;
+    SchedWindowBusy=0;
+    SchedWindowTicks=0;
+    SchedWindowMissed=0;
+    SchedStats=(SchedStats_tstr){0};
+    SchedTest_HclkHz=84*SCHEDTEST_MHZ;
+    SchedTest_Work=Copy_Work;
+    SchedTest_Spike=0;
+    SchedTest_EveryMs=0;
+    SchedTest_Plans=0;
+    Sched_Init();
+#if SCHED_GOVERNOR==SCHED_ENABLE
+    SchedLowWindows=0;
+    SchedStats.PlanIndex=SCHED_GOV_PLANS_NUM-1;
+    assert(MRCC_ConfigureSystemClock(&RCC_ClockPlans[SchedGovernorPlans[SchedStats.PlanIndex]])==LBTY_OK);
+#endif
+}
+
+/********************************************************************************************************/
+/*********************************************Stubs******************************************************/
+/********************************************************************************************************/
+void MSTK_Init(void)
+{
+}
+
+tenu_ErrorStatus MSTK_SetTimerMS(u32 Copy_MSTime)
+{
+    (void)Copy_MSTime;
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus MSTK_SetSTKCallBack(STK_CBF_t Fptr)
+{
+    (void)Fptr;
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus MSTK_StartTimerMSPeriodic()
+{
+    return LBTY_OK;
+}
+
+u32 MSTK_GetCounterValue(void)
+{
+    return SchedTest_Counter;
+}
+
+/* 1 ms at HCLK, the tick follows the clock plans like the MRCC subscriber of STK */
+u32 MSTK_GetReloadValue(void)
+{
+    return SchedTest_HclkHz/1000-1;
+}
+
+tenu_ErrorStatus MRCC_GetPlanHCLKHz(const RCC_ClockPlan_tstr * ADD_Plan, u32 *ADD_HCLKHz)
+{
+    *ADD_HCLKHz=SchedTest_PlanHz[ADD_Plan-RCC_ClockPlans];
+    return LBTY_OK;
+}
+
+tenu_ErrorStatus MRCC_ConfigureSystemClock(const RCC_ClockPlan_tstr * ADD_Plan)
+{
+    SchedTest_HclkHz=SchedTest_PlanHz[ADD_Plan-RCC_ClockPlans];
+    SchedTest_Plans++;
+    return LBTY_OK;
+}
+
+/* The runnables of SCHED_Config.c */
+void HSWITCH_Runnable(void)
+{
+    SchedTest_Burn(SchedTest_Work);
+    if(SchedTest_EveryMs)
+    {
+        assert(Sched_SetNextDelay(SW_Runnable,1)==LBTY_OK);
+    }
+}
+
+void KPD_Runnable(void)
+{
+    SchedTest_Burn(SchedTest_Spike);
+    SchedTest_Spike=0;
+}
+
+void INPUT_Runnable(void)
+{
+}
+
+void APP1_RunnableFunc(void)
+{
+}
+
+void APP2_RunnableFunc(void)
+{
+}
+
+void TrafficLights(void)
+{
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* The load of a window is the share of the SysTick counts spent in Sched */
+static void Test_LoadWindow(void)
+{
+    SchedStats_tstr Local_Stats;
+    /* 10% at 84 MHz */
+    SchedTest_Init(SCHEDTEST_SW_PERIOD_MS*84000/10);
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS-1);
+    assert(SchedTest_Stats().LoadPermille==0);
+    SchedTest_Run(1);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.LoadPermille==100);
+    assert(Local_Stats.PeakLoadPermille==100);
+    assert(Local_Stats.MissedTicks==0);
+
+    /* A run over 2 ms leaves 2 ticks pending, it is counted once and the window is full */
+    SchedTest_Spike=(5*84000)/2;
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.MissedTicks==1);
+    assert(Local_Stats.PeakLoadPermille==Local_Stats.LoadPermille);
+    assert(Local_Stats.LoadPermille>100);
+
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.LoadPermille==100);
+    assert(Local_Stats.PeakLoadPermille>100);
+    assert(Sched_GetStats(NULL)==LBTY_ErrorNullPointer);
+}
+
+#if SCHED_GOVERNOR==SCHED_ENABLE
+/* A slower plan is taken after SCHED_GOV_DOWN_WINDOWS light windows, and not when its predicted load is too high */
+static void Test_GovernorDown(void)
+{
+    SchedStats_tstr Local_Stats;
+    /* 10% at 84 MHz, 20% at 42 MHz and 52.5% predicted at 16 MHz */
+    SchedTest_Init(SCHEDTEST_SW_PERIOD_MS*84000/10);
+    SchedTest_Run((SCHED_GOV_DOWN_WINDOWS-1)*SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().PlanIndex==SCHED_GOV_PLANS_NUM-1);
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.PlanIndex==SCHED_GOV_PLANS_NUM-2);
+    assert(Local_Stats.ClockSwitches==1);
+    assert(SchedTest_HclkHz==42*SCHEDTEST_MHZ);
+
+    SchedTest_Run(4*SCHED_GOV_DOWN_WINDOWS*SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.PlanIndex==SCHED_GOV_PLANS_NUM-2);
+    assert(Local_Stats.LoadPermille==200);
+    assert(Local_Stats.ClockSwitches==1);
+
+    /* 5% at 84 MHz goes down to the slowest plan, one step per SCHED_GOV_DOWN_WINDOWS windows */
+    SchedTest_Init(SCHEDTEST_SW_PERIOD_MS*84000/20);
+    SchedTest_Run(2*SCHED_GOV_DOWN_WINDOWS*SCHED_LOAD_WINDOW_MS-1);
+    assert(SchedTest_Stats().PlanIndex==1);
+    SchedTest_Run(1);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.PlanIndex==0);
+    assert(Local_Stats.ClockSwitches==2);
+    assert(SchedTest_HclkHz==16*SCHEDTEST_MHZ);
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().LoadPermille==262);
+}
+
+/* A heavy window goes to the fastest plan at once, a window that isn't light restarts the count down.
+ * SW_Runnable runs every tick so that a heavy load misses no tick, the work is per ms. */
+static void Test_GovernorUp(void)
+{
+    SchedStats_tstr Local_Stats;
+    SchedTest_Init(84000/20);
+    SchedTest_EveryMs=1;
+    SchedTest_Run(2*SCHED_GOV_DOWN_WINDOWS*SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().PlanIndex==0);
+
+    /* 80% at 16 MHz */
+    SchedTest_Work=16000*8/10;
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.LoadPermille==800);
+    assert(Local_Stats.MissedTicks==0);
+    assert(Local_Stats.PlanIndex==SCHED_GOV_PLANS_NUM-1);
+    assert(Local_Stats.ClockSwitches==3);
+
+    /* Light windows with a medium one in between, 30% at 84 MHz is 60% predicted at 42 MHz */
+    SchedTest_Work=84000/10;
+    SchedTest_Run((SCHED_GOV_DOWN_WINDOWS-1)*SCHED_LOAD_WINDOW_MS);
+    SchedTest_Work=84000*3/10;
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    SchedTest_Work=84000/10;
+    SchedTest_Run((SCHED_GOV_DOWN_WINDOWS-1)*SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().PlanIndex==SCHED_GOV_PLANS_NUM-1);
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().PlanIndex==SCHED_GOV_PLANS_NUM-2);
+
+    /* A missed tick goes to the fastest plan whatever the load */
+    SchedTest_Spike=2*42000;
+    SchedTest_Run(SCHED_LOAD_WINDOW_MS);
+    Local_Stats=SchedTest_Stats();
+    assert(Local_Stats.MissedTicks==1);
+    assert(Local_Stats.LoadPermille<SCHED_GOV_UP_PERMILLE);
+    assert(Local_Stats.PlanIndex==SCHED_GOV_PLANS_NUM-1);
+    assert(SchedTest_Plans==Local_Stats.ClockSwitches+1);
+}
+#else
+/* Without the governor the clock is never touched */
+static void Test_NoGovernor(void)
+{
+    SchedTest_Init(SCHEDTEST_SW_PERIOD_MS*84000/20);
+    SchedTest_Run(4*SCHED_GOV_DOWN_WINDOWS*SCHED_LOAD_WINDOW_MS);
+    assert(SchedTest_Stats().ClockSwitches==0);
+    assert(SchedTest_Stats().LoadPermille==50);
+    assert(SchedTest_Plans==0);
+}
+#endif
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_LoadWindow();
+#if SCHED_GOVERNOR==SCHED_ENABLE
+    Test_GovernorDown();
+    Test_GovernorUp();
+#else
+    Test_NoGovernor();
+#endif
+    printf("test_sched: OK\n");
+    return 0;
+}
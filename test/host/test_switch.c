@@ -0,0 +1,210 @@
+/********************************************************************************************************/
+/* File             :       test_switch.c                                                               */
+/* SWC              :       Host test harness                                                           */
+/* Brief            :       Vertical counter debouncer of HSWITCH on the RAM GPIO ports, built in both  */
+/*                          SWITCH_INPUT_MODE variants of the Makefile.                                 */
+/********************************************************************************************************/
+#include "STD_TYPES.h"
+#include "HSWITCH/SWITCH.h"
+#include "MGPIO/GPIO.h"
+#include "host_mcal.h"
+#include <assert.h>
+#include <stdio.h>
+
+/********************************************************************************************************/
+/************************************************Defines*************************************************/
+/********************************************************************************************************/
+#define SWITCHTEST_SAMPLES      4       // Samples at the new level before a lane toggles
+#define SWITCHTEST_PIN_1        (1U<<GPIO_PIN_1)
+#define SWITCHTEST_PIN_2        (1U<<GPIO_PIN_2)
+#define SWITCHTEST_PIN_3        (1U<<GPIO_PIN_3)
+
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
+extern void HSWITCH_Runnable(void);
+
+/********************************************************************************************************/
+/*****************************************Static Functions Implementation********************************/
+/********************************************************************************************************/
+static void SwitchTest_Run(u8 Copy_Samples)
+{
+    while(Copy_Samples--)
+    {
+        HSWITCH_Runnable();
+    }
+}
+
+static u8 SwitchTest_Pressed(u8 Copy_Switch)
+{
+    u8 Local_Status=0xFF;
+    assert(HSWITCH_GetSwitchStatus(Copy_Switch,&Local_Status)==LBTY_OK);
+    return Local_Status;
+}
+
+static void SwitchTest_AssertEdges(u32 Copy_Press, u32 Copy_Release)
+{
+    u32 Local_Press;
+    u32 Local_Release;
+    assert(HSWITCH_GetEdges(&Local_Press,&Local_Release)==LBTY_OK);
+    assert(Local_Press==Copy_Press);
+    assert(Local_Release==Copy_Release);
+}
+
+/* The pull-up switches are pressed when their pin is driven low */
+static void SwitchTest_Press(u16 Copy_PinMask)
+{
+    Host_DriveInputs(GPIOA,Copy_PinMask,0);
+}
+
+static void SwitchTest_Release(u16 Copy_PinMask)
+{
+    Host_ReleaseInputs(GPIOA,Copy_PinMask);
+}
+
+static void SwitchTest_Init(void)
+{
+    Host_Reset();
+    assert(HSWITCH_Init()==LBTY_OK);
+    SwitchTest_Run(2*SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(0,0);
+}
+
+/********************************************************************************************************/
+/*********************************************Tests******************************************************/
+/********************************************************************************************************/
+/* A lane toggles after 4 samples at the new level, one edge is reported and reading clears it */
+static void Test_Debounce(void)
+{
+    SwitchTest_Init();
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_NOT_PRESSED);
+
+    SwitchTest_Press(SWITCHTEST_PIN_1);
+    SwitchTest_Run(SWITCHTEST_SAMPLES-1);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_NOT_PRESSED);
+    SwitchTest_AssertEdges(0,0);
+    SwitchTest_Run(1);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_PRESSED);
+    SwitchTest_AssertEdges(1UL<<SWITCH_01,0);
+    SwitchTest_AssertEdges(0,0);
+
+    /* Held down, nothing new */
+    SwitchTest_Run(3*SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(0,0);
+
+    SwitchTest_Release(SWITCHTEST_PIN_1);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_NOT_PRESSED);
+    SwitchTest_AssertEdges(0,1UL<<SWITCH_01);
+}
+
+/* A bounce back to the old level clears the count of its lane only */
+static void Test_Bounce(void)
+{
+    SwitchTest_Init();
+    SwitchTest_Press(SWITCHTEST_PIN_1|SWITCHTEST_PIN_2);
+    SwitchTest_Run(SWITCHTEST_SAMPLES-1);
+    SwitchTest_Release(SWITCHTEST_PIN_1);
+    SwitchTest_Run(1);
+    SwitchTest_Press(SWITCHTEST_PIN_1);
+    SwitchTest_Run(SWITCHTEST_SAMPLES-1);
+    /* Switch 2 toggled on its 4th sample, switch 1 restarted and is one sample short */
+    assert(SwitchTest_Pressed(SWITCH_02)==SWITCH_PRESSED);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_NOT_PRESSED);
+    SwitchTest_AssertEdges(1UL<<SWITCH_02,0);
+    SwitchTest_Run(1);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_PRESSED);
+    SwitchTest_AssertEdges(1UL<<SWITCH_01,0);
+
+    /* Single sample glitches never get through */
+    SwitchTest_Release(SWITCHTEST_PIN_1|SWITCHTEST_PIN_2);
+    SwitchTest_Run(1);
+    SwitchTest_Press(SWITCHTEST_PIN_1|SWITCHTEST_PIN_2);
+    SwitchTest_Run(3*SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(0,0);
+}
+
+/* Lanes of the same port move together in one sample */
+static void Test_ParallelLanes(void)
+{
+    SwitchTest_Init();
+    SwitchTest_Press(SWITCHTEST_PIN_1|SWITCHTEST_PIN_2|SWITCHTEST_PIN_3);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges((1UL<<SWITCH_01)|(1UL<<SWITCH_02)|(1UL<<SWITCH_03),0);
+    SwitchTest_Release(SWITCHTEST_PIN_2);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(0,1UL<<SWITCH_02);
+    assert(SwitchTest_Pressed(SWITCH_04)==SWITCH_NOT_PRESSED);
+}
+
+static void Test_InvalidArguments(void)
+{
+    u8 Local_Status;
+    u32 Local_Mask;
+    SwitchTest_Init();
+    assert(HSWITCH_GetSwitchStatus(_NUM_SWITCH,&Local_Status)==LBTY_NOK);
+    assert(HSWITCH_GetSwitchStatus(SWITCH_05,&Local_Status)==LBTY_NOK); // No pin in SWITCH_Cfg.c
+    assert(HSWITCH_GetSwitchStatus(SWITCH_01,NULL)==LBTY_NOK);
+    assert(HSWITCH_GetEdges(NULL,&Local_Mask)==LBTY_NOK);
+    assert(HSWITCH_GetEdges(&Local_Mask,NULL)==LBTY_NOK);
+}
+
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+/* The runnable leaves the port alone until an EXTI edge, a level change with the line masked is not seen */
+static void Test_EXTIWakeUp(void)
+{
+    SwitchTest_Init();
+    assert(MGPIO_DisableEXTI(GPIO_PIN_1)==LBTY_OK);
+    SwitchTest_Press(SWITCHTEST_PIN_1);
+    SwitchTest_Run(3*SWITCHTEST_SAMPLES);
+    assert(SwitchTest_Pressed(SWITCH_01)==SWITCH_NOT_PRESSED);
+    SwitchTest_AssertEdges(0,0);
+
+    /* Any edge of the port wakes all its lanes */
+    SwitchTest_Press(SWITCHTEST_PIN_2);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges((1UL<<SWITCH_01)|(1UL<<SWITCH_02),0);
+    assert(MGPIO_EnableEXTI(GPIO_PIN_1)==LBTY_OK);
+    SwitchTest_Release(SWITCHTEST_PIN_1);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(0,1UL<<SWITCH_01);
+}
+
+static void SwitchTest_ForeignCallBack(u8 Copy_Line)
+{
+    (void)Copy_Line;
+}
+
+/* A line owned by the switches is refused to another port or callback, the switches keep it */
+static void Test_EXTIOwner(void)
+{
+    SwitchTest_Init();
+    assert(MGPIO_ConfigEXTI(GPIOB,GPIO_PIN_1,GPIO_EXTI_FALLING,SwitchTest_ForeignCallBack)==LBTY_Busy);
+    assert(MGPIO_ConfigEXTI(GPIOA,GPIO_PIN_1,GPIO_EXTI_FALLING,SwitchTest_ForeignCallBack)==LBTY_Busy);
+    assert(MGPIO_ConfigEXTI((void*)(GPIOA_BASE_ADD+8*0x400),GPIO_PIN_9,GPIO_EXTI_FALLING,SwitchTest_ForeignCallBack)==LBTY_ErrorInvalidInput);
+    SwitchTest_Press(SWITCHTEST_PIN_1);
+    SwitchTest_Run(SWITCHTEST_SAMPLES);
+    SwitchTest_AssertEdges(1UL<<SWITCH_01,0);
+
+    /* Another module on line 9 first, the switches can't take it back */
+    assert(MGPIO_ConfigEXTI(GPIOB,GPIO_PIN_9,GPIO_EXTI_FALLING,SwitchTest_ForeignCallBack)==LBTY_OK);
+    assert(MGPIO_ConfigEXTI(GPIOA,GPIO_PIN_9,GPIO_EXTI_BOTH,SwitchTest_ForeignCallBack)==LBTY_Busy);
+}
+#endif
+
+/********************************************************************************************************/
+/*********************************************Main*******************************************************/
+/********************************************************************************************************/
+int main(void)
+{
+    Test_Debounce();
+    Test_Bounce();
+    Test_ParallelLanes();
+    Test_InvalidArguments();
+#if SWITCH_INPUT_MODE==SWITCH_MODE_EXTI
+    Test_EXTIWakeUp();
+    Test_EXTIOwner();
+#endif
+    printf("test_switch: OK\n");
+    return 0;
+}